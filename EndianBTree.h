@@ -0,0 +1,812 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_BTREE_HEADER_FILE
+#define MZ_ENDIAN_BTREE_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianBTree.h
+ * @brief Disk-resident B+tree with fixed-endian 4 KiB pages
+ *
+ * This header defines three classes around one on-disk format:
+ * - BasicBTreeBuilder: Bulk loads a tree from sorted keys through a BasicFileWriter
+ * - BasicBTreeView: Searches a tree held in memory (typically an mmapped file)
+ * - BasicBTreeFile: Searches a tree in a file, reading one page at a time
+ *
+ * Keys are ByteArray<N> compared with memcmp, so any memcomparable encoding
+ * (big-endian integers, padded strings) can be stored in them. Every page
+ * keeps the first four key bytes of each entry as a separate array of
+ * "heads"; a page search narrows the range on the heads, counts the last few
+ * with SSE2 compares, and only then compares whole keys.
+ *
+ * File layout (all integers in Encoding, pages of btree_page_size bytes):
+ *   [leaf pages, in key order][inner pages, level by level][meta page]
+ *
+ * Page layout:
+ *   [uint8_t kind][uint8_t 0][uint16_t count][uint32_t 0][uint64_t next leaf]
+ *   [capacity x uint32_t heads][capacity x key][capacity x value or uint64_t child]
+ *
+ * Meta page:
+ *   [uint32_t magic][uint32_t page size][uint32_t N][uint32_t sizeof(V)]
+ *   [uint64_t count][uint64_t root][uint64_t height][uint64_t leaves][uint64_t pages]
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <string>
+#include <span>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define MZ_ENDIAN_BTREE_SSE2 1
+#endif
+
+#include "EndianBasicBuffers.h"
+#include "EndianByteArray.h"
+#include "EndianBitOps.h"
+#include "EndianFileStream.h"
+
+namespace mz {
+    namespace endian {
+
+        /// Magic number in the meta page of a B+tree file ("MZBT")
+        static constexpr uint32_t btree_magic{ 0x54425A4DU };
+
+        /// Size of every B+tree page in bytes
+        static constexpr size_t btree_page_size{ 4096 };
+
+        /**
+         * @brief Kinds of B+tree pages
+         */
+        enum class BTreePage : uint8_t {
+            none,        ///< Unused page
+            leaf = 1,    ///< Keys and values
+            inner = 2,   ///< Keys and child page numbers
+            invalid      ///< Not a valid page kind
+        };
+
+        namespace detail {
+
+            static constexpr size_t btree_header_size{ 16 };
+            static constexpr uint64_t btree_no_page{ ~uint64_t{ 0 } };
+
+            /**
+             * @brief Page geometry and page-level search for one key/value shape
+             */
+            template <std::endian Encoding, size_t N, SwapType V>
+            struct BTreeLayout {
+                static constexpr size_t leaf_capacity{ (btree_page_size - btree_header_size) / (4 + N + sizeof(V)) };
+                static constexpr size_t inner_capacity{ (btree_page_size - btree_header_size) / (4 + N + 8) };
+                static_assert(leaf_capacity >= 2 && inner_capacity >= 2, "B+tree keys are too large for a page");
+
+                [[nodiscard]] static constexpr size_t capacity(BTreePage kind) noexcept {
+                    return kind == BTreePage::leaf ? leaf_capacity : inner_capacity;
+                }
+
+                [[nodiscard]] static constexpr size_t keysOffset(BTreePage kind) noexcept {
+                    return btree_header_size + 4 * capacity(kind);
+                }
+
+                [[nodiscard]] static constexpr size_t payloadOffset(BTreePage kind) noexcept {
+                    return keysOffset(kind) + N * capacity(kind);
+                }
+
+                /**
+                 * @brief First four key bytes as a big-endian number, so heads sort like keys
+                 */
+                [[nodiscard]] static uint32_t headOf(const uint8_t* key) noexcept {
+                    uint32_t head = 0;
+                    for (size_t i = 0; i < 4; ++i) {
+                        head = (head << 8) | (i < N ? key[i] : 0);
+                    }
+                    return head;
+                }
+
+                [[nodiscard]] static BTreePage kindOf(const uint8_t* page) noexcept {
+                    return page[0] == static_cast<uint8_t>(BTreePage::leaf) ? BTreePage::leaf
+                        : page[0] == static_cast<uint8_t>(BTreePage::inner) ? BTreePage::inner : BTreePage::invalid;
+                }
+
+                [[nodiscard]] static size_t countOf(const uint8_t* page) noexcept {
+                    uint16_t count = 0;
+                    basicCopy<Encoding>(count, page + 2);
+                    return count;
+                }
+
+                [[nodiscard]] static uint64_t nextOf(const uint8_t* page) noexcept {
+                    uint64_t next = 0;
+                    basicCopy<Encoding>(next, page + 8);
+                    return next;
+                }
+
+                [[nodiscard]] static uint32_t headAt(const uint8_t* page, size_t index) noexcept {
+                    uint32_t head = 0;
+                    basicCopy<Encoding>(head, page + btree_header_size + 4 * index);
+                    return head;
+                }
+
+                [[nodiscard]] static const uint8_t* keyAt(const uint8_t* page, BTreePage kind, size_t index) noexcept {
+                    return page + keysOffset(kind) + N * index;
+                }
+
+                [[nodiscard]] static V valueAt(const uint8_t* page, size_t index) noexcept {
+                    V value{};
+                    basicCopy<Encoding>(value, page + payloadOffset(BTreePage::leaf) + sizeof(V) * index);
+                    return value;
+                }
+
+                [[nodiscard]] static uint64_t childAt(const uint8_t* page, size_t index) noexcept {
+                    uint64_t child = 0;
+                    basicCopy<Encoding>(child, page + payloadOffset(BTreePage::inner) + 8 * index);
+                    return child;
+                }
+
+                /**
+                 * @brief Counts heads in [low, high) below a threshold (up to 2^32)
+                 */
+                [[nodiscard]] static size_t countHeadsBelow(const uint8_t* page, size_t low, size_t high, uint64_t threshold) noexcept {
+                    if (threshold > UINT32_MAX) {
+                        return high;
+                    }
+                    while (high - low > 16) {
+                        const size_t middle = low + (high - low) / 2;
+                        if (headAt(page, middle) < threshold) low = middle + 1;
+                        else high = middle;
+                    }
+#if defined(MZ_ENDIAN_BTREE_SSE2)
+                    if constexpr (Encoding == std::endian::native) {
+                        // Unsigned compare through the sign-flip trick, four heads per step
+                        const __m128i flip = _mm_set1_epi32(static_cast<int>(0x80000000U));
+                        const __m128i limit = _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(threshold) ^ 0x80000000U));
+                        const uint8_t* heads = page + btree_header_size;
+                        size_t below = low;
+                        for (; low + 4 <= high; low += 4) {
+                            const __m128i lane = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(heads + 4 * low)), flip);
+                            below += static_cast<size_t>(std::popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(lane, limit))))));
+                        }
+                        for (; low < high; ++low) {
+                            below += headAt(page, low) < threshold;
+                        }
+                        return below;
+                    }
+#endif
+                    while (low < high && headAt(page, low) < threshold) {
+                        ++low;
+                    }
+                    return low;
+                }
+
+                /**
+                 * @brief Counts keys below (or, with OrEqual, not above) a key
+                 */
+                template <bool OrEqual>
+                [[nodiscard]] static size_t rankOf(const uint8_t* page, BTreePage kind, size_t count, const uint8_t* key) noexcept {
+                    const uint32_t head = headOf(key);
+                    size_t low = countHeadsBelow(page, 0, count, head);
+                    size_t high = countHeadsBelow(page, low, count, uint64_t{ head } + 1);
+                    while (low < high) {
+                        const size_t middle = low + (high - low) / 2;
+                        const int order = std::memcmp(keyAt(page, kind, middle), key, N);
+                        if (OrEqual ? order <= 0 : order < 0) low = middle + 1;
+                        else high = middle;
+                    }
+                    return low;
+                }
+
+                /**
+                 * @brief Walks from the root to the leaf that may hold a key
+                 * @param load Callable mapping a page number to its bytes, or nullptr
+                 * @return Leaf page bytes, or nullptr if a page was unreadable or malformed
+                 */
+                template <typename Load>
+                [[nodiscard]] static const uint8_t* descend(Load&& load, uint64_t root, uint64_t height, const uint8_t* key) noexcept {
+                    uint64_t pageNumber = root;
+                    for (uint64_t level = height; level > 1; --level) {
+                        const uint8_t* page = load(pageNumber);
+                        if (!page || kindOf(page) != BTreePage::inner || countOf(page) == 0 || countOf(page) > inner_capacity) {
+                            return nullptr;
+                        }
+                        const size_t slot = rankOf<true>(page, BTreePage::inner, countOf(page), key);
+                        pageNumber = childAt(page, slot ? slot - 1 : 0);
+                    }
+                    const uint8_t* leaf = load(pageNumber);
+                    if (!leaf || kindOf(leaf) != BTreePage::leaf || countOf(leaf) > leaf_capacity) {
+                        return nullptr;
+                    }
+                    return leaf;
+                }
+            };
+
+            /**
+             * @brief Validated contents of a meta page
+             */
+            struct BTreeMeta {
+                uint64_t count{ 0 };
+                uint64_t root{ btree_no_page };
+                uint64_t height{ 0 };
+                uint64_t leaves{ 0 };
+                uint64_t pages{ 0 };
+            };
+
+            /**
+             * @brief Reads and validates a meta page
+             * @return true if the page does not describe a tree of this shape
+             */
+            template <std::endian Encoding, size_t N, SwapType V>
+            [[nodiscard]] bool readBTreeMeta(const uint8_t* page, uint64_t pagesAvailable, BTreeMeta& meta) noexcept {
+                uint32_t magic = 0;
+                uint32_t pageSize = 0;
+                uint32_t keySize = 0;
+                uint32_t valueSize = 0;
+                basicCopy<Encoding>(magic, page);
+                basicCopy<Encoding>(pageSize, page + 4);
+                basicCopy<Encoding>(keySize, page + 8);
+                basicCopy<Encoding>(valueSize, page + 12);
+                basicCopy<Encoding>(meta.count, page + 16);
+                basicCopy<Encoding>(meta.root, page + 24);
+                basicCopy<Encoding>(meta.height, page + 32);
+                basicCopy<Encoding>(meta.leaves, page + 40);
+                basicCopy<Encoding>(meta.pages, page + 48);
+                if (magic != btree_magic || pageSize != btree_page_size || keySize != N || valueSize != sizeof(V)) {
+                    return true; // Error (different format or shape)
+                }
+                if (meta.pages != pagesAvailable || meta.leaves >= meta.pages || meta.height > 64
+                    || (meta.count == 0) != (meta.root == btree_no_page) || (meta.root != btree_no_page && meta.root >= meta.pages - 1)) {
+                    return true; // Error (inconsistent meta page)
+                }
+                return false; // Success (no error)
+            }
+
+        } // namespace detail
+
+        /**
+         * @class BasicBTreeBuilder
+         * @brief Bulk loads a B+tree from strictly increasing keys
+         *
+         * Leaves are filled completely and handed to the file writer as soon as
+         * the next leaf starts, so loading runs at sequential write speed. Only
+         * the first key of every leaf is kept in memory; the inner levels are
+         * built from those keys by finish(). The tree must be the whole output of
+         * the writer, starting at position 0.
+         *
+         * @tparam Encoding Endianness of the page integers
+         * @tparam N Key size in bytes
+         * @tparam V Value type
+         */
+        template <std::endian Encoding, size_t N, SwapType V>
+        class BasicBTreeBuilder {
+            using Layout = detail::BTreeLayout<Encoding, N, V>;
+
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs a builder writing to an open file writer
+              * @param writer Writer positioned at the start of its file; must outlive the builder
+              */
+            explicit BasicBTreeBuilder(BasicFileWriter<Encoding>& writer) noexcept
+                : m_writer{ writer } {
+                startPage(BTreePage::leaf);
+            }
+
+            BasicBTreeBuilder(const BasicBTreeBuilder&) = delete;
+            BasicBTreeBuilder& operator=(const BasicBTreeBuilder&) = delete;
+            /** @} */
+
+            /**
+             * @name Building
+             * @{
+             */
+
+             /**
+              * @brief Appends one entry
+              * @param key Key, strictly greater than the previous key
+              * @param value Value
+              * @return true if the key is out of order, the tree is finished, or a write failed
+              */
+            [[nodiscard]] bool add(const ByteArray<N>& key, const V& value) noexcept {
+                if (m_finished || (m_count > 0 && !(m_lastKey < key))) {
+                    return true; // Error (finished or key out of order)
+                }
+                if (m_pageCount == Layout::leaf_capacity) {
+                    writePage(BTreePage::leaf, m_pages + 1);
+                    startPage(BTreePage::leaf);
+                }
+                if (m_pageCount == 0) {
+                    m_firstKeys.push_back(key);
+                }
+                setEntry(BTreePage::leaf, m_pageCount, key.data());
+                basicCopy<Encoding>(m_page.data() + Layout::payloadOffset(BTreePage::leaf) + sizeof(V) * m_pageCount, value);
+                ++m_pageCount;
+                ++m_count;
+                m_lastKey = key;
+                return m_writer.error();
+            }
+
+            /**
+             * @brief Writes the last leaf, the inner levels and the meta page
+             * @return true if the tree was already finished or a write failed
+             */
+            [[nodiscard]] bool finish() noexcept {
+                if (m_finished) {
+                    return true; // Error (already finished)
+                }
+                m_finished = true;
+                uint64_t root = detail::btree_no_page;
+                uint64_t height = 0;
+                const uint64_t leaves = m_firstKeys.size();
+                if (m_pageCount > 0) {
+                    writePage(BTreePage::leaf, detail::btree_no_page);
+                    root = 0;
+                    height = 1;
+                }
+
+                // Build each level from the first keys of the one below, spreading entries evenly
+                std::vector<uint64_t> children(leaves);
+                for (uint64_t i = 0; i < leaves; ++i) {
+                    children[i] = i;
+                }
+                while (children.size() > 1) {
+                    const size_t pageCount = (children.size() + Layout::inner_capacity - 1) / Layout::inner_capacity;
+                    std::vector<ByteArray<N>> levelKeys;
+                    std::vector<uint64_t> levelChildren;
+                    levelKeys.reserve(pageCount);
+                    levelChildren.reserve(pageCount);
+                    size_t begin = 0;
+                    for (size_t p = 0; p < pageCount; ++p) {
+                        const size_t end = children.size() * (p + 1) / pageCount;
+                        startPage(BTreePage::inner);
+                        for (size_t i = begin; i < end; ++i) {
+                            setEntry(BTreePage::inner, m_pageCount, m_firstKeys[i].data());
+                            basicCopy<Encoding>(m_page.data() + Layout::payloadOffset(BTreePage::inner) + 8 * m_pageCount, children[i]);
+                            ++m_pageCount;
+                        }
+                        levelKeys.push_back(m_firstKeys[begin]);
+                        levelChildren.push_back(m_pages);
+                        writePage(BTreePage::inner, detail::btree_no_page);
+                        begin = end;
+                    }
+                    m_firstKeys.swap(levelKeys);
+                    children.swap(levelChildren);
+                    root = children.front();
+                    ++height;
+                }
+
+                m_page.fill(0);
+                basicCopy<Encoding>(m_page.data(), btree_magic);
+                basicCopy<Encoding>(m_page.data() + 4, static_cast<uint32_t>(btree_page_size));
+                basicCopy<Encoding>(m_page.data() + 8, static_cast<uint32_t>(N));
+                basicCopy<Encoding>(m_page.data() + 12, static_cast<uint32_t>(sizeof(V)));
+                basicCopy<Encoding>(m_page.data() + 16, m_count);
+                basicCopy<Encoding>(m_page.data() + 24, root);
+                basicCopy<Encoding>(m_page.data() + 32, height);
+                basicCopy<Encoding>(m_page.data() + 40, leaves);
+                basicCopy<Encoding>(m_page.data() + 48, m_pages + 1);
+                m_writer.write(m_page);
+                ++m_pages;
+                return m_writer.flush();
+            }
+
+            /**
+             * @brief Gets the number of entries added so far
+             * @return Entry count
+             */
+            [[nodiscard]] uint64_t size() const noexcept { return m_count; }
+            /** @} */
+
+        private:
+            BasicFileWriter<Encoding>& m_writer;            ///< Destination
+            std::array<uint8_t, btree_page_size> m_page{};  ///< Page being filled
+            std::vector<ByteArray<N>> m_firstKeys;          ///< First key of every written page of the current level
+            ByteArray<N> m_lastKey;                         ///< Last key added
+            uint64_t m_count{ 0 };                          ///< Entries added
+            uint64_t m_pages{ 0 };                          ///< Pages written
+            size_t m_pageCount{ 0 };                        ///< Entries in m_page
+            bool m_finished{ false };                       ///< finish() was called
+
+            void startPage(BTreePage kind) noexcept {
+                m_page.fill(0);
+                m_page[0] = static_cast<uint8_t>(kind);
+                m_pageCount = 0;
+            }
+
+            void setEntry(BTreePage kind, size_t index, const uint8_t* key) noexcept {
+                basicCopy<Encoding>(m_page.data() + detail::btree_header_size + 4 * index, Layout::headOf(key));
+                std::memcpy(m_page.data() + Layout::keysOffset(kind) + N * index, key, N);
+            }
+
+            void writePage(BTreePage kind, uint64_t next) noexcept {
+                m_page[0] = static_cast<uint8_t>(kind);
+                basicCopy<Encoding>(m_page.data() + 2, static_cast<uint16_t>(m_pageCount));
+                basicCopy<Encoding>(m_page.data() + 8, next);
+                m_writer.write(m_page);
+                ++m_pages;
+            }
+        };
+
+        /**
+         * @class BasicBTreeView
+         * @brief Read-only B+tree over bytes in memory, typically an mmapped file
+         *
+         * The view only stores a pointer into the buffer it was opened on; the
+         * buffer must outlive it. Pages are validated as they are visited, so a
+         * corrupt file produces errors rather than out-of-bounds reads.
+         *
+         * @tparam Encoding Endianness of the page integers
+         * @tparam N Key size in bytes
+         * @tparam V Value type
+         */
+        template <std::endian Encoding, size_t N, SwapType V>
+        class BasicBTreeView {
+            using Layout = detail::BTreeLayout<Encoding, N, V>;
+
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an empty view
+              */
+            explicit BasicBTreeView() noexcept = default;
+            /** @} */
+
+            /**
+             * @name Opening
+             * @{
+             */
+
+             /**
+              * @brief Attaches the view to a whole B+tree file
+              * @param buffer Read buffer holding exactly the file; consumed on success
+              * @return true if the size or meta page is invalid, false on success
+              */
+            [[nodiscard]] bool open(BasicReadBuffer<Encoding>& buffer) noexcept {
+                if (buffer.size() == 0 || buffer.size() % btree_page_size != 0) {
+                    return true; // Error (not a whole number of pages)
+                }
+                const uint64_t pages = buffer.size() / btree_page_size;
+                if (detail::readBTreeMeta<Encoding, N, V>(buffer.data() + (pages - 1) * btree_page_size, pages, m_meta)) {
+                    return true; // Error (bad meta page)
+                }
+                m_pages = buffer.data();
+                buffer.skipFront(buffer.size());
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Queries
+             * @{
+             */
+
+             /**
+              * @brief Gets the number of entries
+              * @return Entry count
+              */
+            [[nodiscard]] uint64_t size() const noexcept { return m_meta.count; }
+
+            /**
+             * @brief Looks up a key
+             * @param key Key to find
+             * @param value Receives the value when found
+             * @return true if the key is absent or a page is malformed, false if found
+             */
+            [[nodiscard]] bool find(const ByteArray<N>& key, V& value) const noexcept {
+                if (m_meta.count == 0) {
+                    return true; // Error (empty tree)
+                }
+                const uint8_t* leaf = Layout::descend([this](uint64_t page) { return pageAt(page); }, m_meta.root, m_meta.height, key.data());
+                if (!leaf) {
+                    return true; // Error (malformed page)
+                }
+                const size_t count = Layout::countOf(leaf);
+                const size_t slot = Layout::template rankOf<false>(leaf, BTreePage::leaf, count, key.data());
+                if (slot == count || std::memcmp(Layout::keyAt(leaf, BTreePage::leaf, slot), key.data(), N) != 0) {
+                    return true; // Error (key not found)
+                }
+                value = Layout::valueAt(leaf, slot);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Visits entries with keys in [low, high) in key order
+             * @tparam Visitor Callable as bool(const ByteArray<N>&, const V&); return false to stop
+             * @param low Inclusive lower bound
+             * @param high Exclusive upper bound
+             * @param visitor Callback
+             * @return true if a page is malformed, false on success
+             */
+            template <typename Visitor>
+            [[nodiscard]] bool forEachInRange(const ByteArray<N>& low, const ByteArray<N>& high, Visitor&& visitor) const noexcept {
+                if (m_meta.count == 0 || !(low < high)) {
+                    return false; // Success (nothing to visit)
+                }
+                const uint8_t* leaf = Layout::descend([this](uint64_t page) { return pageAt(page); }, m_meta.root, m_meta.height, low.data());
+                if (!leaf) {
+                    return true; // Error (malformed page)
+                }
+                size_t slot = Layout::template rankOf<false>(leaf, BTreePage::leaf, Layout::countOf(leaf), low.data());
+                ByteArray<N> key;
+                while (true) {
+                    // Start fetching the sibling while this leaf is being visited
+                    const uint64_t next = Layout::nextOf(leaf);
+                    const uint8_t* nextLeaf = pageAt(next);
+                    if (nextLeaf) {
+                        prefetchRead(nextLeaf);
+                        prefetchRead(nextLeaf + 64);
+                    }
+                    const size_t count = Layout::countOf(leaf);
+                    for (; slot < count; ++slot) {
+                        const uint8_t* stored = Layout::keyAt(leaf, BTreePage::leaf, slot);
+                        if (std::memcmp(stored, high.data(), N) >= 0) {
+                            return false; // Success (reached the upper bound)
+                        }
+                        std::memcpy(key.data(), stored, N);
+                        if (!visitor(static_cast<const ByteArray<N>&>(key), Layout::valueAt(leaf, slot))) {
+                            return false; // Success (stopped by the visitor)
+                        }
+                    }
+                    if (next == detail::btree_no_page) {
+                        return false; // Success (last leaf)
+                    }
+                    if (!nextLeaf || next >= m_meta.leaves || Layout::kindOf(nextLeaf) != BTreePage::leaf || Layout::countOf(nextLeaf) > Layout::leaf_capacity) {
+                        return true; // Error (malformed sibling link)
+                    }
+                    leaf = nextLeaf;
+                    slot = 0;
+                }
+            }
+            /** @} */
+
+        private:
+            const uint8_t* m_pages{ nullptr };  ///< First page
+            detail::BTreeMeta m_meta;           ///< Validated meta page
+
+            [[nodiscard]] const uint8_t* pageAt(uint64_t page) const noexcept {
+                return page < m_meta.pages - 1 ? m_pages + page * btree_page_size : nullptr;
+            }
+        };
+
+        /**
+         * @class BasicBTreeFile
+         * @brief Read-only B+tree read page by page from a file
+         *
+         * For trees that are not mapped into memory. Each visited page is read
+         * with one positioned read; during range scans the kernel is asked (on
+         * Linux) to read the next sibling ahead while the current leaf is visited.
+         *
+         * @tparam Encoding Endianness of the page integers
+         * @tparam N Key size in bytes
+         * @tparam V Value type
+         */
+        template <std::endian Encoding, size_t N, SwapType V>
+        class BasicBTreeFile {
+            using Layout = detail::BTreeLayout<Encoding, N, V>;
+
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs a closed reader
+              */
+            explicit BasicBTreeFile() noexcept = default;
+
+            BasicBTreeFile(const BasicBTreeFile&) = delete;
+            BasicBTreeFile& operator=(const BasicBTreeFile&) = delete;
+
+            /**
+             * @brief Destructor; closes the file
+             */
+            ~BasicBTreeFile() noexcept {
+                close();
+            }
+            /** @} */
+
+            /**
+             * @name File Operations
+             * @{
+             */
+
+             /**
+              * @brief Opens a B+tree file and reads its meta page
+              * @param path Path of the file
+              * @return true if the file cannot be read or is not a matching tree, false on success
+              */
+            [[nodiscard]] bool open(const std::string& path) noexcept {
+                close();
+                m_file = std::fopen(path.c_str(), "rb");
+                uint64_t size = 0;
+                if (!m_file || fileSize(m_file, size) || size == 0 || size % btree_page_size != 0) {
+                    close();
+                    return true; // Error (unreadable or not a whole number of pages)
+                }
+                const uint64_t pages = size / btree_page_size;
+                m_meta.pages = pages;
+                if (readPage(pages - 1, m_page) || detail::readBTreeMeta<Encoding, N, V>(m_page.data(), pages, m_meta)) {
+                    close();
+                    return true; // Error (bad meta page)
+                }
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Closes the file
+             */
+            void close() noexcept {
+                if (m_file) {
+                    std::fclose(m_file);
+                    m_file = nullptr;
+                }
+                m_meta = detail::BTreeMeta{};
+            }
+            /** @} */
+
+            /**
+             * @name Queries
+             * @{
+             */
+
+             /**
+              * @brief Gets the number of entries
+              * @return Entry count
+              */
+            [[nodiscard]] uint64_t size() const noexcept { return m_meta.count; }
+
+            /**
+             * @brief Looks up a key
+             * @param key Key to find
+             * @param value Receives the value when found
+             * @return true if the key is absent or a page cannot be read, false if found
+             */
+            [[nodiscard]] bool find(const ByteArray<N>& key, V& value) noexcept {
+                if (m_meta.count == 0) {
+                    return true; // Error (empty or closed tree)
+                }
+                const uint8_t* leaf = Layout::descend([this](uint64_t page) { return loadPage(page); }, m_meta.root, m_meta.height, key.data());
+                if (!leaf) {
+                    return true; // Error (unreadable or malformed page)
+                }
+                const size_t count = Layout::countOf(leaf);
+                const size_t slot = Layout::template rankOf<false>(leaf, BTreePage::leaf, count, key.data());
+                if (slot == count || std::memcmp(Layout::keyAt(leaf, BTreePage::leaf, slot), key.data(), N) != 0) {
+                    return true; // Error (key not found)
+                }
+                value = Layout::valueAt(leaf, slot);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Visits entries with keys in [low, high) in key order
+             * @tparam Visitor Callable as bool(const ByteArray<N>&, const V&); return false to stop
+             * @param low Inclusive lower bound
+             * @param high Exclusive upper bound
+             * @param visitor Callback
+             * @return true if a page cannot be read or is malformed, false on success
+             */
+            template <typename Visitor>
+            [[nodiscard]] bool forEachInRange(const ByteArray<N>& low, const ByteArray<N>& high, Visitor&& visitor) noexcept {
+                if (m_meta.count == 0 || !(low < high)) {
+                    return false; // Success (nothing to visit)
+                }
+                const uint8_t* leaf = Layout::descend([this](uint64_t page) { return loadPage(page); }, m_meta.root, m_meta.height, low.data());
+                if (!leaf) {
+                    return true; // Error (unreadable or malformed page)
+                }
+                size_t slot = Layout::template rankOf<false>(leaf, BTreePage::leaf, Layout::countOf(leaf), low.data());
+                ByteArray<N> key;
+                while (true) {
+                    const uint64_t next = Layout::nextOf(leaf);
+                    if (next < m_meta.leaves) {
+                        adviseWillNeed(next);
+                    }
+                    const size_t count = Layout::countOf(leaf);
+                    for (; slot < count; ++slot) {
+                        const uint8_t* stored = Layout::keyAt(leaf, BTreePage::leaf, slot);
+                        if (std::memcmp(stored, high.data(), N) >= 0) {
+                            return false; // Success (reached the upper bound)
+                        }
+                        std::memcpy(key.data(), stored, N);
+                        if (!visitor(static_cast<const ByteArray<N>&>(key), Layout::valueAt(leaf, slot))) {
+                            return false; // Success (stopped by the visitor)
+                        }
+                    }
+                    if (next == detail::btree_no_page) {
+                        return false; // Success (last leaf)
+                    }
+                    leaf = next < m_meta.leaves ? loadPage(next) : nullptr;
+                    if (!leaf || Layout::kindOf(leaf) != BTreePage::leaf || Layout::countOf(leaf) > Layout::leaf_capacity) {
+                        return true; // Error (unreadable page or malformed sibling link)
+                    }
+                    slot = 0;
+                }
+            }
+            /** @} */
+
+        private:
+            std::FILE* m_file{ nullptr };                   ///< Open file, or nullptr
+            std::array<uint8_t, btree_page_size> m_page{};  ///< Most recently read page
+            detail::BTreeMeta m_meta;                       ///< Validated meta page
+
+            [[nodiscard]] bool readPage(uint64_t page, std::array<uint8_t, btree_page_size>& bytes) noexcept {
+                return fileSeek(m_file, page * btree_page_size)
+                    || std::fread(bytes.data(), 1, bytes.size(), m_file) != bytes.size();
+            }
+
+            [[nodiscard]] const uint8_t* loadPage(uint64_t page) noexcept {
+                if (!m_file || page >= m_meta.pages - 1 || readPage(page, m_page)) {
+                    return nullptr;
+                }
+                return m_page.data();
+            }
+
+            void adviseWillNeed(uint64_t page) noexcept {
+#if defined(__linux__)
+                (void)posix_fadvise(fileno(m_file), static_cast<off_t>(page * btree_page_size), btree_page_size, POSIX_FADV_WILLNEED);
+#else
+                (void)page;
+#endif
+            }
+        };
+
+        /**
+         * @brief B+tree builder that uses the default stream endianness
+         */
+        template <size_t N, SwapType V>
+        using BTreeBuilder = BasicBTreeBuilder<stream_endian, N, V>;
+
+        /**
+         * @brief B+tree view that uses the default stream endianness
+         */
+        template <size_t N, SwapType V>
+        using BTreeView = BasicBTreeView<stream_endian, N, V>;
+
+        /**
+         * @brief Page-at-a-time B+tree reader that uses the default stream endianness
+         */
+        template <size_t N, SwapType V>
+        using BTreeFile = BasicBTreeFile<stream_endian, N, V>;
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_BTREE_SSE2
+
+#endif // MZ_ENDIAN_BTREE_HEADER_FILE
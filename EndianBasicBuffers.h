@@ -46,12 +46,18 @@ SOFTWARE.
 #include <type_traits>
 #include <string>
 #include <concepts>
+#include <bitset>
+#include <vector>
+#include <algorithm>
 #include <span>
 #include <bit>
 
 
 #include "EndianConversions.h"
 #include "EndianConcepts.h"
+#include "EndianOddWidth.h"
+#include "EndianSpanConvert.h"
+#include "EndianBoolPack.h"
 
 namespace mz {
     namespace endian {
@@ -416,6 +422,171 @@ namespace mz {
             }
             /** @} */
 
+            /**
+             * @name Odd-Width Write Operations
+             * @brief Operations that store integers in a given number of bytes (1 to 8)
+             * @{
+             */
+
+             /**
+              * @brief Writes the low Bytes bytes of a value without checking boundaries
+              * @tparam Bytes Number of bytes to write
+              * @tparam T Integer type of the value
+              * @param value Value to write; higher bytes are dropped
+              */
+            template <size_t Bytes, typename T>
+                requires OddWidthType<T, Bytes>
+            void unsafePushBackN(T value) noexcept {
+                basicCopyN<Encoding, Bytes>(m_begin, value);
+                m_begin += Bytes;
+            }
+
+            /**
+             * @brief Writes Bytes bytes per value of a span without checking boundaries
+             * @tparam Bytes Number of bytes to write per value
+             * @tparam T Integer type of the values
+             * @tparam N Size of the span
+             * @param span Span of values to write; higher bytes are dropped
+             */
+            template <size_t Bytes, typename T, size_t N>
+                requires OddWidthType<T, Bytes>
+            void unsafePushBackN(const std::span<T, N>& span) noexcept {
+                basicCopyN<Encoding, Bytes>(m_begin, span);
+                m_begin += Bytes * span.size();
+            }
+
+            /**
+             * @brief Safely writes the low Bytes bytes of a value
+             * @tparam Bytes Number of bytes to write
+             * @tparam T Integer type of the value
+             * @param value Value to write; higher bytes are dropped
+             * @return true if the operation failed (not enough space), false on success
+             */
+            template <size_t Bytes, typename T>
+                requires OddWidthType<T, Bytes>
+            [[nodiscard]] bool pushBackN(T value) noexcept {
+                if (m_begin + Bytes <= m_end) {
+                    unsafePushBackN<Bytes>(value);
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer full)
+            }
+
+            /**
+             * @brief Safely writes Bytes bytes per value of a span
+             * @tparam Bytes Number of bytes to write per value
+             * @tparam T Integer type of the values
+             * @tparam N Size of the span
+             * @param span Span of values to write; higher bytes are dropped
+             * @return true if the operation failed (not enough space), false on success
+             */
+            template <size_t Bytes, typename T, size_t N>
+                requires OddWidthType<T, Bytes>
+            [[nodiscard]] bool pushBackN(const std::span<T, N>& span) noexcept {
+                if (m_begin + Bytes * span.size() <= m_end) {
+                    unsafePushBackN<Bytes>(span);
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer full)
+            }
+            /** @} */
+
+            /**
+             * @name Converting Write Operations
+             * @brief Operations that store values as a different integer wire type
+             * @{
+             */
+
+             /**
+              * @brief Writes a span of values as Wire integers without checking boundaries
+              * @tparam Wire Integer type written to the buffer
+              * @tparam T Type of the values (integer or floating point)
+              * @tparam N Size of the span
+              * @param span Span of values; out-of-range values saturate, floats round to nearest
+              */
+            template <WireIntType Wire, NativeNumberType T, size_t N>
+            void unsafePushBackAs(const std::span<T, N>& span) noexcept {
+                basicCopyAs<Encoding, Wire>(m_begin, span);
+                m_begin += sizeof(Wire) * span.size();
+            }
+
+            /**
+             * @brief Safely writes a span of values as Wire integers
+             * @tparam Wire Integer type written to the buffer
+             * @tparam T Type of the values (integer or floating point)
+             * @tparam N Size of the span
+             * @param span Span of values; out-of-range values saturate, floats round to nearest
+             * @return true if the operation failed (not enough space), false on success
+             */
+            template <WireIntType Wire, NativeNumberType T, size_t N>
+            [[nodiscard]] bool pushBackAs(const std::span<T, N>& span) noexcept {
+                if (m_begin + sizeof(Wire) * span.size() <= m_end) {
+                    unsafePushBackAs<Wire>(span);
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer full)
+            }
+            /** @} */
+
+            /**
+             * @name Packed Boolean Write Operations
+             * @brief Operations that store flags eight to a byte
+             * @{
+             */
+
+             /**
+              * @brief Safely writes flags packed eight to a byte, without a count
+              * @param flags Flags to write; takes packedBoolSize(flags.size()) bytes
+              * @return true if the operation failed (not enough space), false on success
+              */
+            [[nodiscard]] bool pushBackBits(std::span<const bool> flags) noexcept {
+                const size_t byteSize = packedBoolSize(flags.size());
+                if (m_begin + byteSize <= m_end) {
+                    packBools(m_begin, flags);
+                    m_begin += byteSize;
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer full)
+            }
+
+            /**
+             * @brief Safely writes a bitset packed eight flags to a byte
+             * @tparam N Number of flags
+             * @param flags Flags to write; takes packedBoolSize(N) bytes
+             * @return true if the operation failed (not enough space), false on success
+             */
+            template <size_t N>
+            [[nodiscard]] bool pushBackBits(const std::bitset<N>& flags) noexcept {
+                if (m_begin + packedBoolSize(N) <= m_end) {
+                    packBools(m_begin, flags);
+                    m_begin += packedBoolSize(N);
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer full)
+            }
+
+            /**
+             * @brief Safely writes a std::vector<bool>
+             * @param flags Flags to write
+             * @return true if the operation failed (not enough space), false on success
+             *
+             * Writes the flags using the format:
+             * [count][flags packed eight to a byte][count]
+             * where count is a uint32_t value holding the number of flags.
+             */
+            [[nodiscard]] bool pushBack(const std::vector<bool>& flags) noexcept {
+                const size_t byteSize = packedBoolSize(flags.size());
+                if (m_begin + byteSize + 8 <= m_end) {
+                    unsafePushBack(static_cast<uint32_t>(flags.size()));
+                    packBools(m_begin, flags);
+                    m_begin += byteSize;
+                    unsafePushBack(static_cast<uint32_t>(flags.size()));
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer full)
+            }
+            /** @} */
+
         protected:
             pointer m_begin{ nullptr }; ///< Current write position
             pointer m_end{ nullptr };   ///< End of buffer
@@ -935,6 +1106,189 @@ namespace mz {
             }
             /** @} */
 
+            /**
+             * @name Odd-Width Read Operations
+             * @brief Operations that read integers stored in a given number of bytes (1 to 8)
+             * @{
+             */
+
+             /**
+              * @brief Reads a Bytes-byte integer from the front without checking boundaries
+              * @tparam Bytes Number of stored bytes
+              * @tparam T Integer type of the value; signed types are sign-extended
+              * @param value Reference to store the read value
+              */
+            template <size_t Bytes, typename T>
+                requires OddWidthType<T, Bytes> && (!std::is_const_v<T>)
+            void unsafePopFrontN(T& value) noexcept {
+                basicCopyN<Encoding, Bytes>(value, m_begin);
+                m_begin += Bytes;
+            }
+
+            /**
+             * @brief Reads Bytes-byte integers from the front into a span without checking boundaries
+             * @tparam Bytes Number of stored bytes per value
+             * @tparam T Integer type of the values; signed types are sign-extended
+             * @tparam N Size of the span
+             * @param span Span to store the read values
+             */
+            template <size_t Bytes, typename T, size_t N>
+                requires OddWidthType<T, Bytes> && (!std::is_const_v<T>)
+            void unsafePopFrontN(std::span<T, N> span) noexcept {
+                basicCopyN<Encoding, Bytes>(span, m_begin);
+                m_begin += Bytes * span.size();
+            }
+
+            /**
+             * @brief Safely reads a Bytes-byte integer from the front
+             * @tparam Bytes Number of stored bytes
+             * @tparam T Integer type of the value; signed types are sign-extended
+             * @param value Reference to store the read value
+             * @return true if the operation failed (not enough data), false on success
+             */
+            template <size_t Bytes, typename T>
+                requires OddWidthType<T, Bytes> && (!std::is_const_v<T>)
+            [[nodiscard]] bool popFrontN(T& value) noexcept {
+                if (m_begin + Bytes <= m_end) {
+                    unsafePopFrontN<Bytes>(value);
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer underflow)
+            }
+
+            /**
+             * @brief Safely reads Bytes-byte integers from the front into a span
+             * @tparam Bytes Number of stored bytes per value
+             * @tparam T Integer type of the values; signed types are sign-extended
+             * @tparam N Size of the span
+             * @param span Span to store the read values
+             * @return true if the operation failed (not enough data), false on success
+             */
+            template <size_t Bytes, typename T, size_t N>
+                requires OddWidthType<T, Bytes> && (!std::is_const_v<T>)
+            [[nodiscard]] bool popFrontN(std::span<T, N> span) noexcept {
+                if (m_begin + Bytes * span.size() <= m_end) {
+                    unsafePopFrontN<Bytes>(span);
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer underflow)
+            }
+            /** @} */
+
+            /**
+             * @name Converting Read Operations
+             * @brief Operations that read a wire integer type into a different type
+             * @{
+             */
+
+             /**
+              * @brief Reads Wire integers from the front into a span of another type without checking boundaries
+              * @tparam Wire Integer type stored in the buffer
+              * @tparam T Type of the values (integer or floating point)
+              * @tparam N Size of the span
+              * @param span Span to store the converted values; out-of-range values saturate
+              */
+            template <WireIntType Wire, NativeNumberType T, size_t N>
+                requires (!std::is_const_v<T>)
+            void unsafePopFrontAs(std::span<T, N> span) noexcept {
+                basicCopyAs<Encoding, Wire>(span, m_begin);
+                m_begin += sizeof(Wire) * span.size();
+            }
+
+            /**
+             * @brief Safely reads Wire integers from the front into a span of another type
+             * @tparam Wire Integer type stored in the buffer
+             * @tparam T Type of the values (integer or floating point)
+             * @tparam N Size of the span
+             * @param span Span to store the converted values; out-of-range values saturate
+             * @return true if the operation failed (not enough data), false on success
+             */
+            template <WireIntType Wire, NativeNumberType T, size_t N>
+                requires (!std::is_const_v<T>)
+            [[nodiscard]] bool popFrontAs(std::span<T, N> span) noexcept {
+                if (m_begin + sizeof(Wire) * span.size() <= m_end) {
+                    unsafePopFrontAs<Wire>(span);
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer underflow)
+            }
+            /** @} */
+
+            /**
+             * @name Packed Boolean Read Operations
+             * @brief Operations that read flags stored eight to a byte
+             * @{
+             */
+
+             /**
+              * @brief Safely reads flags packed eight to a byte, without a count
+              * @param flags Receives the flags; reads packedBoolSize(flags.size()) bytes
+              * @return true if the operation failed (not enough data), false on success
+              */
+            [[nodiscard]] bool popFrontBits(std::span<bool> flags) noexcept {
+                const size_t byteSize = packedBoolSize(flags.size());
+                if (m_begin + byteSize <= m_end) {
+                    unpackBools(flags, m_begin);
+                    m_begin += byteSize;
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer underflow)
+            }
+
+            /**
+             * @brief Safely reads a bitset packed eight flags to a byte
+             * @tparam N Number of flags
+             * @param flags Receives the flags; reads packedBoolSize(N) bytes
+             * @return true if the operation failed (not enough data), false on success
+             */
+            template <size_t N>
+            [[nodiscard]] bool popFrontBits(std::bitset<N>& flags) noexcept {
+                if (m_begin + packedBoolSize(N) <= m_end) {
+                    unpackBools(flags, m_begin);
+                    m_begin += packedBoolSize(N);
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer underflow)
+            }
+
+            /**
+             * @brief Safely reads a std::vector<bool>
+             * @param flags Receives the flags
+             * @return true if the operation failed (not enough data or validation error), false on success
+             *
+             * Reads flags written by pushBack(const std::vector<bool>&) using the format:
+             * [count][flags packed eight to a byte][count]
+             * The count suffix is checked to validate the count.
+             */
+            [[nodiscard]] bool popFront(std::vector<bool>& flags) noexcept {
+                auto oldBegin = m_begin;
+                if (m_begin + 8 <= m_end) {
+                    uint32_t count = 0;
+                    unsafePopFront(count);
+                    const size_t byteSize = packedBoolSize(count);
+                    if (m_begin + byteSize + 4 <= m_end) {
+                        // Unpack through a small buffer to keep the word-at-a-time path
+                        bool chunk[256];
+                        flags.resize(count);
+                        for (size_t i = 0; i < count; i += 256) {
+                            const size_t length = std::min<size_t>(256, count - i);
+                            unpackBools(std::span<bool>(chunk, length), m_begin + i / 8);
+                            std::copy(chunk, chunk + length, flags.begin() + static_cast<std::ptrdiff_t>(i));
+                        }
+                        m_begin += byteSize;
+                        uint32_t countCheck = 0;
+                        unsafePopFront(countCheck);
+                        if (count == countCheck) {
+                            return false; // Success (no error)
+                        }
+                    }
+                }
+                flags.clear();
+                m_begin = oldBegin; // Restore the original position
+                return true; // Error
+            }
+            /** @} */
+
         private:
             const_pointer m_begin{ nullptr }; ///< Current read position
             const_pointer m_end{ nullptr };   ///< End of buffer
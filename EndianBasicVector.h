@@ -44,6 +44,7 @@ SOFTWARE.
 #include <string>
 #include <type_traits>
 #include <concepts>
+#include <bitset>
 #include <span>
 #include <bit>
 
@@ -327,7 +328,7 @@ namespace mz {
             template <SwapType T>
             void unsafePushBack(T value) noexcept {
                 // Copy the value with endian conversion if needed
-                basic_copy<Encoding>(data() + size(), value);
+                basicCopy<Encoding>(data() + size(), value);
                 m_size += sizeof(T);
             }
 
@@ -358,7 +359,7 @@ namespace mz {
             void pushBack(const std::span<T, N>& span) noexcept {
                 const size_t byteSize = sizeof(T) * span.size();
                 reserveExtra(byteSize);
-                basic_copy<Encoding>(data() + size(), span);
+                basicCopy<Encoding>(data() + size(), span);
                 m_size += byteSize;
             }
 
@@ -440,7 +441,7 @@ namespace mz {
             template <SwapTypeNonConst T>
             void unsafePopBack(T& value) noexcept {
                 m_size -= sizeof(T);
-                basic_copy<Encoding>(value, data() + size());
+                basicCopy<Encoding>(value, data() + size());
             }
 
             /**
@@ -548,6 +549,123 @@ namespace mz {
             }
             /** @} */
 
+            /**
+             * @name Odd-Width and Converting Operations
+             * @brief Operations on integers stored in a given number of bytes (1 to 8) or as another type
+             * @{
+             */
+
+             /**
+              * @brief Appends the low Bytes bytes of a value
+              * @tparam Bytes Number of bytes to append
+              * @tparam T Integer type of the value
+              * @param value Value to append; higher bytes are dropped
+              */
+            template <size_t Bytes, typename T>
+                requires OddWidthType<T, Bytes>
+            void pushBackN(T value) noexcept {
+                reserveExtra(Bytes);
+                basicCopyN<Encoding, Bytes>(data() + size(), value);
+                m_size += Bytes;
+            }
+
+            /**
+             * @brief Appends Bytes bytes per value of a span
+             * @tparam Bytes Number of bytes to append per value
+             * @tparam T Integer type of the values
+             * @tparam N Size of the span
+             * @param span Span of values to append; higher bytes are dropped
+             */
+            template <size_t Bytes, typename T, size_t N>
+                requires OddWidthType<T, Bytes>
+            void pushBackN(const std::span<T, N>& span) noexcept {
+                const size_t byteSize = Bytes * span.size();
+                reserveExtra(byteSize);
+                basicCopyN<Encoding, Bytes>(data() + size(), span);
+                m_size += byteSize;
+            }
+
+            /**
+             * @brief Safely removes a Bytes-byte integer from the end of the vector
+             * @tparam Bytes Number of stored bytes
+             * @tparam T Integer type of the value; signed types are sign-extended
+             * @param value Reference to store the retrieved value
+             * @return true if the operation failed (not enough data), false on success
+             */
+            template <size_t Bytes, typename T>
+                requires OddWidthType<T, Bytes> && (!std::is_const_v<T>)
+            [[nodiscard]] bool popBackN(T& value) noexcept {
+                if (Bytes <= m_size) {
+                    m_size -= Bytes;
+                    basicCopyN<Encoding, Bytes>(value, data() + size());
+                    return false; // Success (no error)
+                }
+                return true; // Error (buffer underflow)
+            }
+
+            /**
+             * @brief Appends a span of values as Wire integers
+             * @tparam Wire Integer type appended to the vector
+             * @tparam T Type of the values (integer or floating point)
+             * @tparam N Size of the span
+             * @param span Span of values; out-of-range values saturate, floats round to nearest
+             */
+            template <WireIntType Wire, NativeNumberType T, size_t N>
+            void pushBackAs(const std::span<T, N>& span) noexcept {
+                const size_t byteSize = sizeof(Wire) * span.size();
+                reserveExtra(byteSize);
+                basicCopyAs<Encoding, Wire>(data() + size(), span);
+                m_size += byteSize;
+            }
+            /** @} */
+
+            /**
+             * @name Packed Boolean Operations
+             * @brief Operations that store flags eight to a byte
+             * @{
+             */
+
+             /**
+              * @brief Appends flags packed eight to a byte, without a count
+              * @param flags Flags to append; takes packedBoolSize(flags.size()) bytes
+              */
+            void pushBackBits(std::span<const bool> flags) noexcept {
+                const size_t byteSize = packedBoolSize(flags.size());
+                reserveExtra(byteSize);
+                packBools(data() + size(), flags);
+                m_size += byteSize;
+            }
+
+            /**
+             * @brief Appends a bitset packed eight flags to a byte
+             * @tparam N Number of flags
+             * @param flags Flags to append; takes packedBoolSize(N) bytes
+             */
+            template <size_t N>
+            void pushBackBits(const std::bitset<N>& flags) noexcept {
+                reserveExtra(packedBoolSize(N));
+                packBools(data() + size(), flags);
+                m_size += packedBoolSize(N);
+            }
+
+            /**
+             * @brief Appends a std::vector<bool>
+             * @param flags Flags to append
+             *
+             * Appends the flags using the format:
+             * [count][flags packed eight to a byte][count]
+             * where count is a uint32_t value holding the number of flags.
+             */
+            void pushBack(const std::vector<bool>& flags) noexcept {
+                const size_t byteSize = packedBoolSize(flags.size());
+                reserveExtra(byteSize + 8);
+                unsafePushBack(static_cast<uint32_t>(flags.size()));
+                packBools(data() + size(), flags);
+                m_size += byteSize;
+                unsafePushBack(static_cast<uint32_t>(flags.size()));
+            }
+            /** @} */
+
         private:
             size_t m_size{ 0 };               ///< Current logical size of the vector
             std::vector<uint8_t> m_data;    ///< Underlying storage
@@ -0,0 +1,148 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_BIT_OPS_HEADER_FILE
+#define MZ_ENDIAN_BIT_OPS_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianBitOps.h
+ * @brief Low-level bit and memory helpers shared by the index structures
+ *
+ * Small platform wrappers (prefetch hints, wide multiplies) and hash mixing
+ * used by the search, hashing and succinct data structures in this library.
+ * Each helper has a portable fallback, so callers never need their own #if
+ * switches.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <bit>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#define MZ_ENDIAN_BIT_OPS_BMI2 1
+#endif
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Hints that a cache line will soon be read
+         * @param address Any address inside the line; it is never dereferenced
+         */
+        inline void prefetchRead(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+            (void)address;
+#endif
+        }
+
+        /**
+         * @brief Finalizes a 64-bit value into a well-mixed hash (splitmix64 finalizer)
+         * @param value Value to mix
+         * @return Mixed value; every input bit affects every output bit
+         */
+        [[nodiscard]] constexpr uint64_t mix64(uint64_t value) noexcept {
+            value ^= value >> 30;
+            value *= 0xBF58476D1CE4E5B9ULL;
+            value ^= value >> 27;
+            value *= 0x94D049BB133111EBULL;
+            value ^= value >> 31;
+            return value;
+        }
+
+        /**
+         * @brief Gets the high 64 bits of a 64x64-bit product
+         * @param lhs First factor
+         * @param rhs Second factor
+         * @return (lhs * rhs) >> 64
+         *
+         * mulHigh64(hash, n) maps a uniform 64-bit hash to [0, n) without a division.
+         */
+        [[nodiscard]] inline uint64_t mulHigh64(uint64_t lhs, uint64_t rhs) noexcept {
+#if defined(__SIZEOF_INT128__)
+            __extension__ typedef unsigned __int128 Product; // Keeps -Wpedantic quiet
+            return static_cast<uint64_t>((static_cast<Product>(lhs) * rhs) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            return __umulh(lhs, rhs);
+#else
+            const uint64_t lhsLow = lhs & 0xFFFFFFFFULL;
+            const uint64_t lhsHigh = lhs >> 32;
+            const uint64_t rhsLow = rhs & 0xFFFFFFFFULL;
+            const uint64_t rhsHigh = rhs >> 32;
+            const uint64_t cross = (lhsLow * rhsLow >> 32) + (lhsHigh * rhsLow & 0xFFFFFFFFULL) + lhsLow * rhsHigh;
+            return lhsHigh * rhsHigh + (lhsHigh * rhsLow >> 32) + (cross >> 32);
+#endif
+        }
+
+        /**
+         * @brief Finds the position of the k-th set bit of a word
+         * @param word Word to search
+         * @param rank Zero-based index of the set bit (must be less than popcount(word))
+         * @return Bit position in [0, 64)
+         *
+         * With BMI2 this is a single PDEP that deposits bit rank onto the
+         * rank-th set bit. Otherwise a broadword byte-popcount prefix picks the
+         * byte, and the bit is found inside it.
+         */
+        [[nodiscard]] inline unsigned select64(uint64_t word, unsigned rank) noexcept {
+#if defined(MZ_ENDIAN_BIT_OPS_BMI2)
+            return static_cast<unsigned>(std::countr_zero(_pdep_u64(uint64_t{ 1 } << rank, word)));
+#else
+            uint64_t sums = word - ((word >> 1) & 0x5555555555555555ULL);
+            sums = (sums & 0x3333333333333333ULL) + ((sums >> 2) & 0x3333333333333333ULL);
+            sums = (sums + (sums >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            sums *= 0x0101010101010101ULL;  // Byte i = set bits in bytes 0..i
+
+            unsigned byte = 0;
+            while (((sums >> (byte * 8)) & 0xFF) <= rank) {
+                ++byte;
+            }
+            if (byte > 0) {
+                rank -= static_cast<unsigned>((sums >> ((byte - 1) * 8)) & 0xFF);
+            }
+            uint64_t bits = (word >> (byte * 8)) & 0xFF;
+            for (; rank > 0; --rank) {
+                bits &= bits - 1;
+            }
+            return byte * 8 + static_cast<unsigned>(std::countr_zero(bits));
+#endif
+        }
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_BIT_OPS_BMI2
+
+#endif // MZ_ENDIAN_BIT_OPS_HEADER_FILE
@@ -0,0 +1,420 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_BIT_VECTOR_HEADER_FILE
+#define MZ_ENDIAN_BIT_VECTOR_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianBitVector.h
+ * @brief Succinct rank/select bitvector with an mmap-able layout
+ *
+ * This header provides writeRankSelect, which serializes a bitvector together
+ * with its rank/select directory into a BasicWriteBuffer, and
+ * BasicBitVectorView, which answers rank and select queries directly on those
+ * bytes.
+ *
+ * The directory follows rank9: every 512-bit block is stored next to its
+ * counts as [uint64_t ones before the block][uint64_t 7 x 9-bit counts of
+ * ones before words 1..7 within the block][8 data words], so a rank query
+ * reads one 80-byte block and does one POPCNT. Select keeps the block index
+ * of every 512th one (and zero), scans or bisects a few block counters, picks
+ * the word from the 9-bit counts, and finishes with select64 (PDEP under
+ * BMI2).
+ *
+ * Serialized layout (all integers in Encoding):
+ *   [uint32_t magic][uint32_t 0][uint64_t bits][uint64_t ones][uint64_t 0]
+ *   [(bits / 512 + 2) blocks of 10 x uint64_t]   (the last block is a sentinel)
+ *   [ceil(ones / 512) x uint64_t][ceil(zeros / 512) x uint64_t] select samples
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+#include "EndianBitOps.h"
+
+namespace mz {
+    namespace endian {
+
+        /// Magic number at the start of a serialized bitvector ("MZBV")
+        static constexpr uint32_t bit_vector_magic{ 0x56425A4DU };
+
+        namespace detail {
+
+            static constexpr size_t bit_vector_header_size{ 32 };
+            static constexpr size_t bit_vector_block_bits{ 512 };
+            static constexpr size_t bit_vector_block_words{ 10 };    ///< Two counters plus eight data words
+            static constexpr uint64_t bit_vector_sample_rate{ 512 }; ///< Ones (or zeros) per select sample
+
+            [[nodiscard]] constexpr uint64_t bitVectorBlocks(uint64_t bitCount) noexcept {
+                return bitCount / bit_vector_block_bits + 2;
+            }
+
+            [[nodiscard]] inline uint64_t bitVectorWord(std::span<const uint64_t> words, uint64_t bitCount, uint64_t index) noexcept {
+                if (index >= words.size() || index * 64 >= bitCount) {
+                    return 0;
+                }
+                const uint64_t valid = bitCount - index * 64;
+                return valid >= 64 ? words[static_cast<size_t>(index)] : words[static_cast<size_t>(index)] & ((uint64_t{ 1 } << valid) - 1);
+            }
+
+            [[nodiscard]] inline uint64_t bitVectorOnes(std::span<const uint64_t> words, uint64_t bitCount) noexcept {
+                uint64_t ones = 0;
+                for (uint64_t w = 0; w * 64 < bitCount; ++w) {
+                    ones += static_cast<uint64_t>(std::popcount(bitVectorWord(words, bitCount, w)));
+                }
+                return ones;
+            }
+
+        } // namespace detail
+
+        /**
+         * @brief Calculates the serialized size of a bitvector with its directory
+         * @param words Bits, 64 per word, bit i at words[i / 64] >> (i % 64)
+         * @param bitCount Number of valid bits
+         * @return Size in bytes needed by writeRankSelect
+         */
+        [[nodiscard]] inline size_t calculateRankSelectSize(std::span<const uint64_t> words, uint64_t bitCount) noexcept {
+            const uint64_t ones = detail::bitVectorOnes(words, bitCount);
+            const uint64_t zeros = bitCount - ones;
+            const uint64_t rate = detail::bit_vector_sample_rate;
+            return static_cast<size_t>(detail::bit_vector_header_size
+                + detail::bitVectorBlocks(bitCount) * detail::bit_vector_block_words * 8
+                + ((ones + rate - 1) / rate + (zeros + rate - 1) / rate) * 8);
+        }
+
+        /**
+         * @brief Writes a bitvector and its rank/select directory
+         * @tparam Encoding Endianness of the serialized integers
+         * @param words Bits, 64 per word, bit i at words[i / 64] >> (i % 64); bits past bitCount are ignored
+         * @param bitCount Number of valid bits (words.size() * 64 at most)
+         * @param buffer Write buffer with at least calculateRankSelectSize() bytes left; advanced past the output
+         * @return true if the buffer is too small or bitCount exceeds the words, false on success
+         */
+        template <std::endian Encoding>
+        [[nodiscard]] bool writeRankSelect(std::span<const uint64_t> words, uint64_t bitCount, BasicWriteBuffer<Encoding>& buffer) noexcept {
+            if (bitCount > static_cast<uint64_t>(words.size()) * 64) {
+                return true; // Error (bitCount exceeds the words)
+            }
+            const size_t total = calculateRankSelectSize(words, bitCount);
+            if (buffer.size() < total) {
+                return true; // Error (buffer too small)
+            }
+
+            const uint64_t blocks = detail::bitVectorBlocks(bitCount);
+            uint8_t* header = buffer.data();
+            uint8_t* blockArea = header + detail::bit_vector_header_size;
+            std::memset(header, 0, total);
+
+            // Blocks with interleaved counters; remember where sample boundaries fall
+            uint64_t ones = 0;
+            uint64_t nextOnes = 0;
+            uint64_t nextZeros = 0;
+            uint64_t onesSamples = 0;
+            uint64_t zerosSamples = 0;
+            const uint64_t rate = detail::bit_vector_sample_rate;
+            const uint64_t bitOnes = detail::bitVectorOnes(words, bitCount);
+            const uint64_t bitZeros = bitCount - bitOnes;
+            uint8_t* onesArea = blockArea + blocks * detail::bit_vector_block_words * 8;
+            uint8_t* zerosArea = onesArea + ((bitOnes + rate - 1) / rate) * 8;
+
+            for (uint64_t b = 0; b < blocks; ++b) {
+                uint8_t* block = blockArea + b * detail::bit_vector_block_words * 8;
+                const uint64_t zerosBefore = std::min(b * detail::bit_vector_block_bits, bitCount) - ones;
+                uint64_t blockOnes = 0;
+                uint64_t relative = 0;
+                for (uint64_t j = 0; j < 8; ++j) {
+                    if (j > 0) {
+                        relative |= blockOnes << (9 * (j - 1));
+                    }
+                    const uint64_t word = detail::bitVectorWord(words, bitCount, b * 8 + j);
+                    basicCopy<Encoding>(block + (2 + j) * 8, word);
+                    blockOnes += static_cast<uint64_t>(std::popcount(word));
+                }
+                basicCopy<Encoding>(block, ones);
+                basicCopy<Encoding>(block + 8, relative);
+
+                // Select samples: block holding the (k * rate)-th one / zero
+                const uint64_t blockZeros = std::min((b + 1) * detail::bit_vector_block_bits, bitCount) - std::min(b * detail::bit_vector_block_bits, bitCount) - blockOnes;
+                for (; nextOnes < bitOnes && nextOnes < ones + blockOnes; nextOnes += rate) {
+                    basicCopy<Encoding>(onesArea + (onesSamples++) * 8, b);
+                }
+                for (; nextZeros < bitZeros && nextZeros < zerosBefore + blockZeros; nextZeros += rate) {
+                    basicCopy<Encoding>(zerosArea + (zerosSamples++) * 8, b);
+                }
+                ones += blockOnes;
+            }
+
+            basicCopy<Encoding>(header, bit_vector_magic);
+            basicCopy<Encoding>(header + 8, bitCount);
+            basicCopy<Encoding>(header + 16, bitOnes);
+            buffer.skip(total);
+            return false; // Success (no error)
+        }
+
+        /**
+         * @class BasicBitVectorView
+         * @brief Rank and select queries on a serialized bitvector
+         *
+         * The view only stores pointers into the buffer it was opened on; the
+         * buffer must outlive it.
+         *
+         * @tparam Encoding Endianness of the serialized integers
+         */
+        template <std::endian Encoding>
+        class BasicBitVectorView {
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an empty view
+              */
+            explicit BasicBitVectorView() noexcept = default;
+            /** @} */
+
+            /**
+             * @name Opening
+             * @{
+             */
+
+             /**
+              * @brief Attaches the view to a serialized bitvector
+              * @param buffer Read buffer positioned at the bitvector; advanced past it on success
+              * @return true if the header or size is invalid, or a select sample does
+              *         not name the block holding its bit, false on success
+              */
+            [[nodiscard]] bool open(BasicReadBuffer<Encoding>& buffer) noexcept {
+                if (buffer.size() < detail::bit_vector_header_size) {
+                    return true; // Error (truncated header)
+                }
+                const uint8_t* header = buffer.data();
+                uint32_t magic = 0;
+                uint64_t bitCount = 0;
+                uint64_t ones = 0;
+                basicCopy<Encoding>(magic, header);
+                basicCopy<Encoding>(bitCount, header + 8);
+                basicCopy<Encoding>(ones, header + 16);
+                const uint64_t available = buffer.size() - detail::bit_vector_header_size;
+                if (magic != bit_vector_magic || ones > bitCount || bitCount / 8 > available) {
+                    return true; // Error (bad header)
+                }
+                const uint64_t rate = detail::bit_vector_sample_rate;
+                const uint64_t blocks = detail::bitVectorBlocks(bitCount);
+                const uint64_t onesSamples = (ones + rate - 1) / rate;
+                const uint64_t zerosSamples = (bitCount - ones + rate - 1) / rate;
+                const uint64_t bodySize = (blocks * detail::bit_vector_block_words + onesSamples + zerosSamples) * 8;
+                if (bodySize > available) {
+                    return true; // Error (truncated body)
+                }
+                m_blocks = header + detail::bit_vector_header_size;
+                m_onesSamples = m_blocks + blocks * detail::bit_vector_block_words * 8;
+                m_zerosSamples = m_onesSamples + onesSamples * 8;
+                m_bitCount = bitCount;
+                m_ones = ones;
+                m_blockCount = blocks;
+                if (!samplesValid<true>(onesSamples) || !samplesValid<false>(zerosSamples)) {
+                    *this = BasicBitVectorView{};
+                    return true; // Error (a sample does not name the block holding its bit)
+                }
+                buffer.skipFront(detail::bit_vector_header_size + static_cast<size_t>(bodySize));
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Queries
+             * @{
+             */
+
+             /**
+              * @brief Gets the number of bits
+              * @return Bit count
+              */
+            [[nodiscard]] uint64_t size() const noexcept { return m_bitCount; }
+
+            /**
+             * @brief Gets the number of set bits
+             * @return Ones count
+             */
+            [[nodiscard]] uint64_t ones() const noexcept { return m_ones; }
+
+            /**
+             * @brief Reads one bit
+             * @param position Bit index in [0, size())
+             * @return The bit
+             */
+            [[nodiscard]] bool get(uint64_t position) const noexcept {
+                return (dataWord(position / detail::bit_vector_block_bits, (position / 64) % 8) >> (position % 64)) & 1;
+            }
+
+            /**
+             * @brief Counts set bits before a position
+             * @param position Bit index in [0, size()]
+             * @return Number of ones in [0, position)
+             */
+            [[nodiscard]] uint64_t rank1(uint64_t position) const noexcept {
+                const uint64_t block = position / detail::bit_vector_block_bits;
+                const size_t word = static_cast<size_t>((position / 64) % 8);
+                uint64_t rank = counter(block, 0) + relativeOnes(block, word);
+                if (const unsigned bit = static_cast<unsigned>(position % 64); bit) {
+                    rank += static_cast<uint64_t>(std::popcount(dataWord(block, word) & ((uint64_t{ 1 } << bit) - 1)));
+                }
+                return rank;
+            }
+
+            /**
+             * @brief Counts clear bits before a position
+             * @param position Bit index in [0, size()]
+             * @return Number of zeros in [0, position)
+             */
+            [[nodiscard]] uint64_t rank0(uint64_t position) const noexcept {
+                return position - rank1(position);
+            }
+
+            /**
+             * @brief Finds the position of a set bit by rank
+             * @param rank Zero-based rank in [0, ones())
+             * @return Position of the rank-th one
+             */
+            [[nodiscard]] uint64_t select1(uint64_t rank) const noexcept {
+                return select<true>(rank);
+            }
+
+            /**
+             * @brief Finds the position of a clear bit by rank
+             * @param rank Zero-based rank in [0, size() - ones())
+             * @return Position of the rank-th zero
+             */
+            [[nodiscard]] uint64_t select0(uint64_t rank) const noexcept {
+                return select<false>(rank);
+            }
+            /** @} */
+
+        private:
+            const uint8_t* m_blocks{ nullptr };        ///< Interleaved counters and data
+            const uint8_t* m_onesSamples{ nullptr };   ///< Block of every 512th one
+            const uint8_t* m_zerosSamples{ nullptr };  ///< Block of every 512th zero
+            uint64_t m_bitCount{ 0 };                  ///< Number of bits
+            uint64_t m_ones{ 0 };                      ///< Number of ones
+            uint64_t m_blockCount{ 0 };                ///< Blocks including the sentinel
+
+            [[nodiscard]] static uint64_t load64(const uint8_t* address) noexcept {
+                uint64_t value = 0;
+                basicCopy<Encoding>(value, address);
+                return value;
+            }
+
+            [[nodiscard]] uint64_t counter(uint64_t block, size_t index) const noexcept {
+                return load64(m_blocks + (block * detail::bit_vector_block_words + index) * 8);
+            }
+
+            [[nodiscard]] uint64_t dataWord(uint64_t block, size_t word) const noexcept {
+                return counter(block, 2 + word);
+            }
+
+            [[nodiscard]] uint64_t relativeOnes(uint64_t block, size_t word) const noexcept {
+                return word ? (counter(block, 1) >> (9 * (word - 1))) & 0x1FF : 0;
+            }
+
+            /**
+             * @brief Ones (or zeros) before a block
+             */
+            template <bool Ones>
+            [[nodiscard]] uint64_t before(uint64_t block) const noexcept {
+                const uint64_t ones = counter(block, 0);
+                return Ones ? ones : std::min(block * detail::bit_vector_block_bits, m_bitCount) - ones;
+            }
+
+            /**
+             * @brief Checks that every sample is a data block holding its ones (or zeros) rank
+             *
+             * select() searches between neighbouring samples without bounds, so each
+             * one must be the block b with before(b) <= rank < before(b + 1).
+             */
+            template <bool Ones>
+            [[nodiscard]] bool samplesValid(uint64_t count) const noexcept {
+                const uint8_t* samples = Ones ? m_onesSamples : m_zerosSamples;
+                for (uint64_t i = 0; i < count; ++i) {
+                    const uint64_t block = load64(samples + i * 8);
+                    const uint64_t rank = i * detail::bit_vector_sample_rate;
+                    if (block + 1 >= m_blockCount || before<Ones>(block) > rank || before<Ones>(block + 1) <= rank) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            template <bool Ones>
+            [[nodiscard]] uint64_t select(uint64_t rank) const noexcept {
+                const uint8_t* samples = Ones ? m_onesSamples : m_zerosSamples;
+                const uint64_t sample = rank / detail::bit_vector_sample_rate;
+                const uint64_t total = Ones ? m_ones : m_bitCount - m_ones;
+                const uint64_t sampleCount = (total + detail::bit_vector_sample_rate - 1) / detail::bit_vector_sample_rate;
+
+                // Last block whose count before it is <= rank, between two samples
+                uint64_t low = load64(samples + sample * 8);
+                uint64_t high = (sample + 1 < sampleCount) ? load64(samples + (sample + 1) * 8) + 1 : m_blockCount - 1;
+                while (high - low > 8) {
+                    const uint64_t middle = low + (high - low) / 2;
+                    if (before<Ones>(middle) <= rank) low = middle;
+                    else high = middle;
+                }
+                while (low + 1 < high && before<Ones>(low + 1) <= rank) {
+                    ++low;
+                }
+
+                uint64_t remaining = rank - before<Ones>(low);
+                size_t word = 7;
+                for (size_t j = 1; j < 8; ++j) {
+                    const uint64_t prior = Ones ? relativeOnes(low, j) : 64 * j - relativeOnes(low, j);
+                    if (prior > remaining) {
+                        word = j - 1;
+                        break;
+                    }
+                }
+                remaining -= Ones ? relativeOnes(low, word) : 64 * word - relativeOnes(low, word);
+                const uint64_t bits = Ones ? dataWord(low, word) : ~dataWord(low, word);
+                return low * detail::bit_vector_block_bits + word * 64 + select64(bits, static_cast<unsigned>(remaining));
+            }
+        };
+
+        /**
+         * @brief Bitvector view that uses the default stream endianness
+         */
+        using BitVectorView = BasicBitVectorView<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_BIT_VECTOR_HEADER_FILE
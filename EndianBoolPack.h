@@ -0,0 +1,208 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_BOOL_PACK_HEADER_FILE
+#define MZ_ENDIAN_BOOL_PACK_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianBoolPack.h
+ * @brief Packing of boolean flags eight to a byte
+ *
+ * This header provides packBools() and unpackBools(), which convert between
+ * spans of bool and packed bits, and the bit helpers used by the pushBackBits
+ * and popFrontBits members of the buffers and BasicVector. Flag i is stored
+ * in bit i % 8 of byte i / 8, so the format does not depend on Encoding; the
+ * unused bits of the last byte are zero.
+ *
+ * Packing gathers sixteen flags per SSE2 movemask, or eight per multiply
+ * otherwise. Unpacking spreads eight flags per BMI2 PDEP, or per
+ * multiply-and-mask otherwise.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <bitset>
+#include <vector>
+#include <span>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define MZ_ENDIAN_BOOL_PACK_SSE2 1
+#endif
+#if defined(__BMI2__)
+#include <immintrin.h>
+#define MZ_ENDIAN_BOOL_PACK_BMI2 1
+#endif
+
+#include "EndianConversions.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Gets the number of bytes that hold a number of packed flags
+         * @param count Number of flags
+         * @return Bytes needed
+         */
+        [[nodiscard]] constexpr size_t packedBoolSize(size_t count) noexcept {
+            return (count + 7) / 8;
+        }
+
+        namespace detail {
+
+            /**
+             * @brief Packs eight bools, loaded as a little-endian word, into one byte
+             */
+            [[nodiscard]] inline uint8_t packBoolWord(const bool* source) noexcept {
+                uint64_t word = 0;
+                std::memcpy(&word, source, 8);
+                if constexpr (std::endian::native == std::endian::big) {
+                    word = byteSwap(word);
+                }
+                return static_cast<uint8_t>((word * 0x0102040810204080ULL) >> 56);
+            }
+
+            /**
+             * @brief Expands one byte into eight bools
+             */
+            inline void unpackBoolWord(bool* destination, uint8_t bits) noexcept {
+#if defined(MZ_ENDIAN_BOOL_PACK_BMI2)
+                uint64_t word = _pdep_u64(bits, 0x0101010101010101ULL);
+#else
+                uint64_t word = (bits * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+                word = ((word + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+#endif
+                if constexpr (std::endian::native == std::endian::big) {
+                    word = byteSwap(word);
+                }
+                std::memcpy(destination, &word, 8);
+            }
+
+        } // namespace detail
+
+        /**
+         * @brief Packs flags eight to a byte
+         * @param destination Receives packedBoolSize(source.size()) bytes
+         * @param source Flags to pack
+         */
+        inline void packBools(uint8_t* destination, std::span<const bool> source) noexcept {
+            const size_t count = source.size();
+            const bool* in = source.data();
+            size_t i = 0;
+#if defined(MZ_ENDIAN_BOOL_PACK_SSE2)
+            for (; i + 16 <= count; i += 16) {
+                // bool is 0 or 1, so moving bit 0 to bit 7 lets movemask collect it
+                const __m128i flags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_slli_epi16(flags, 7)));
+                destination[i / 8] = static_cast<uint8_t>(mask);
+                destination[i / 8 + 1] = static_cast<uint8_t>(mask >> 8);
+            }
+#endif
+            for (; i + 8 <= count; i += 8) {
+                destination[i / 8] = detail::packBoolWord(in + i);
+            }
+            if (i < count) {
+                uint8_t last = 0;
+                for (size_t bit = 0; i + bit < count; ++bit) {
+                    last = static_cast<uint8_t>(last | (static_cast<uint8_t>(in[i + bit]) << bit));
+                }
+                destination[i / 8] = last;
+            }
+        }
+
+        /**
+         * @brief Unpacks flags stored eight to a byte
+         * @param destination Receives one flag per element
+         * @param source Holds packedBoolSize(destination.size()) bytes
+         */
+        inline void unpackBools(std::span<bool> destination, const uint8_t* source) noexcept {
+            const size_t count = destination.size();
+            bool* out = destination.data();
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                detail::unpackBoolWord(out + i, source[i / 8]);
+            }
+            for (; i < count; ++i) {
+                out[i] = ((source[i / 8] >> (i % 8)) & 1) != 0;
+            }
+        }
+
+        /**
+         * @brief Packs a std::vector<bool> eight flags to a byte
+         * @param destination Receives packedBoolSize(source.size()) bytes
+         * @param source Flags to pack
+         */
+        inline void packBools(uint8_t* destination, const std::vector<bool>& source) noexcept {
+            const size_t count = source.size();
+            for (size_t byte = 0; byte < packedBoolSize(count); ++byte) {
+                uint8_t bits = 0;
+                for (size_t bit = 0; bit < 8 && byte * 8 + bit < count; ++bit) {
+                    bits = static_cast<uint8_t>(bits | (static_cast<uint8_t>(source[byte * 8 + bit]) << bit));
+                }
+                destination[byte] = bits;
+            }
+        }
+
+        /**
+         * @brief Packs a std::bitset eight flags to a byte
+         * @tparam N Number of flags
+         * @param destination Receives packedBoolSize(N) bytes
+         * @param source Flags to pack
+         */
+        template <size_t N>
+        inline void packBools(uint8_t* destination, const std::bitset<N>& source) noexcept {
+            for (size_t byte = 0; byte < packedBoolSize(N); ++byte) {
+                uint8_t bits = 0;
+                for (size_t bit = 0; bit < 8 && byte * 8 + bit < N; ++bit) {
+                    bits = static_cast<uint8_t>(bits | (static_cast<uint8_t>(source[byte * 8 + bit]) << bit));
+                }
+                destination[byte] = bits;
+            }
+        }
+
+        /**
+         * @brief Unpacks flags stored eight to a byte into a std::bitset
+         * @tparam N Number of flags
+         * @param destination Receives the flags
+         * @param source Holds packedBoolSize(N) bytes
+         */
+        template <size_t N>
+        inline void unpackBools(std::bitset<N>& destination, const uint8_t* source) noexcept {
+            for (size_t i = 0; i < N; ++i) {
+                destination[i] = ((source[i / 8] >> (i % 8)) & 1) != 0;
+            }
+        }
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_BOOL_PACK_SSE2
+#undef MZ_ENDIAN_BOOL_PACK_BMI2
+
+#endif // MZ_ENDIAN_BOOL_PACK_HEADER_FILE
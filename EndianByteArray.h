@@ -579,6 +579,199 @@ namespace mz {
             uint8_t m_bytes[N]{ 0 };
         };
 
+        /**
+         * @class HashedByteArray
+         * @brief A ByteArray that carries its own precomputed hash
+         *
+         * The hash is computed once whenever the content is set and stored next to
+         * the bytes, so hashing is a load and equality rejects most mismatches by
+         * comparing hashes before touching the bytes. The content is read-only
+         * through this class; assign a new value to change it.
+         *
+         * The cached value is ByteArray::generateHash(), so a HashedByteArray lands
+         * in the same bucket, shard or partition as the plain ByteArray it wraps.
+         *
+         * @tparam N Size of the byte array (must be greater than 0)
+         */
+        template <size_t N>
+            requires (N > 0)
+        class HashedByteArray
+        {
+        public:
+            /**
+             * @name Type Definitions
+             * @{
+             */
+            using value_type = uint8_t;           ///< The underlying byte type
+            using const_pointer = const uint8_t*; ///< Const pointer to byte type
+
+            /**
+             * @brief Hash functor for unordered containers; returns the cached hash
+             */
+            struct Hash {
+                [[nodiscard]] size_t operator()(const HashedByteArray& value) const noexcept {
+                    return static_cast<size_t>(value.m_hash);
+                }
+            };
+            /** @} */
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor
+              *
+              * Creates a zero-initialized byte array with its hash.
+              */
+            explicit HashedByteArray() noexcept
+                : m_hash{ m_array.generateHash() } {
+            }
+
+            /**
+             * @brief Constructs from a byte array
+             * @param array Byte array to copy
+             */
+            explicit HashedByteArray(const ByteArray<N>& array) noexcept
+                : m_array{ array }, m_hash{ array.generateHash() } {
+            }
+
+            /**
+             * @brief Constructs from a string, as ByteArray(const std::string&) does
+             * @param str String to copy into the byte array
+             */
+            explicit HashedByteArray(const std::string& str) noexcept
+                : m_array{ str }, m_hash{ m_array.generateHash() } {
+            }
+
+            /**
+             * @brief Constructs from a wide string, as ByteArray(const std::wstring&) does
+             * @param wstr Wide string to copy into the byte array
+             */
+            explicit HashedByteArray(const std::wstring& wstr) noexcept
+                : m_array{ wstr }, m_hash{ m_array.generateHash() } {
+            }
+            /** @} */
+
+            /**
+             * @name Assignment Operators
+             * @{
+             */
+
+             /**
+              * @brief Assigns a byte array and recomputes the hash
+              * @param array Byte array to copy
+              * @return Reference to this object
+              */
+            HashedByteArray& operator=(const ByteArray<N>& array) noexcept {
+                m_array = array;
+                m_hash = m_array.generateHash();
+                return *this;
+            }
+
+            /**
+             * @brief Assigns a string and recomputes the hash
+             * @param str String to copy into the byte array
+             * @return Reference to this object
+             */
+            HashedByteArray& operator=(const std::string& str) noexcept {
+                m_array = str;
+                m_hash = m_array.generateHash();
+                return *this;
+            }
+
+            /**
+             * @brief Assigns a wide string and recomputes the hash
+             * @param wstr Wide string to copy into the byte array
+             * @return Reference to this object
+             */
+            HashedByteArray& operator=(const std::wstring& wstr) noexcept {
+                m_array = wstr;
+                m_hash = m_array.generateHash();
+                return *this;
+            }
+            /** @} */
+
+            /**
+             * @name Accessors
+             * @{
+             */
+
+             /**
+              * @brief Gets the wrapped byte array
+              * @return Const reference to the byte array
+              */
+            [[nodiscard]] const ByteArray<N>& array() const noexcept { return m_array; }
+
+            /**
+             * @brief Gets a pointer to the bytes
+             * @return Const pointer to the first byte
+             */
+            [[nodiscard]] const_pointer data() const noexcept { return m_array.data(); }
+
+            /**
+             * @brief Gets a span over the bytes
+             * @return Const span of N bytes
+             */
+            [[nodiscard]] std::span<const value_type, N> span() const noexcept { return m_array.span(); }
+
+            /**
+             * @brief Gets the cached hash
+             * @return The value of ByteArray::generateHash() for the content
+             */
+            [[nodiscard]] uint64_t hash() const noexcept { return m_hash; }
+
+            /**
+             * @brief Gets the cached hash (drop-in for ByteArray::generateHash)
+             * @return The cached hash
+             */
+            [[nodiscard]] uint64_t generateHash() const noexcept { return m_hash; }
+            /** @} */
+
+            /**
+             * @name Comparison Operators
+             * @{
+             */
+
+             /**
+              * @brief Equality comparison operator
+              * @param lhs First value to compare
+              * @param rhs Second value to compare
+              * @return true if the arrays have identical content
+              *
+              * Different hashes prove inequality without reading the bytes.
+              */
+            friend bool operator==(const HashedByteArray& lhs, const HashedByteArray& rhs) noexcept {
+                return lhs.m_hash == rhs.m_hash && lhs.m_array == rhs.m_array;
+            }
+
+            /**
+             * @brief Inequality comparison operator
+             * @param lhs First value to compare
+             * @param rhs Second value to compare
+             * @return true if the arrays have different content
+             */
+            friend bool operator!=(const HashedByteArray& lhs, const HashedByteArray& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+
+            /**
+             * @brief Less-than comparison operator
+             * @param lhs First value to compare
+             * @param rhs Second value to compare
+             * @return true if lhs is lexicographically less than rhs (same order as ByteArray)
+             */
+            friend bool operator<(const HashedByteArray& lhs, const HashedByteArray& rhs) noexcept {
+                return lhs.m_array < rhs.m_array;
+            }
+            /** @} */
+
+        private:
+            ByteArray<N> m_array;  ///< The bytes
+            uint64_t m_hash;       ///< Cached generateHash() of m_array
+        };
+
     } // namespace endian
 } // namespace mz
 
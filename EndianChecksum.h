@@ -0,0 +1,122 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_CHECKSUM_HEADER_FILE
+#define MZ_ENDIAN_CHECKSUM_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianChecksum.h
+ * @brief CRC-32C checksums for framed data
+ *
+ * crc32c() computes the Castagnoli CRC used by iSCSI, ext4 and most storage
+ * formats. With SSE4.2 it uses the CRC32 instruction eight bytes at a time;
+ * otherwise it falls back to slicing-by-8 tables built at compile time. Both
+ * paths give identical results, so checksums can be verified on any host.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <span>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define MZ_ENDIAN_CHECKSUM_SSE42 1
+#endif
+
+namespace mz {
+    namespace endian {
+
+        namespace detail {
+
+            /**
+             * @brief Slicing-by-8 tables for the reflected Castagnoli polynomial
+             */
+            [[nodiscard]] constexpr std::array<std::array<uint32_t, 256>, 8> makeCrc32cTables() noexcept {
+                std::array<std::array<uint32_t, 256>, 8> tables{};
+                for (uint32_t i = 0; i < 256; ++i) {
+                    uint32_t crc = i;
+                    for (int bit = 0; bit < 8; ++bit) {
+                        crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78U : 0);
+                    }
+                    tables[0][i] = crc;
+                }
+                for (size_t t = 1; t < 8; ++t) {
+                    for (uint32_t i = 0; i < 256; ++i) {
+                        tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+                    }
+                }
+                return tables;
+            }
+
+            inline constexpr auto crc32c_tables{ makeCrc32cTables() };
+
+        } // namespace detail
+
+        /**
+         * @brief Computes or extends a CRC-32C checksum
+         * @param bytes Data to checksum
+         * @param crc Checksum of the preceding data (0 to start)
+         * @return Checksum of the preceding data followed by bytes
+         */
+        [[nodiscard]] inline uint32_t crc32c(std::span<const uint8_t> bytes, uint32_t crc = 0) noexcept {
+            const uint8_t* data = bytes.data();
+            size_t size = bytes.size();
+            crc = ~crc;
+#if defined(MZ_ENDIAN_CHECKSUM_SSE42)
+            uint64_t wide = crc;
+            for (; size >= 8; size -= 8, data += 8) {
+                uint64_t word = 0;
+                std::memcpy(&word, data, 8);
+                wide = _mm_crc32_u64(wide, word);
+            }
+            crc = static_cast<uint32_t>(wide);
+            for (; size > 0; --size, ++data) {
+                crc = _mm_crc32_u8(crc, *data);
+            }
+#else
+            const auto& t = detail::crc32c_tables;
+            for (; size >= 8; size -= 8, data += 8) {
+                // Bytes are combined explicitly, so the result does not depend on host byte order
+                const uint32_t low = crc ^ (uint32_t{ data[0] } | uint32_t{ data[1] } << 8 | uint32_t{ data[2] } << 16 | uint32_t{ data[3] } << 24);
+                crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24]
+                    ^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+            }
+            for (; size > 0; --size, ++data) {
+                crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+            }
+#endif
+            return ~crc;
+        }
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_CHECKSUM_SSE42
+
+#endif // MZ_ENDIAN_CHECKSUM_HEADER_FILE
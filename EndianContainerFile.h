@@ -0,0 +1,719 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_CONTAINER_FILE_HEADER_FILE
+#define MZ_ENDIAN_CONTAINER_FILE_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianContainerFile.h
+ * @brief Multi-channel container files with interleaved, indexed chunks
+ *
+ * This header defines BasicContainerWriter, which records timestamped messages
+ * from many logical channels into a single file, and BasicContainerReader,
+ * which replays one channel or all of them over a time window.
+ *
+ * The writer builds one chunk per channel in its own BasicVector. When a chunk
+ * reaches the configured size it is framed with a CRC-32C and appended to the
+ * file, so chunks of different channels end up interleaved in the order they
+ * filled. close() writes the remaining chunks and a summary that lists every
+ * channel and, for every chunk, its channel, time range and location. The
+ * reader maps the file, loads the summary and, for a replay, touches only the
+ * chunks of the requested channels whose time range overlaps the window.
+ *
+ * Timestamps must not decrease within a channel, which keeps each channel's
+ * chunk list sorted by time; replaying several channels merges them by
+ * timestamp.
+ *
+ * File layout (all integers in Encoding):
+ *   [uint32_t magic][uint32_t version]
+ *   chunks x ([uint32_t chunk magic][uint32_t channel][uint64_t first time][uint64_t last time]
+ *             [uint64_t messages][uint64_t length][uint32_t crc][uint32_t 0]
+ *             [messages x ([uint64_t timestamp][uint32_t size][payload])])
+ *   summary: [uint32_t channels] channels x [string name]
+ *            [uint64_t chunks] chunks x ([uint32_t channel][uint32_t crc][uint64_t first time]
+ *            [uint64_t last time][uint64_t messages][uint64_t offset][uint64_t length])
+ *   [uint64_t summary offset][uint32_t summary crc][uint32_t magic]
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianFileStream.h"
+#include "EndianMappedFile.h"
+#include "EndianChecksum.h"
+
+namespace mz {
+    namespace endian {
+
+        /// Magic number at both ends of a container file ("MZCF")
+        static constexpr uint32_t container_magic{ 0x46435A4DU };
+
+        /// Magic number at the start of every chunk frame ("MZCK")
+        static constexpr uint32_t container_chunk_magic{ 0x4B435A4DU };
+
+        /// Format version written by BasicContainerWriter
+        static constexpr uint32_t container_version{ 1 };
+
+        namespace detail {
+
+            static constexpr size_t container_header_size{ 8 };
+            static constexpr size_t container_chunk_header_size{ 48 };
+            static constexpr size_t container_message_header_size{ 12 };
+            static constexpr size_t container_index_entry_size{ 48 };
+            static constexpr size_t container_footer_size{ 16 };
+
+        } // namespace detail
+
+        /**
+         * @class BasicContainerWriter
+         * @brief Records messages of many channels into one chunked, indexed file
+         *
+         * @tparam Encoding Endianness of the file
+         */
+        template <std::endian Encoding>
+        class BasicContainerWriter {
+        public:
+            /**
+             * @brief Tuning parameters of the writer
+             */
+            struct Options {
+                size_t chunkSize{ size_t{ 1 } << 20 };     ///< Chunk payload size that triggers a flush
+                size_t blockSize{ size_t{ 8 } << 20 };     ///< Size of each write issued to the file
+            };
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs a closed writer
+              * @param options Tuning parameters
+              */
+            explicit BasicContainerWriter(Options options = Options{}) noexcept
+                : m_options{ options }, m_writer{ options.blockSize } {
+            }
+
+            BasicContainerWriter(const BasicContainerWriter&) = delete;
+            BasicContainerWriter& operator=(const BasicContainerWriter&) = delete;
+
+            /**
+             * @brief Destructor; finishes the file if still open
+             */
+            ~BasicContainerWriter() noexcept {
+                (void)close();
+            }
+            /** @} */
+
+            /**
+             * @name File Operations
+             * @{
+             */
+
+             /**
+              * @brief Creates a container file, discarding any previous channels
+              * @param path Path of the file
+              * @return true if the file cannot be created, false on success
+              */
+            [[nodiscard]] bool open(const std::string& path) noexcept {
+                (void)close();
+                m_channels.clear();
+                m_index.clear();
+                if (m_writer.open(path)) {
+                    return true; // Error (cannot create)
+                }
+                m_writer.pushBack(container_magic);
+                m_writer.pushBack(container_version);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Writes all pending chunks and the summary, then closes the file
+             * @return true if any write failed, false on success or if nothing is open
+             */
+            [[nodiscard]] bool close() noexcept {
+                if (!m_writer.isOpen()) {
+                    return false; // Success (nothing open)
+                }
+                for (uint32_t channel = 0; channel < m_channels.size(); ++channel) {
+                    flushChunk(channel);
+                }
+
+                BasicVector<Encoding> summary;
+                summary.pushBack(static_cast<uint32_t>(m_channels.size()));
+                for (const Channel& channel : m_channels) {
+                    summary.pushBack(channel.name);
+                }
+                summary.pushBack(static_cast<uint64_t>(m_index.size()));
+                for (const IndexEntry& entry : m_index) {
+                    summary.pushBack(entry.channel);
+                    summary.pushBack(entry.crc);
+                    summary.pushBack(entry.firstTime);
+                    summary.pushBack(entry.lastTime);
+                    summary.pushBack(entry.messages);
+                    summary.pushBack(entry.offset);
+                    summary.pushBack(entry.length);
+                }
+                const uint64_t summaryOffset = m_writer.position();
+                const std::span<const uint8_t> summaryBytes(summary.data(), summary.size());
+                m_writer.write(summaryBytes);
+                m_writer.pushBack(summaryOffset);
+                m_writer.pushBack(crc32c(summaryBytes));
+                m_writer.pushBack(container_magic);
+                return m_writer.close();
+            }
+            /** @} */
+
+            /**
+             * @name Channels and Messages
+             * @{
+             */
+
+             /**
+              * @brief Adds a channel
+              * @param name Unique name stored in the file
+              * @param channel Receives the channel id used by write()
+              * @return true if no file is open or the name is already used, false on success
+              */
+            [[nodiscard]] bool addChannel(const std::string& name, uint32_t& channel) noexcept {
+                if (!m_writer.isOpen() || m_channels.size() >= std::numeric_limits<uint32_t>::max()) {
+                    return true; // Error (closed or too many channels)
+                }
+                for (const Channel& existing : m_channels) {
+                    if (existing.name == name) {
+                        return true; // Error (duplicate name)
+                    }
+                }
+                channel = static_cast<uint32_t>(m_channels.size());
+                m_channels.emplace_back();
+                m_channels.back().name = name;
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Appends a message whose payload is written in place
+             * @tparam Fill Callable as void(BasicWriteBuffer<Encoding>&)
+             * @param channel Channel id from addChannel()
+             * @param timestamp Time of the message; must not be less than the channel's previous one
+             * @param payloadSize Exact number of bytes fill writes
+             * @param fill Writes the payload into a buffer of payloadSize bytes
+             * @return true if no file is open, the channel is unknown, the timestamp
+             *         goes backward or a write failed, false on success
+             */
+            template <typename Fill>
+            [[nodiscard]] bool write(uint32_t channel, uint64_t timestamp, size_t payloadSize, Fill&& fill) noexcept {
+                if (!m_writer.isOpen() || channel >= m_channels.size() || payloadSize > std::numeric_limits<uint32_t>::max()) {
+                    return true; // Error (closed, unknown channel or payload too large)
+                }
+                Channel& state = m_channels[channel];
+                if (timestamp < state.lastTime) {
+                    return true; // Error (timestamp goes backward)
+                }
+                if (state.messages == 0) {
+                    state.firstTime = timestamp;
+                }
+                state.lastTime = timestamp;
+                ++state.messages;
+
+                BasicVector<Encoding>& chunk = state.chunk;
+                chunk.pushBack(timestamp);
+                chunk.pushBack(static_cast<uint32_t>(payloadSize));
+                const size_t payloadOffset = chunk.size();
+                chunk.expandBy(payloadSize);
+                BasicWriteBuffer<Encoding> payload(chunk.data() + payloadOffset, payloadSize);
+                fill(payload);
+
+                if (chunk.size() >= m_options.chunkSize) {
+                    flushChunk(channel);
+                }
+                return m_writer.error();
+            }
+
+            /**
+             * @brief Appends a message with the given payload
+             * @param channel Channel id from addChannel()
+             * @param timestamp Time of the message; must not be less than the channel's previous one
+             * @param payload Payload bytes
+             * @return true if no file is open, the channel is unknown, the timestamp
+             *         goes backward or a write failed, false on success
+             */
+            [[nodiscard]] bool write(uint32_t channel, uint64_t timestamp, std::span<const uint8_t> payload) noexcept {
+                return write(channel, timestamp, payload.size(), [payload](BasicWriteBuffer<Encoding>& buffer) {
+                    if (!payload.empty()) {
+                        buffer.unsafePushBack(payload);
+                    }
+                });
+            }
+            /** @} */
+
+        private:
+            /**
+             * @brief A channel and its chunk under construction
+             */
+            struct Channel {
+                std::string name;
+                BasicVector<Encoding> chunk;
+                uint64_t firstTime{ 0 };   ///< First timestamp in the pending chunk
+                uint64_t lastTime{ 0 };    ///< Last timestamp ever written
+                uint64_t messages{ 0 };    ///< Messages in the pending chunk
+            };
+
+            /**
+             * @brief Summary record of a written chunk
+             */
+            struct IndexEntry {
+                uint32_t channel{ 0 };
+                uint32_t crc{ 0 };
+                uint64_t firstTime{ 0 };
+                uint64_t lastTime{ 0 };
+                uint64_t messages{ 0 };
+                uint64_t offset{ 0 };      ///< Offset of the chunk frame in the file
+                uint64_t length{ 0 };      ///< Length of the messages after the frame
+            };
+
+            Options m_options;                     ///< Tuning parameters
+            BasicFileWriter<Encoding> m_writer;    ///< Output file
+            std::vector<Channel> m_channels;       ///< Channels in id order
+            std::vector<IndexEntry> m_index;       ///< Written chunks in file order
+
+            void flushChunk(uint32_t channel) noexcept {
+                Channel& state = m_channels[channel];
+                if (state.messages == 0) {
+                    return;
+                }
+                const std::span<const uint8_t> messages(state.chunk.data(), state.chunk.size());
+                IndexEntry entry{ channel, crc32c(messages), state.firstTime, state.lastTime, state.messages,
+                                  m_writer.position(), messages.size() };
+                m_writer.pushBack(container_chunk_magic);
+                m_writer.pushBack(entry.channel);
+                m_writer.pushBack(entry.firstTime);
+                m_writer.pushBack(entry.lastTime);
+                m_writer.pushBack(entry.messages);
+                m_writer.pushBack(entry.length);
+                m_writer.pushBack(entry.crc);
+                m_writer.pushBack(uint32_t{ 0 });
+                m_writer.write(messages);
+                m_index.push_back(entry);
+                state.chunk.clear();
+                state.messages = 0;
+            }
+        };
+
+        /**
+         * @class BasicContainerReader
+         * @brief Replays channels of a container file over a time window
+         *
+         * The file is memory-mapped; payloads handed to visitors point into the
+         * mapping and stay valid until close() or destruction. Chunks are
+         * verified against their CRC when a replay first reaches them.
+         *
+         * @tparam Encoding Endianness of the file
+         */
+        template <std::endian Encoding>
+        class BasicContainerReader {
+        public:
+            /// Lowest timestamp, for replays without a lower bound
+            static constexpr uint64_t min_time{ 0 };
+
+            /// Highest timestamp, for replays without an upper bound
+            static constexpr uint64_t max_time{ std::numeric_limits<uint64_t>::max() };
+
+            /**
+             * @name File Operations
+             * @{
+             */
+
+             /**
+              * @brief Opens a container file and loads its summary
+              * @param path Path of the file
+              * @return true if the file cannot be mapped, is not a container or its summary is damaged, false on success
+              */
+            [[nodiscard]] bool open(const std::string& path) noexcept {
+                close();
+                if (m_file.open(path) || m_file.size() < detail::container_header_size + detail::container_footer_size) {
+                    close();
+                    return true; // Error (cannot map or too small)
+                }
+                if (loadSummary()) {
+                    close();
+                    return true; // Error (not a container or damaged summary)
+                }
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Unmaps the file and forgets its summary
+             */
+            void close() noexcept {
+                m_file.close();
+                m_names.clear();
+                m_chunks.clear();
+            }
+            /** @} */
+
+            /**
+             * @name Channels
+             * @{
+             */
+
+             /**
+              * @brief Gets the number of channels
+              * @return Channel count
+              */
+            [[nodiscard]] size_t channelCount() const noexcept { return m_names.size(); }
+
+            /**
+             * @brief Gets the name of a channel
+             * @param channel Channel id
+             * @return Name given to addChannel()
+             */
+            [[nodiscard]] const std::string& channelName(uint32_t channel) const noexcept { return m_names[channel]; }
+
+            /**
+             * @brief Looks up a channel by name
+             * @param name Channel name
+             * @param channel Receives the channel id
+             * @return true if no channel has that name, false on success
+             */
+            [[nodiscard]] bool findChannel(const std::string& name, uint32_t& channel) const noexcept {
+                for (size_t c = 0; c < m_names.size(); ++c) {
+                    if (m_names[c] == name) {
+                        channel = static_cast<uint32_t>(c);
+                        return false; // Success (no error)
+                    }
+                }
+                return true; // Error (unknown channel)
+            }
+
+            /**
+             * @brief Counts the messages of a channel
+             * @param channel Channel id
+             * @return Number of messages, from the summary
+             */
+            [[nodiscard]] uint64_t messageCount(uint32_t channel) const noexcept {
+                uint64_t count = 0;
+                for (const Chunk& chunk : m_chunks[channel]) {
+                    count += chunk.messages;
+                }
+                return count;
+            }
+            /** @} */
+
+            /**
+             * @name Replay
+             * @{
+             */
+
+             /**
+              * @brief Visits the messages of one channel within a time window, in write order
+              * @tparam Visitor Callable as bool(uint32_t channel, uint64_t timestamp, BasicReadBuffer<Encoding>& payload);
+              *         return false to stop
+              * @param channel Channel id
+              * @param from First timestamp to visit
+              * @param to Last timestamp to visit
+              * @param visitor Callback
+              * @return true if the channel is unknown or a visited chunk is damaged, false on success
+              */
+            template <typename Visitor>
+            [[nodiscard]] bool replay(uint32_t channel, uint64_t from, uint64_t to, Visitor&& visitor) const noexcept {
+                if (channel >= m_chunks.size()) {
+                    return true; // Error (unknown channel)
+                }
+                return replay(std::span<const uint32_t>(&channel, 1), from, to, visitor);
+            }
+
+            /**
+             * @brief Visits the messages of several channels within a time window, merged by timestamp
+             * @tparam Visitor Callable as bool(uint32_t channel, uint64_t timestamp, BasicReadBuffer<Encoding>& payload);
+             *         return false to stop
+             * @param channels Channel ids; equal timestamps are visited in the order of this list
+             * @param from First timestamp to visit
+             * @param to Last timestamp to visit
+             * @param visitor Callback
+             * @return true if a channel is unknown or a visited chunk is damaged, false on success
+             */
+            template <typename Visitor>
+            [[nodiscard]] bool replay(std::span<const uint32_t> channels, uint64_t from, uint64_t to, Visitor&& visitor) const noexcept {
+                std::vector<Cursor> cursors(channels.size());
+                std::vector<size_t> heap;
+                heap.reserve(channels.size());
+                // Min-heap on (timestamp, position in the list)
+                auto later = [&cursors](size_t a, size_t b) {
+                    return cursors[a].timestamp != cursors[b].timestamp ? cursors[a].timestamp > cursors[b].timestamp : a > b;
+                };
+                for (size_t c = 0; c < channels.size(); ++c) {
+                    if (channels[c] >= m_chunks.size()) {
+                        return true; // Error (unknown channel)
+                    }
+                    Cursor& cursor = cursors[c];
+                    cursor.channel = channels[c];
+                    const std::vector<Chunk>& chunks = m_chunks[cursor.channel];
+                    cursor.chunk = static_cast<size_t>(std::partition_point(chunks.begin(), chunks.end(),
+                        [from](const Chunk& chunk) { return chunk.lastTime < from; }) - chunks.begin());
+                    bool found = false;
+                    if (nextMessage(cursor, from, to, found)) {
+                        return true; // Error (damaged chunk)
+                    }
+                    if (found) {
+                        heap.push_back(c);
+                    }
+                }
+                std::make_heap(heap.begin(), heap.end(), later);
+                while (!heap.empty()) {
+                    std::pop_heap(heap.begin(), heap.end(), later);
+                    Cursor& cursor = cursors[heap.back()];
+                    BasicReadBuffer<Encoding> payload(cursor.payload, cursor.payloadSize);
+                    if (!visitor(cursor.channel, cursor.timestamp, payload)) {
+                        return false; // Success (stopped by the visitor)
+                    }
+                    bool found = false;
+                    if (nextMessage(cursor, from, to, found)) {
+                        return true; // Error (damaged chunk)
+                    }
+                    if (found) {
+                        std::push_heap(heap.begin(), heap.end(), later);
+                    }
+                    else {
+                        heap.pop_back();
+                    }
+                }
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Visits the messages of all channels within a time window, merged by timestamp
+             * @tparam Visitor Callable as bool(uint32_t channel, uint64_t timestamp, BasicReadBuffer<Encoding>& payload);
+             *         return false to stop
+             * @param from First timestamp to visit
+             * @param to Last timestamp to visit
+             * @param visitor Callback
+             * @return true if a visited chunk is damaged, false on success
+             */
+            template <typename Visitor>
+            [[nodiscard]] bool replay(uint64_t from, uint64_t to, Visitor&& visitor) const noexcept {
+                std::vector<uint32_t> channels(m_names.size());
+                for (size_t c = 0; c < channels.size(); ++c) {
+                    channels[c] = static_cast<uint32_t>(c);
+                }
+                return replay(std::span<const uint32_t>(channels), from, to, visitor);
+            }
+            /** @} */
+
+        private:
+            /**
+             * @brief Summary record of a chunk
+             */
+            struct Chunk {
+                uint32_t crc{ 0 };
+                uint64_t firstTime{ 0 };
+                uint64_t lastTime{ 0 };
+                uint64_t messages{ 0 };
+                uint64_t offset{ 0 };      ///< Offset of the chunk frame in the file
+                uint64_t length{ 0 };      ///< Length of the messages after the frame
+            };
+
+            /**
+             * @brief Replay position within one channel
+             */
+            struct Cursor {
+                uint32_t channel{ 0 };
+                size_t chunk{ 0 };                     ///< Next chunk to load
+                const uint8_t* next{ nullptr };        ///< Next message in the loaded chunk
+                const uint8_t* end{ nullptr };         ///< End of the loaded chunk
+                uint64_t timestamp{ 0 };               ///< Current message
+                const uint8_t* payload{ nullptr };
+                size_t payloadSize{ 0 };
+            };
+
+            MappedFile m_file;                         ///< Mapped container file
+            std::vector<std::string> m_names;          ///< Channel names in id order
+            std::vector<std::vector<Chunk>> m_chunks;  ///< Chunks of each channel in time order
+
+            [[nodiscard]] bool loadSummary() noexcept {
+                const uint8_t* file = m_file.data();
+                const size_t fileSize = m_file.size();
+                uint32_t magic = 0;
+                uint32_t version = 0;
+                basicCopy<Encoding>(magic, file);
+                basicCopy<Encoding>(version, file + 4);
+                if (magic != container_magic || version != container_version) {
+                    return true; // Error (not a container file)
+                }
+                BasicReadBuffer<Encoding> footer(file + fileSize - detail::container_footer_size, detail::container_footer_size);
+                uint64_t summaryOffset = 0;
+                uint32_t summaryCrc = 0;
+                footer.unsafePopFront(summaryOffset);
+                footer.unsafePopFront(summaryCrc);
+                footer.unsafePopFront(magic);
+                if (magic != container_magic || summaryOffset < detail::container_header_size
+                    || summaryOffset > fileSize - detail::container_footer_size) {
+                    return true; // Error (missing footer; the writer was not closed)
+                }
+                const std::span<const uint8_t> summaryBytes(file + summaryOffset, static_cast<size_t>(fileSize - detail::container_footer_size - summaryOffset));
+                if (crc32c(summaryBytes) != summaryCrc) {
+                    return true; // Error (damaged summary)
+                }
+
+                BasicReadBuffer<Encoding> summary(summaryBytes.data(), summaryBytes.size());
+                uint32_t channelCount = 0;
+                if (summary.popFront(channelCount) || channelCount > summary.size() / 8) {
+                    return true; // Error (truncated channel list)
+                }
+                m_names.resize(channelCount);
+                m_chunks.resize(channelCount);
+                for (std::string& name : m_names) {
+                    if (summary.popFront(name)) {
+                        return true; // Error (truncated channel list)
+                    }
+                }
+                uint64_t chunkCount = 0;
+                if (summary.popFront(chunkCount) || summary.size() % detail::container_index_entry_size != 0
+                    || summary.size() / detail::container_index_entry_size != chunkCount) {
+                    return true; // Error (truncated chunk list)
+                }
+                for (uint64_t i = 0; i < chunkCount; ++i) {
+                    uint32_t channel = 0;
+                    Chunk chunk;
+                    summary.unsafePopFront(channel);
+                    summary.unsafePopFront(chunk.crc);
+                    summary.unsafePopFront(chunk.firstTime);
+                    summary.unsafePopFront(chunk.lastTime);
+                    summary.unsafePopFront(chunk.messages);
+                    summary.unsafePopFront(chunk.offset);
+                    summary.unsafePopFront(chunk.length);
+                    if (channel >= channelCount || chunk.firstTime > chunk.lastTime
+                        || chunk.offset < detail::container_header_size || chunk.offset > summaryOffset
+                        || summaryOffset - chunk.offset < detail::container_chunk_header_size
+                        || chunk.length > summaryOffset - chunk.offset - detail::container_chunk_header_size
+                        || (!m_chunks[channel].empty() && m_chunks[channel].back().lastTime > chunk.firstTime)) {
+                        return true; // Error (bad chunk entry)
+                    }
+                    m_chunks[channel].push_back(chunk);
+                }
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Checks a chunk's frame against the summary and its messages against the CRC
+             * @return true if the chunk is damaged
+             */
+            [[nodiscard]] bool verifyChunk(uint32_t channel, const Chunk& chunk) const noexcept {
+                BasicReadBuffer<Encoding> frame(m_file.data() + chunk.offset, detail::container_chunk_header_size);
+                uint32_t magic = 0;
+                uint32_t storedChannel = 0;
+                uint64_t firstTime = 0;
+                uint64_t lastTime = 0;
+                uint64_t messages = 0;
+                uint64_t length = 0;
+                uint32_t crc = 0;
+                frame.unsafePopFront(magic);
+                frame.unsafePopFront(storedChannel);
+                frame.unsafePopFront(firstTime);
+                frame.unsafePopFront(lastTime);
+                frame.unsafePopFront(messages);
+                frame.unsafePopFront(length);
+                frame.unsafePopFront(crc);
+                if (magic != container_chunk_magic || storedChannel != channel || firstTime != chunk.firstTime
+                    || lastTime != chunk.lastTime || messages != chunk.messages || length != chunk.length || crc != chunk.crc) {
+                    return true; // Error (frame does not match the summary)
+                }
+                const uint8_t* data = m_file.data() + chunk.offset + detail::container_chunk_header_size;
+                return crc32c(std::span<const uint8_t>(data, static_cast<size_t>(chunk.length))) != chunk.crc;
+            }
+
+            /**
+             * @brief Moves a cursor to its next message within [from, to]
+             * @param found Set to whether a message was found
+             * @return true if a chunk is damaged
+             */
+            [[nodiscard]] bool nextMessage(Cursor& cursor, uint64_t from, uint64_t to, bool& found) const noexcept {
+                const std::vector<Chunk>& chunks = m_chunks[cursor.channel];
+                found = false;
+                while (true) {
+                    if (cursor.next == cursor.end) {
+                        if (cursor.chunk >= chunks.size() || chunks[cursor.chunk].firstTime > to) {
+                            return false; // Success (channel exhausted)
+                        }
+                        const Chunk& chunk = chunks[cursor.chunk++];
+                        if (verifyChunk(cursor.channel, chunk)) {
+                            return true; // Error (damaged chunk)
+                        }
+                        cursor.next = m_file.data() + chunk.offset + detail::container_chunk_header_size;
+                        cursor.end = cursor.next + chunk.length;
+                        continue;
+                    }
+                    if (static_cast<size_t>(cursor.end - cursor.next) < detail::container_message_header_size) {
+                        return true; // Error (truncated message header)
+                    }
+                    uint64_t timestamp = 0;
+                    uint32_t size = 0;
+                    basicCopy<Encoding>(timestamp, cursor.next);
+                    basicCopy<Encoding>(size, cursor.next + 8);
+                    const uint8_t* payload = cursor.next + detail::container_message_header_size;
+                    if (size > static_cast<size_t>(cursor.end - payload)) {
+                        return true; // Error (truncated message)
+                    }
+                    cursor.next = payload + size;
+                    if (timestamp > to) {
+                        cursor.next = cursor.end;
+                        cursor.chunk = chunks.size();
+                        return false; // Success (past the window)
+                    }
+                    if (timestamp >= from) {
+                        cursor.timestamp = timestamp;
+                        cursor.payload = payload;
+                        cursor.payloadSize = size;
+                        found = true;
+                        return false; // Success (no error)
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief Container writer that uses the default stream endianness
+         */
+        using ContainerWriter = BasicContainerWriter<stream_endian>;
+
+        /**
+         * @brief Container reader that uses the default stream endianness
+         */
+        using ContainerReader = BasicContainerReader<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_CONTAINER_FILE_HEADER_FILE
@@ -0,0 +1,468 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_DELTA_HEADER_FILE
+#define MZ_ENDIAN_DELTA_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianDelta.h
+ * @brief Binary delta (copy/insert patch) between two serialized buffers
+ *
+ * This header provides a small binary diff engine for serialized blobs. It
+ * computes a compact patch that rebuilds a target buffer from a base buffer
+ * using copy operations (byte ranges taken from the base) and insert
+ * operations (literal bytes carried in the patch), and applies such a patch
+ * into a pre-sized write buffer.
+ *
+ * Matches are found by indexing the base in fixed-size blocks with a rolling
+ * hash and sliding that hash over the target. Every candidate match is
+ * verified and then extended in both directions, using 16-byte SIMD compares
+ * where SSE2 is available and 8-byte word compares elsewhere.
+ *
+ * Patch layout (all integers in the buffer's Encoding):
+ * - Header: [uint32_t magic][uint64_t baseSize][uint64_t targetSize]
+ * - Copy:   [uint8_t 1][uint64_t baseOffset][uint64_t length]
+ * - Insert: [uint8_t 2][uint64_t length][length literal bytes]
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <span>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define MZ_ENDIAN_DELTA_SSE2 1
+#endif
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Operation codes used in a delta patch
+         */
+        enum class DeltaOp : uint8_t {
+            none = 0,   ///< Not a valid operation
+            copy = 1,   ///< Copy a byte range from the base buffer
+            insert = 2, ///< Insert literal bytes carried in the patch
+            invalid = 3 ///< Upper bound for validation
+        };
+
+        /**
+         * @name Delta Constants
+         * @{
+         */
+
+         /// Magic number at the start of every patch ("MZDL")
+        static constexpr uint32_t delta_magic{ 0x4C445A4DU };
+
+        /// Size of the header written at the start of every patch
+        static constexpr size_t delta_header_size{ 4 + 8 + 8 };
+
+        /// Block size used for indexing the base buffer and the minimum match length
+        static constexpr size_t delta_block_size{ 32 };
+        /** @} */
+
+        namespace detail {
+
+            /// Multiplier of the polynomial rolling hash (mod 2^32)
+            static constexpr uint32_t delta_hash_multiplier{ 0x01000193U };
+
+            /**
+             * @brief Computes the polynomial hash of one block
+             * @param bytes Pointer to delta_block_size bytes
+             * @return Hash of the block
+             */
+            [[nodiscard]] inline uint32_t deltaBlockHash(const uint8_t* bytes) noexcept {
+                uint32_t hash = 0;
+                for (size_t i = 0; i < delta_block_size; ++i) {
+                    hash = hash * delta_hash_multiplier + bytes[i];
+                }
+                return hash;
+            }
+
+            /**
+             * @brief Computes multiplier^(delta_block_size - 1), used to roll the oldest byte out
+             * @return The power of the multiplier
+             */
+            [[nodiscard]] constexpr uint32_t deltaOutFactor() noexcept {
+                uint32_t factor = 1;
+                for (size_t i = 1; i < delta_block_size; ++i) {
+                    factor *= delta_hash_multiplier;
+                }
+                return factor;
+            }
+
+            /**
+             * @brief Counts how many leading bytes two ranges have in common
+             * @param lhs First range
+             * @param rhs Second range
+             * @param limit Maximum number of bytes to compare
+             * @return Length of the common prefix
+             *
+             * Compares 16 bytes at a time with SSE2 when available, then 8 bytes
+             * at a time, and locates the first mismatch inside a word with a
+             * bit scan rather than a byte loop.
+             */
+            [[nodiscard]] inline size_t deltaMatchForward(const uint8_t* lhs, const uint8_t* rhs, size_t limit) noexcept {
+                size_t length = 0;
+#if defined(MZ_ENDIAN_DELTA_SSE2)
+                while (length + 16 <= limit) {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + length));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + length));
+                    const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) ^ 0xFFFFU;
+                    if (mask) {
+                        return length + static_cast<size_t>(std::countr_zero(mask));
+                    }
+                    length += 16;
+                }
+#endif
+                while (length + 8 <= limit) {
+                    uint64_t a = 0;
+                    uint64_t b = 0;
+                    std::memcpy(&a, lhs + length, 8);
+                    std::memcpy(&b, rhs + length, 8);
+                    if (const uint64_t diff = a ^ b; diff) {
+                        if constexpr (native_endian == std::endian::little) {
+                            return length + static_cast<size_t>(std::countr_zero(diff) / 8);
+                        }
+                        else {
+                            return length + static_cast<size_t>(std::countl_zero(diff) / 8);
+                        }
+                    }
+                    length += 8;
+                }
+                while (length < limit && lhs[length] == rhs[length]) {
+                    ++length;
+                }
+                return length;
+            }
+
+            /**
+             * @brief Counts how many trailing bytes two ranges have in common
+             * @param lhsEnd One-past-the-end of the first range
+             * @param rhsEnd One-past-the-end of the second range
+             * @param limit Maximum number of bytes to compare
+             * @return Length of the common suffix
+             */
+            [[nodiscard]] inline size_t deltaMatchBackward(const uint8_t* lhsEnd, const uint8_t* rhsEnd, size_t limit) noexcept {
+                size_t length = 0;
+                while (length + 8 <= limit) {
+                    uint64_t a = 0;
+                    uint64_t b = 0;
+                    std::memcpy(&a, lhsEnd - length - 8, 8);
+                    std::memcpy(&b, rhsEnd - length - 8, 8);
+                    if (const uint64_t diff = a ^ b; diff) {
+                        if constexpr (native_endian == std::endian::little) {
+                            return length + static_cast<size_t>(std::countl_zero(diff) / 8);
+                        }
+                        else {
+                            return length + static_cast<size_t>(std::countr_zero(diff) / 8);
+                        }
+                    }
+                    length += 8;
+                }
+                while (length < limit && lhsEnd[-1 - static_cast<ptrdiff_t>(length)] == rhsEnd[-1 - static_cast<ptrdiff_t>(length)]) {
+                    ++length;
+                }
+                return length;
+            }
+
+            /**
+             * @brief Appends an insert operation with its literal bytes
+             */
+            template <std::endian Encoding>
+            inline void deltaEmitInsert(BasicVector<Encoding>& patch, const uint8_t* bytes, size_t length) noexcept {
+                if (length == 0) {
+                    return;
+                }
+                patch.pushBack(DeltaOp::insert);
+                patch.pushBack(static_cast<uint64_t>(length));
+                patch.pushBack(std::span<const uint8_t>(bytes, length));
+            }
+
+            /**
+             * @brief Appends a copy operation
+             */
+            template <std::endian Encoding>
+            inline void deltaEmitCopy(BasicVector<Encoding>& patch, size_t offset, size_t length) noexcept {
+                patch.pushBack(DeltaOp::copy);
+                patch.pushBack(static_cast<uint64_t>(offset));
+                patch.pushBack(static_cast<uint64_t>(length));
+            }
+
+        } // namespace detail
+
+        /**
+         * @brief Computes a patch that rebuilds a target buffer from a base buffer
+         * @tparam Encoding Endianness of the integers written into the patch
+         * @param base Bytes the receiver already has
+         * @param target Bytes the receiver should end up with
+         * @param patch Vector the patch is appended to
+         *
+         * The base is indexed in delta_block_size blocks; the target is scanned
+         * byte by byte with a rolling hash. Regions of the target that are not
+         * found in the base are emitted as literal inserts. The cost is linear
+         * in the size of both buffers, plus one hash table entry per base block.
+         */
+        template <std::endian Encoding>
+        inline void computeDelta(std::span<const uint8_t> base, std::span<const uint8_t> target, BasicVector<Encoding>& patch) noexcept {
+            using namespace detail;
+
+            patch.pushBack(delta_magic);
+            patch.pushBack(static_cast<uint64_t>(base.size()));
+            patch.pushBack(static_cast<uint64_t>(target.size()));
+
+            if (base.size() < delta_block_size || target.size() < delta_block_size) {
+                deltaEmitInsert(patch, target.data(), target.size());
+                return;
+            }
+
+            // Index the base: one slot per block-aligned offset, first block wins on collision
+            const size_t blockCount = base.size() / delta_block_size;
+            const size_t tableSize = std::bit_ceil(blockCount * 2);
+            const size_t tableMask = tableSize - 1;
+            std::vector<uint64_t> table(tableSize, 0); // offset + 1, zero means empty
+            for (size_t block = 0; block < blockCount; ++block) {
+                const size_t offset = block * delta_block_size;
+                auto& slot = table[deltaBlockHash(base.data() + offset) & tableMask];
+                if (slot == 0) {
+                    slot = offset + 1;
+                }
+            }
+
+            constexpr uint32_t outFactor = deltaOutFactor();
+            const uint8_t* const source = base.data();
+            const uint8_t* const bytes = target.data();
+            const size_t targetSize = target.size();
+
+            size_t literalStart = 0;
+            size_t position = 0;
+            uint32_t hash = deltaBlockHash(bytes);
+
+            while (position + delta_block_size <= targetSize) {
+                const uint64_t slot = table[hash & tableMask];
+                if (slot != 0) {
+                    size_t offset = static_cast<size_t>(slot - 1);
+                    size_t length = deltaMatchForward(source + offset, bytes + position,
+                        std::min(base.size() - offset, targetSize - position));
+
+                    if (length >= delta_block_size) {
+                        // Grow the match backward into the pending literal run
+                        const size_t back = deltaMatchBackward(source + offset, bytes + position,
+                            std::min(offset, position - literalStart));
+                        offset -= back;
+                        position -= back;
+                        length += back;
+
+                        deltaEmitInsert(patch, bytes + literalStart, position - literalStart);
+                        deltaEmitCopy(patch, offset, length);
+
+                        position += length;
+                        literalStart = position;
+                        if (position + delta_block_size <= targetSize) {
+                            hash = deltaBlockHash(bytes + position);
+                        }
+                        continue;
+                    }
+                }
+
+                // Roll the hash one byte forward
+                if (position + delta_block_size < targetSize) {
+                    hash = (hash - outFactor * bytes[position]) * delta_hash_multiplier + bytes[position + delta_block_size];
+                }
+                ++position;
+            }
+
+            deltaEmitInsert(patch, bytes + literalStart, targetSize - literalStart);
+        }
+
+        /**
+         * @brief Computes a patch between two vectors
+         * @tparam Encoding Endianness of the vectors and of the patch
+         * @param base Vector the receiver already has
+         * @param target Vector the receiver should end up with
+         * @return A new vector holding the patch
+         */
+        template <std::endian Encoding>
+        [[nodiscard]] inline BasicVector<Encoding> computeDelta(const BasicVector<Encoding>& base, const BasicVector<Encoding>& target) noexcept {
+            BasicVector<Encoding> patch;
+            computeDelta(std::span<const uint8_t>(base.data(), base.size()),
+                std::span<const uint8_t>(target.data(), target.size()), patch);
+            return patch;
+        }
+
+        /**
+         * @brief Reads the header of a patch
+         * @tparam Encoding Endianness of the patch
+         * @param patch Read buffer positioned at the start of the patch
+         * @param baseSize Receives the size of the base the patch was computed against
+         * @param targetSize Receives the size of the buffer the patch produces
+         * @return true if the header is missing or malformed, false on success
+         */
+        template <std::endian Encoding>
+        [[nodiscard]] inline bool readDeltaHeader(BasicReadBuffer<Encoding> patch, uint64_t& baseSize, uint64_t& targetSize) noexcept {
+            uint32_t magic = 0;
+            if (patch.popFront(magic) || magic != delta_magic) {
+                return true; // Error (not a patch)
+            }
+            return patch.popFront(baseSize) || patch.popFront(targetSize);
+        }
+
+        /**
+         * @brief Applies a patch into a pre-sized write buffer
+         * @tparam Encoding Endianness of the patch
+         * @param base Bytes the patch was computed against
+         * @param patch Read buffer holding the whole patch
+         * @param output Write buffer with at least targetSize bytes of room; advanced past the output
+         * @return true if the patch is malformed, does not match the base, or does not fit, false on success
+         *
+         * Every operation is bounds-checked against the base, the patch and the
+         * output before any bytes are copied, so a corrupt patch cannot read or
+         * write outside the supplied ranges.
+         */
+        template <std::endian Encoding>
+        [[nodiscard]] inline bool applyDelta(std::span<const uint8_t> base, BasicReadBuffer<Encoding> patch, BasicWriteBuffer<Encoding>& output) noexcept {
+            uint64_t baseSize = 0;
+            uint64_t targetSize = 0;
+            if (readDeltaHeader(patch, baseSize, targetSize)) {
+                return true; // Error (bad header)
+            }
+            patch.skipFront(delta_header_size);
+
+            if (baseSize != base.size() || targetSize > output.size()) {
+                return true; // Error (wrong base or output too small)
+            }
+
+            uint64_t written = 0;
+            while (!patch.empty()) {
+                DeltaOp op{ DeltaOp::none };
+                uint64_t length = 0;
+                if (patch.popFront(op)) {
+                    return true; // Error (truncated)
+                }
+
+                if (op == DeltaOp::copy) {
+                    uint64_t offset = 0;
+                    if (patch.popFront(offset) || patch.popFront(length)
+                        || offset > baseSize || length > baseSize - offset
+                        || length > targetSize - written) {
+                        return true; // Error (copy out of range)
+                    }
+                    std::memcpy(output.data(), base.data() + offset, static_cast<size_t>(length));
+                }
+                else if (op == DeltaOp::insert) {
+                    if (patch.popFront(length) || length > patch.size()
+                        || length > targetSize - written) {
+                        return true; // Error (insert out of range)
+                    }
+                    std::memcpy(output.data(), patch.data(), static_cast<size_t>(length));
+                    patch.skipFront(static_cast<size_t>(length));
+                }
+                else {
+                    return true; // Error (unknown operation)
+                }
+
+                output.skip(static_cast<size_t>(length));
+                written += length;
+            }
+
+            return written != targetSize;
+        }
+
+        /**
+         * @brief Applies a patch and stores the result in a vector
+         * @tparam Encoding Endianness of the vectors and of the patch
+         * @param base Vector the patch was computed against
+         * @param patch Vector holding the patch
+         * @param output Vector that receives the rebuilt target (resized to fit)
+         * @return true if the patch could not be applied, false on success
+         */
+        template <std::endian Encoding>
+        [[nodiscard]] inline bool applyDelta(const BasicVector<Encoding>& base, const BasicVector<Encoding>& patch, BasicVector<Encoding>& output) noexcept {
+            const BasicReadBuffer<Encoding> reader{ patch.data(), patch.size() };
+            uint64_t baseSize = 0;
+            uint64_t targetSize = 0;
+            if (readDeltaHeader(reader, baseSize, targetSize) || baseSize != base.size()) {
+                return true; // Error (bad header or wrong base)
+            }
+
+            // Add up what the operations produce before allocating, so a corrupt
+            // targetSize cannot request more memory than the patch can fill
+            BasicReadBuffer<Encoding> scan = reader;
+            scan.skipFront(delta_header_size);
+            uint64_t produced = 0;
+            while (!scan.empty()) {
+                DeltaOp op{ DeltaOp::none };
+                uint64_t offset = 0;
+                uint64_t length = 0;
+                if (scan.popFront(op)) {
+                    return true; // Error (truncated)
+                }
+                if (op == DeltaOp::copy) {
+                    if (scan.popFront(offset) || scan.popFront(length) || offset > baseSize || length > baseSize - offset) {
+                        return true; // Error (copy out of range)
+                    }
+                }
+                else if (op == DeltaOp::insert) {
+                    if (scan.popFront(length) || length > scan.size()) {
+                        return true; // Error (insert out of range)
+                    }
+                    scan.skipFront(static_cast<size_t>(length));
+                }
+                else {
+                    return true; // Error (unknown operation)
+                }
+                if (length > targetSize - produced) {
+                    return true; // Error (operations exceed targetSize)
+                }
+                produced += length;
+            }
+            if (produced != targetSize) {
+                return true; // Error (operations do not produce targetSize bytes)
+            }
+
+            output.resize(static_cast<size_t>(targetSize));
+            BasicWriteBuffer<Encoding> writer{ output.data(), output.size() };
+            if (applyDelta(std::span<const uint8_t>(base.data(), base.size()), reader, writer)) {
+                output.clear();
+                return true; // Error
+            }
+            return false; // Success (no error)
+        }
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_DELTA_SSE2
+
+#endif // MZ_ENDIAN_DELTA_HEADER_FILE
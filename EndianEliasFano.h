@@ -0,0 +1,436 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_ELIAS_FANO_HEADER_FILE
+#define MZ_ENDIAN_ELIAS_FANO_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianEliasFano.h
+ * @brief Elias-Fano encoding of monotone integer sequences
+ *
+ * This header provides encodeEliasFano, which writes a non-decreasing
+ * sequence through a BasicVector, and BasicEliasFanoView, which reads it in
+ * place with O(1) random access (access) and successor search (nextGEQ).
+ *
+ * Each value is split into l = floor(log2(U / n)) low bits, stored verbatim
+ * in a packed array, and a high part, stored in unary in an upper bit array
+ * (value i sets bit high(i) + i). The encoding takes about 2 + l bits per
+ * element. Select samples every 256 ones and every 256 zeros locate a bit
+ * with one sample read and a short word scan; the final in-word select uses
+ * PDEP under BMI2 and broadword arithmetic otherwise.
+ *
+ * Serialized layout (all integers in Encoding):
+ *   [uint32_t magic][uint32_t lowBits][uint64_t count][uint64_t last]
+ *   [uint64_t lowerWords][uint64_t upperWords][uint64_t ones samples]
+ *   [uint64_t zeros samples][8 bytes zero]
+ *   [lower words][upper words][ones samples][zeros samples]   (uint64_t each)
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <concepts>
+#include <vector>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianBitOps.h"
+
+namespace mz {
+    namespace endian {
+
+        /// Magic number at the start of a serialized Elias-Fano sequence ("MZEF")
+        static constexpr uint32_t elias_fano_magic{ 0x46455A4DU };
+
+        namespace detail {
+
+            static constexpr size_t elias_fano_header_size{ 64 };
+            static constexpr size_t elias_fano_sample_rate{ 256 };   ///< Ones (or zeros) per select sample
+
+        } // namespace detail
+
+        /**
+         * @brief Encodes a non-decreasing sequence with Elias-Fano
+         * @tparam Encoding Endianness of the serialized integers
+         * @tparam T Unsigned integer element type
+         * @param values Non-decreasing values
+         * @param vector Vector to append the encoding to
+         * @return true if the values are not non-decreasing, false on success
+         */
+        template <std::endian Encoding, std::unsigned_integral T>
+        [[nodiscard]] bool encodeEliasFano(std::span<const T> values, BasicVector<Encoding>& vector) noexcept {
+            const uint64_t count = values.size();
+            for (size_t i = 1; i < values.size(); ++i) {
+                if (values[i] < values[i - 1]) {
+                    return true; // Error (not monotone)
+                }
+            }
+            const uint64_t last = count ? static_cast<uint64_t>(values.back()) : 0;
+            unsigned lowBits = 0;
+            if (count && last / count > 0) {
+                lowBits = static_cast<unsigned>(std::bit_width(last / count)) - 1;
+            }
+            const uint64_t lowMask = lowBits ? (~uint64_t{ 0 } >> (64 - lowBits)) : 0;
+
+            // One spare lower word so a straddling read never runs off the end
+            const uint64_t lowerWords = (count * lowBits + 63) / 64 + 1;
+            const uint64_t upperBits = count + (last >> lowBits) + 1;
+            const uint64_t upperWords = (upperBits + 63) / 64;
+            std::vector<uint64_t> lower(static_cast<size_t>(lowerWords), 0);
+            std::vector<uint64_t> upper(static_cast<size_t>(upperWords), 0);
+            std::vector<uint64_t> onesSamples;
+            std::vector<uint64_t> zerosSamples;
+
+            for (uint64_t i = 0; i < count; ++i) {
+                const uint64_t value = static_cast<uint64_t>(values[static_cast<size_t>(i)]);
+                if (lowBits) {
+                    const uint64_t position = i * lowBits;
+                    const uint64_t low = value & lowMask;
+                    lower[position / 64] |= low << (position % 64);
+                    if (position % 64 + lowBits > 64) {
+                        lower[position / 64 + 1] |= low >> (64 - position % 64);
+                    }
+                }
+                const uint64_t position = (value >> lowBits) + i;
+                upper[position / 64] |= uint64_t{ 1 } << (position % 64);
+                if (i % detail::elias_fano_sample_rate == 0) {
+                    onesSamples.push_back(position);
+                }
+            }
+            uint64_t zeros = 0;
+            uint64_t nextSample = 0;
+            for (size_t w = 0; w < upper.size(); ++w) {
+                uint64_t inverted = ~upper[w];
+                if (const uint64_t tail = upperBits - w * 64; tail < 64) {
+                    inverted &= ~uint64_t{ 0 } >> (64 - tail);
+                }
+                const uint64_t available = static_cast<uint64_t>(std::popcount(inverted));
+                for (; nextSample < zeros + available; nextSample += detail::elias_fano_sample_rate) {
+                    zerosSamples.push_back(w * 64 + select64(inverted, static_cast<unsigned>(nextSample - zeros)));
+                }
+                zeros += available;
+            }
+
+            const size_t start = vector.size();
+            vector.expandBy(detail::elias_fano_header_size);
+            uint8_t* header = vector.data() + start;
+            std::memset(header, 0, detail::elias_fano_header_size);
+            basicCopy<Encoding>(header, elias_fano_magic);
+            basicCopy<Encoding>(header + 4, static_cast<uint32_t>(lowBits));
+            basicCopy<Encoding>(header + 8, count);
+            basicCopy<Encoding>(header + 16, last);
+            basicCopy<Encoding>(header + 24, lowerWords);
+            basicCopy<Encoding>(header + 32, upperWords);
+            basicCopy<Encoding>(header + 40, static_cast<uint64_t>(onesSamples.size()));
+            basicCopy<Encoding>(header + 48, static_cast<uint64_t>(zerosSamples.size()));
+            vector.pushBack(std::span<const uint64_t>(lower));
+            vector.pushBack(std::span<const uint64_t>(upper));
+            if (!onesSamples.empty()) {
+                vector.pushBack(std::span<const uint64_t>(onesSamples));
+            }
+            vector.pushBack(std::span<const uint64_t>(zerosSamples));
+            return false; // Success (no error)
+        }
+
+        /**
+         * @class BasicEliasFanoView
+         * @brief Random access and successor search on a serialized Elias-Fano sequence
+         *
+         * The view only stores pointers into the buffer it was opened on; the
+         * buffer must outlive it.
+         *
+         * @tparam Encoding Endianness of the serialized integers
+         */
+        template <std::endian Encoding>
+        class BasicEliasFanoView {
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an empty view
+              */
+            explicit BasicEliasFanoView() noexcept = default;
+            /** @} */
+
+            /**
+             * @name Opening
+             * @{
+             */
+
+             /**
+              * @brief Attaches the view to a serialized sequence
+              * @param buffer Read buffer positioned at the sequence; advanced past it on success
+              * @return true if the header or size is invalid, or the upper bits and
+              *         samples do not match the header, false on success
+              *
+              * The upper bits and samples are checked in one pass, since the
+              * queries scan them without bounds checks.
+              */
+            [[nodiscard]] bool open(BasicReadBuffer<Encoding>& buffer) noexcept {
+                if (buffer.size() < detail::elias_fano_header_size) {
+                    return true; // Error (truncated header)
+                }
+                const uint8_t* header = buffer.data();
+                uint32_t magic = 0;
+                uint32_t lowBits = 0;
+                uint64_t count = 0;
+                uint64_t last = 0;
+                uint64_t lowerWords = 0;
+                uint64_t upperWords = 0;
+                uint64_t onesSamples = 0;
+                uint64_t zerosSamples = 0;
+                basicCopy<Encoding>(magic, header);
+                basicCopy<Encoding>(lowBits, header + 4);
+                basicCopy<Encoding>(count, header + 8);
+                basicCopy<Encoding>(last, header + 16);
+                basicCopy<Encoding>(lowerWords, header + 24);
+                basicCopy<Encoding>(upperWords, header + 32);
+                basicCopy<Encoding>(onesSamples, header + 40);
+                basicCopy<Encoding>(zerosSamples, header + 48);
+
+                const uint64_t available = (buffer.size() - detail::elias_fano_header_size) / 8;
+                if (magic != elias_fano_magic || lowBits >= 64 || count > available * 64) {
+                    return true; // Error (bad header)
+                }
+                const uint64_t upperBits = count + (last >> lowBits) + 1;
+                const uint64_t zeros = upperBits - count;
+                const uint64_t rate = detail::elias_fano_sample_rate;
+                if (lowerWords != (count * lowBits + 63) / 64 + 1 || upperWords != (upperBits + 63) / 64
+                    || onesSamples != (count + rate - 1) / rate || zerosSamples != (zeros + rate - 1) / rate
+                    || lowerWords + upperWords + onesSamples + zerosSamples > available) {
+                    return true; // Error (inconsistent sizes)
+                }
+
+                const uint8_t* lower = header + detail::elias_fano_header_size;
+                const uint8_t* upper = lower + lowerWords * 8;
+                uint64_t lastOne = 0;
+                if (checkUpper(upper, upperBits, count, upper + upperWords * 8, upper + (upperWords + onesSamples) * 8, lastOne)
+                    || (count && lastOne - (count - 1) != last >> lowBits)) {
+                    return true; // Error (upper bits or samples do not match the header)
+                }
+
+                m_lower = lower;
+                m_upper = upper;
+                m_onesSamples = m_upper + upperWords * 8;
+                m_zerosSamples = m_onesSamples + onesSamples * 8;
+                m_count = count;
+                m_last = last;
+                m_lowBits = lowBits;
+                m_upperWords = upperWords;
+                if (count && lowAt(count - 1) != (lowBits ? last & (~uint64_t{ 0 } >> (64 - lowBits)) : 0)) {
+                    *this = BasicEliasFanoView{};
+                    return true; // Error (last value does not match the header)
+                }
+                buffer.skipFront(detail::elias_fano_header_size
+                    + static_cast<size_t>(lowerWords + upperWords + onesSamples + zerosSamples) * 8);
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Queries
+             * @{
+             */
+
+             /**
+              * @brief Gets the number of values
+              * @return Sequence length
+              */
+            [[nodiscard]] uint64_t size() const noexcept { return m_count; }
+
+            /**
+             * @brief Gets the value at an index
+             * @param index Index in [0, size())
+             * @return The value
+             */
+            [[nodiscard]] uint64_t access(uint64_t index) const noexcept {
+                const uint64_t position = selectOne(index);
+                return ((position - index) << m_lowBits) | lowAt(index);
+            }
+
+            /**
+             * @brief Finds the first value not less than a bound
+             * @param bound Lower bound
+             * @param index Receives the index of the found value
+             * @param value Receives the found value
+             * @return true if every value is less than bound, false on success
+             *
+             * Jumps to the bucket of bound's high part with one select on the
+             * zeros of the upper bits, then scans forward over at most that
+             * bucket's values.
+             */
+            [[nodiscard]] bool nextGEQ(uint64_t bound, uint64_t& index, uint64_t& value) const noexcept {
+                if (m_count == 0 || bound > m_last) {
+                    return true; // Error (past the end)
+                }
+                const uint64_t high = bound >> m_lowBits;
+                uint64_t position = high ? selectZero(high - 1) + 1 : 0;
+                uint64_t current = position - high;  // Ones before position
+
+                size_t wordIndex = static_cast<size_t>(position / 64);
+                uint64_t bits = upperWord(wordIndex) & (~uint64_t{ 0 } << (position % 64));
+                for (;;) {
+                    while (bits == 0) {
+                        bits = upperWord(++wordIndex);
+                    }
+                    position = wordIndex * 64 + static_cast<uint64_t>(std::countr_zero(bits));
+                    const uint64_t candidate = ((position - current) << m_lowBits) | lowAt(current);
+                    if (candidate >= bound) {
+                        index = current;
+                        value = candidate;
+                        return false; // Success (no error)
+                    }
+                    bits &= bits - 1;
+                    ++current;
+                }
+            }
+            /** @} */
+
+        private:
+            const uint8_t* m_lower{ nullptr };         ///< Packed low bits
+            const uint8_t* m_upper{ nullptr };         ///< Unary-coded high parts
+            const uint8_t* m_onesSamples{ nullptr };   ///< Position of every 256th one
+            const uint8_t* m_zerosSamples{ nullptr };  ///< Position of every 256th zero
+            uint64_t m_count{ 0 };                     ///< Number of values
+            uint64_t m_last{ 0 };                      ///< Largest value
+            unsigned m_lowBits{ 0 };                   ///< Low bits per value
+            uint64_t m_upperWords{ 0 };                ///< Words in the upper array
+
+            [[nodiscard]] static uint64_t load64(const uint8_t* base, size_t index) noexcept {
+                uint64_t value = 0;
+                basicCopy<Encoding>(value, base + index * 8);
+                return value;
+            }
+
+            /**
+             * @brief Checks that the upper bits hold exactly count ones and that both sample arrays point at them
+             * @param lastOne Receives the position of the last one
+             * @return true if the upper bits or samples are inconsistent
+             */
+            [[nodiscard]] static bool checkUpper(const uint8_t* upper, uint64_t upperBits, uint64_t count,
+                const uint8_t* onesSamples, const uint8_t* zerosSamples, uint64_t& lastOne) noexcept {
+                const size_t words = static_cast<size_t>((upperBits + 63) / 64);
+                uint64_t ones = 0;
+                uint64_t zeros = 0;
+                for (size_t w = 0; w < words; ++w) {
+                    uint64_t mask = ~uint64_t{ 0 };
+                    if (const uint64_t tail = upperBits - w * 64; tail < 64) {
+                        mask >>= 64 - tail;
+                    }
+                    const uint64_t word = load64(upper, w);
+                    if ((word & ~mask) != 0 || checkSamples(word, w, count, ones, onesSamples)
+                        || checkSamples(~word & mask, w, upperBits - count, zeros, zerosSamples)) {
+                        return true; // Error (bits past the end, too many ones or zeros, or a wrong sample)
+                    }
+                    if (word) {
+                        lastOne = w * 64 + 63 - static_cast<uint64_t>(std::countl_zero(word));
+                    }
+                }
+                return ones != count;
+            }
+
+            /**
+             * @brief Checks the samples that fall in one word of ones (or zeros) and counts them
+             * @param bits Ones, or inverted zeros, of word w
+             * @param limit Total number of ones (or zeros) expected
+             * @param seen Ones (or zeros) before this word; advanced past it
+             * @return true if the limit is exceeded or a sample is wrong
+             */
+            [[nodiscard]] static bool checkSamples(uint64_t bits, size_t w, uint64_t limit, uint64_t& seen, const uint8_t* samples) noexcept {
+                constexpr uint64_t rate = detail::elias_fano_sample_rate;
+                const uint64_t available = static_cast<uint64_t>(std::popcount(bits));
+                if (available > limit - seen) {
+                    return true; // Error (more than limit)
+                }
+                for (uint64_t next = (seen + rate - 1) / rate * rate; next < seen + available; next += rate) {
+                    if (load64(samples, static_cast<size_t>(next / rate)) != w * 64 + select64(bits, static_cast<unsigned>(next - seen))) {
+                        return true; // Error (sample does not point at its one or zero)
+                    }
+                }
+                seen += available;
+                return false; // Success (no error)
+            }
+
+            [[nodiscard]] uint64_t upperWord(size_t index) const noexcept {
+                return load64(m_upper, index);
+            }
+
+            [[nodiscard]] uint64_t lowAt(uint64_t index) const noexcept {
+                if (m_lowBits == 0) {
+                    return 0;
+                }
+                const uint64_t position = index * m_lowBits;
+                const size_t word = static_cast<size_t>(position / 64);
+                const unsigned shift = static_cast<unsigned>(position % 64);
+                uint64_t low = load64(m_lower, word) >> shift;
+                if (shift + m_lowBits > 64) {
+                    low |= load64(m_lower, word + 1) << (64 - shift);
+                }
+                return low & (~uint64_t{ 0 } >> (64 - m_lowBits));
+            }
+
+            /**
+             * @brief Position of the rank-th one (or zero) in the upper bits
+             */
+            template <bool Ones>
+            [[nodiscard]] uint64_t select(uint64_t rank) const noexcept {
+                const uint8_t* samples = Ones ? m_onesSamples : m_zerosSamples;
+                const uint64_t start = load64(samples, static_cast<size_t>(rank / detail::elias_fano_sample_rate));
+                uint64_t remaining = rank % detail::elias_fano_sample_rate;
+                size_t wordIndex = static_cast<size_t>(start / 64);
+                uint64_t bits = Ones ? upperWord(wordIndex) : ~upperWord(wordIndex);
+                bits &= ~uint64_t{ 0 } << (start % 64);
+                for (;;) {
+                    const uint64_t available = static_cast<uint64_t>(std::popcount(bits));
+                    if (remaining < available) {
+                        return wordIndex * 64 + select64(bits, static_cast<unsigned>(remaining));
+                    }
+                    remaining -= available;
+                    ++wordIndex;
+                    bits = Ones ? upperWord(wordIndex) : ~upperWord(wordIndex);
+                }
+            }
+
+            [[nodiscard]] uint64_t selectOne(uint64_t rank) const noexcept { return select<true>(rank); }
+            [[nodiscard]] uint64_t selectZero(uint64_t rank) const noexcept { return select<false>(rank); }
+        };
+
+        /**
+         * @brief Elias-Fano view that uses the default stream endianness
+         */
+        using EliasFanoView = BasicEliasFanoView<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_ELIAS_FANO_HEADER_FILE
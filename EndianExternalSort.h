@@ -0,0 +1,435 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_EXTERNAL_SORT_HEADER_FILE
+#define MZ_ENDIAN_EXTERNAL_SORT_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianExternalSort.h
+ * @brief External merge sort for files of length-framed records
+ *
+ * This header defines BasicExternalSorter, which sorts a file of records that
+ * does not fit in memory. Records use the same framing as strings written by
+ * pushBack: [uint32_t size][content][uint32_t size], and are ordered by the
+ * raw bytes of their key (the first keyBytes bytes of the content, or the
+ * whole content) compared with memcmp. Ties keep their input order.
+ *
+ * The sort runs in two phases:
+ * 1. Run generation: the input is read sequentially in chunks that together
+ *    fit the memory budget; each chunk is sorted and spilled to a temporary
+ *    run file on its own thread, so sorting overlaps reading.
+ * 2. Merge: runs are k-way merged through a loser tree, in several passes if
+ *    there are more runs than the fan-in limit.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianFileStream.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @class BasicExternalSorter
+         * @brief Sorts files of length-framed records larger than memory
+         *
+         * @tparam Encoding Endianness of the record length frames
+         */
+        template <std::endian Encoding>
+        class BasicExternalSorter {
+        public:
+            /**
+             * @brief Tuning parameters of the sort
+             */
+            struct Options {
+                size_t memoryBudget{ size_t{ 256 } << 20 };  ///< Bytes of records held in memory at once
+                size_t threadCount{ 0 };                     ///< Run generation threads (0 = hardware concurrency)
+                size_t keyBytes{ 0 };                        ///< Leading content bytes compared (0 = whole content)
+                size_t maxFanIn{ 256 };                      ///< Maximum runs merged in one pass
+                std::string tempDirectory{ "." };            ///< Directory for temporary run files
+            };
+
+            /// Size of the length prefix plus length suffix of a record
+            static constexpr size_t frame_size{ 8 };
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs a sorter
+              * @param options Tuning parameters
+              */
+            explicit BasicExternalSorter(Options options = Options{}) noexcept
+                : m_options{ std::move(options) } {
+                if (m_options.threadCount == 0) {
+                    m_options.threadCount = std::thread::hardware_concurrency();
+                }
+                m_options.threadCount = std::max<size_t>(m_options.threadCount, 1);
+                m_options.maxFanIn = std::max<size_t>(m_options.maxFanIn, 2);
+            }
+            /** @} */
+
+            /**
+             * @name Sorting
+             * @{
+             */
+
+             /**
+              * @brief Sorts a file of records into another file
+              * @param inputPath File holding framed records
+              * @param outputPath File that receives the sorted records
+              * @return true if the input is malformed or any I/O failed, false on success
+              *
+              * Temporary run files are created in Options::tempDirectory and removed
+              * before returning, whether or not the sort succeeded.
+              */
+            [[nodiscard]] bool sort(const std::string& inputPath, const std::string& outputPath) noexcept {
+                std::vector<std::string> runs;
+                bool failed = generateRuns(inputPath, runs);
+
+                // Intermediate passes until a single merge can produce the output
+                while (!failed && runs.size() > m_options.maxFanIn) {
+                    std::vector<std::string> merged;
+                    for (size_t first = 0; first < runs.size() && !failed; first += m_options.maxFanIn) {
+                        const size_t last = std::min(runs.size(), first + m_options.maxFanIn);
+                        merged.push_back(nextRunPath());
+                        failed = mergeRuns(std::span<const std::string>(runs.data() + first, last - first), merged.back());
+                    }
+                    removeFiles(runs);
+                    runs = std::move(merged);
+                }
+
+                if (!failed) {
+                    failed = mergeRuns(runs, outputPath);
+                }
+                removeFiles(runs);
+                return failed;
+            }
+
+            /**
+             * @brief Compares the keys of two record contents
+             * @param lhs Content of the first record
+             * @param rhs Content of the second record
+             * @param keyBytes Leading bytes compared (0 = whole content)
+             * @return Negative, zero or positive like memcmp
+             */
+            [[nodiscard]] static int compareKeys(std::span<const uint8_t> lhs, std::span<const uint8_t> rhs, size_t keyBytes) noexcept {
+                const size_t lhsKey = (keyBytes && keyBytes < lhs.size()) ? keyBytes : lhs.size();
+                const size_t rhsKey = (keyBytes && keyBytes < rhs.size()) ? keyBytes : rhs.size();
+                const size_t common = std::min(lhsKey, rhsKey);
+                if (common > 0) {
+                    if (const int result = std::memcmp(lhs.data(), rhs.data(), common); result != 0) {
+                        return result;
+                    }
+                }
+                return (lhsKey < rhsKey) ? -1 : (lhsKey > rhsKey ? 1 : 0);
+            }
+            /** @} */
+
+        private:
+            Options m_options;             ///< Tuning parameters
+            std::atomic<uint64_t> m_runId{ 0 }; ///< Counter for temporary file names
+
+            /**
+             * @brief Sort index entry: first key bytes (big-endian) plus record offset
+             *
+             * Comparing the 8-byte prefix as an integer settles most comparisons
+             * without touching the record bytes.
+             */
+            struct SortEntry {
+                uint64_t prefix;  ///< First 8 key bytes, big-endian, zero-padded
+                uint32_t offset;  ///< Offset of the record frame in the chunk
+                uint32_t size;    ///< Content size
+            };
+
+            /**
+             * @brief Creates a unique temporary run file path
+             */
+            [[nodiscard]] std::string nextRunPath() noexcept {
+                return m_options.tempDirectory + "/mz-sort-" + std::to_string(reinterpret_cast<uintptr_t>(this))
+                    + "-" + std::to_string(m_runId++) + ".run";
+            }
+
+            /**
+             * @brief Removes temporary files
+             */
+            static void removeFiles(const std::vector<std::string>& paths) noexcept {
+                for (const auto& path : paths) {
+                    std::remove(path.c_str());
+                }
+            }
+
+            /**
+             * @brief Reads one record from a file reader
+             * @param reader Reader positioned at a record frame
+             * @param content Receives the content (valid until the next require())
+             * @return true at end of file or on a malformed frame, false on success
+             */
+            [[nodiscard]] static bool peekRecord(BasicFileReader<Encoding>& reader, std::span<const uint8_t>& content, bool& malformed) noexcept {
+                malformed = false;
+                if (reader.require(4)) {
+                    malformed = reader.available() != 0;
+                    return true; // End of file (or truncated prefix)
+                }
+                uint32_t size = 0;
+                BasicReadBuffer<Encoding> window = reader.window();
+                window.unsafePopFront(size);
+                if (reader.require(static_cast<size_t>(size) + frame_size)) {
+                    malformed = true;
+                    return true; // Error (truncated record)
+                }
+                window = reader.window();
+                window.skipFront(4);
+                const uint8_t* bytes = window.data();
+                window.skipFront(size);
+                uint32_t sizeCheck = 0;
+                window.unsafePopFront(sizeCheck);
+                if (size != sizeCheck) {
+                    malformed = true;
+                    return true; // Error (frame mismatch)
+                }
+                content = std::span<const uint8_t>(bytes, size);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Sorts one chunk of records and writes it as a run file
+             */
+            [[nodiscard]] bool sortAndSpill(const BasicVector<Encoding>& chunk, const std::string& path) const noexcept {
+                std::vector<SortEntry> entries;
+                BasicReadBuffer<Encoding> reader{ chunk.data(), chunk.size() };
+                while (!reader.empty()) {
+                    const auto offset = static_cast<uint32_t>(reader.data() - chunk.data());
+                    const uint32_t size = reader.template unsafePopFront<uint32_t>();
+                    const size_t keySize = (m_options.keyBytes && m_options.keyBytes < size) ? m_options.keyBytes : size;
+                    uint8_t prefixBytes[8]{};
+                    std::memcpy(prefixBytes, reader.data(), std::min<size_t>(keySize, 8));
+                    uint64_t prefix = 0;
+                    basicCopy<std::endian::big>(prefix, prefixBytes);
+                    entries.push_back(SortEntry{ prefix, offset, size });
+                    reader.skipFront(static_cast<size_t>(size) + 4);
+                }
+
+                const size_t keyBytes = m_options.keyBytes;
+                const uint8_t* base = chunk.data();
+                std::sort(entries.begin(), entries.end(), [base, keyBytes](const SortEntry& lhs, const SortEntry& rhs) {
+                    if (lhs.prefix != rhs.prefix) {
+                        return lhs.prefix < rhs.prefix;
+                    }
+                    const int result = compareKeys(std::span<const uint8_t>(base + lhs.offset + 4, lhs.size),
+                        std::span<const uint8_t>(base + rhs.offset + 4, rhs.size), keyBytes);
+                    return result != 0 ? result < 0 : lhs.offset < rhs.offset;
+                });
+
+                BasicFileWriter<Encoding> writer;
+                if (writer.open(path)) {
+                    return true; // Error (cannot create run)
+                }
+                for (const auto& entry : entries) {
+                    writer.write(std::span<const uint8_t>(base + entry.offset, entry.size + frame_size));
+                }
+                return writer.close();
+            }
+
+            /**
+             * @brief Phase 1: splits the input into sorted run files
+             */
+            [[nodiscard]] bool generateRuns(const std::string& inputPath, std::vector<std::string>& runs) noexcept {
+                BasicFileReader<Encoding> reader;
+                if (reader.open(inputPath)) {
+                    return true; // Error (cannot open input)
+                }
+
+                // Every in-flight chunk plus the one being read must fit the budget
+                const size_t chunkBudget = std::max<size_t>(m_options.memoryBudget / (m_options.threadCount + 1), 4096);
+                std::vector<std::thread> workers;
+                std::vector<BasicVector<Encoding>> chunks(m_options.threadCount);
+                std::atomic<bool> failed{ false };
+                size_t next = 0;
+
+                for (;;) {
+                    // Reuse the oldest slot once its worker is done
+                    const size_t slot = next % m_options.threadCount;
+                    if (workers.size() == m_options.threadCount) {
+                        workers[slot].join();
+                    }
+                    auto& chunk = chunks[slot];
+                    chunk.clear();
+
+                    bool malformed = false;
+                    std::span<const uint8_t> content;
+                    while (chunk.size() < chunkBudget && !peekRecord(reader, content, malformed)) {
+                        const size_t length = content.size() + frame_size;
+                        const size_t oldSize = chunk.size();
+                        chunk.expandBy(length);
+                        std::memcpy(chunk.data() + oldSize, content.data() - 4, length);
+                        reader.consume(length);
+                    }
+                    if (malformed || chunk.size() > UINT32_MAX) {
+                        failed = true;
+                    }
+                    if (chunk.empty() || failed) {
+                        break;
+                    }
+
+                    runs.push_back(nextRunPath());
+                    std::thread worker([this, &chunk, &failed, path = runs.back()]() {
+                        if (sortAndSpill(chunk, path)) {
+                            failed = true;
+                        }
+                    });
+                    if (workers.size() < m_options.threadCount) {
+                        workers.push_back(std::move(worker));
+                    }
+                    else {
+                        workers[slot] = std::move(worker);
+                    }
+                    ++next;
+                }
+
+                for (auto& worker : workers) {
+                    if (worker.joinable()) {
+                        worker.join();
+                    }
+                }
+                if (failed) {
+                    removeFiles(runs);
+                    runs.clear();
+                }
+                return failed;
+            }
+
+            /**
+             * @brief Phase 2: k-way merges run files through a loser tree
+             *
+             * Leaves are the runs; each internal node stores the loser of the
+             * match played there and node 0 stores the overall winner. After the
+             * winner's record is written only the path from its leaf to the root
+             * is replayed, so each output record costs log2(k) key comparisons.
+             */
+            [[nodiscard]] bool mergeRuns(std::span<const std::string> runPaths, const std::string& outputPath) noexcept {
+                BasicFileWriter<Encoding> writer;
+                if (writer.open(outputPath)) {
+                    return true; // Error (cannot create output)
+                }
+
+                const size_t count = runPaths.size();
+                if (count == 0) {
+                    return writer.close();
+                }
+
+                // Split the memory budget between the run readers
+                const size_t blockSize = std::clamp<size_t>(m_options.memoryBudget / (count + 1), 64 * 1024, 4 << 20);
+                std::vector<BasicFileReader<Encoding>> readers;
+                readers.reserve(count);
+                std::vector<std::span<const uint8_t>> heads(count);
+                std::vector<bool> exhausted(count, false);
+                bool failed = false;
+
+                for (size_t i = 0; i < count; ++i) {
+                    readers.emplace_back(blockSize);
+                    bool malformed = false;
+                    failed = failed || readers[i].open(runPaths[i]);
+                    exhausted[i] = failed || peekRecord(readers[i], heads[i], malformed);
+                    failed = failed || malformed;
+                }
+                if (failed) {
+                    (void)writer.close();
+                    return true; // Error (cannot read a run)
+                }
+
+                const size_t keyBytes = m_options.keyBytes;
+                auto less = [&](size_t lhs, size_t rhs) {
+                    if (exhausted[lhs]) return false;
+                    if (exhausted[rhs]) return true;
+                    const int result = compareKeys(heads[lhs], heads[rhs], keyBytes);
+                    return result != 0 ? result < 0 : lhs < rhs; // Earlier runs first keeps the sort stable
+                };
+
+                // Build: leaves at [count, 2 * count), internal nodes at [1, count)
+                std::vector<size_t> winners(2 * count);
+                std::vector<size_t> losers(count);
+                for (size_t i = 0; i < count; ++i) {
+                    winners[count + i] = i;
+                }
+                for (size_t node = count - 1; node >= 1; --node) {
+                    const size_t left = winners[2 * node];
+                    const size_t right = winners[2 * node + 1];
+                    winners[node] = less(right, left) ? right : left;
+                    losers[node] = less(right, left) ? left : right;
+                }
+                losers[0] = (count == 1) ? 0 : winners[1];
+
+                while (!exhausted[losers[0]]) {
+                    size_t winner = losers[0];
+                    const size_t length = heads[winner].size() + frame_size;
+                    writer.write(std::span<const uint8_t>(heads[winner].data() - 4, length));
+                    readers[winner].consume(length);
+
+                    bool malformed = false;
+                    exhausted[winner] = peekRecord(readers[winner], heads[winner], malformed);
+                    if (malformed) {
+                        failed = true;
+                        break;
+                    }
+
+                    // Replay the matches on the path from the leaf to the root
+                    for (size_t node = (count + winner) / 2; node >= 1; node /= 2) {
+                        if (less(losers[node], winner)) {
+                            std::swap(losers[node], winner);
+                        }
+                    }
+                    losers[0] = winner;
+                }
+
+                return writer.close() || failed;
+            }
+        };
+
+        /**
+         * @brief External sorter that uses the default stream endianness
+         */
+        using ExternalSorter = BasicExternalSorter<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_EXTERNAL_SORT_HEADER_FILE
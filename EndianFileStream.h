@@ -0,0 +1,488 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_FILE_STREAM_HEADER_FILE
+#define MZ_ENDIAN_FILE_STREAM_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianFileStream.h
+ * @brief Buffered file streams built on the endian-aware vector and buffers
+ *
+ * This header defines two classes for streaming serialized data to and from
+ * files with large sequential I/O:
+ * - BasicFileWriter: Appends to a BasicVector and writes it out in large blocks
+ * - BasicFileReader: Reads large blocks and exposes them as a BasicReadBuffer
+ *
+ * Both use std::FILE so they work on every platform the library supports.
+ * Position helpers use the 64-bit seek/tell variants of each platform.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <span>
+#include <bit>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+#if defined(_MSC_VER)
+#include <io.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @name File Position Helpers
+         * @{
+         */
+
+         /**
+          * @brief Moves a file to an absolute 64-bit position
+          * @param file Open file
+          * @param position Byte offset from the start of the file
+          * @return true if the seek failed, false on success
+          */
+        [[nodiscard]] inline bool fileSeek(std::FILE* file, uint64_t position) noexcept {
+#if defined(_MSC_VER)
+            return _fseeki64(file, static_cast<__int64>(position), SEEK_SET) != 0;
+#elif defined(__unix__) || defined(__APPLE__)
+            return fseeko(file, static_cast<off_t>(position), SEEK_SET) != 0;
+#else
+            return std::fseek(file, static_cast<long>(position), SEEK_SET) != 0;
+#endif
+        }
+
+        /**
+         * @brief Gets the size of a file and leaves the position at the start
+         * @param file Open file
+         * @param size Receives the file size in bytes
+         * @return true if the size could not be determined, false on success
+         */
+        [[nodiscard]] inline bool fileSize(std::FILE* file, uint64_t& size) noexcept {
+#if defined(_MSC_VER)
+            if (_fseeki64(file, 0, SEEK_END) != 0) return true;
+            const __int64 end = _ftelli64(file);
+#elif defined(__unix__) || defined(__APPLE__)
+            if (fseeko(file, 0, SEEK_END) != 0) return true;
+            const off_t end = ftello(file);
+#else
+            if (std::fseek(file, 0, SEEK_END) != 0) return true;
+            const long end = std::ftell(file);
+#endif
+            if (end < 0) {
+                return true; // Error (not seekable)
+            }
+            size = static_cast<uint64_t>(end);
+            return fileSeek(file, 0);
+        }
+        /** @} */
+
+        /**
+         * @class BasicFileWriter
+         * @brief Buffered, endian-aware writer that streams to a file
+         *
+         * Values are appended to an in-memory BasicVector using the usual pushBack
+         * overloads; whenever the vector exceeds the block size it is written to
+         * the file in one call. Write errors are sticky and reported by flush()
+         * and close().
+         *
+         * @tparam Encoding Target endianness for the written data
+         */
+        template <std::endian Encoding>
+        class BasicFileWriter {
+        public:
+            /// Default size of each write issued to the file
+            static constexpr size_t default_block_size{ size_t{ 1 } << 20 };
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs a closed writer
+              * @param blockSize Size of each write issued to the file
+              */
+            explicit BasicFileWriter(size_t blockSize = default_block_size) noexcept
+                : m_blockSize{ blockSize ? blockSize : default_block_size } {
+                m_buffer.reserve(m_blockSize);
+                m_buffer.clear();
+            }
+
+            BasicFileWriter(const BasicFileWriter&) = delete;
+            BasicFileWriter& operator=(const BasicFileWriter&) = delete;
+
+            /**
+             * @brief Destructor; flushes and closes the file if still open
+             */
+            ~BasicFileWriter() noexcept {
+                (void)close();
+            }
+            /** @} */
+
+            /**
+             * @name File Operations
+             * @{
+             */
+
+             /**
+              * @brief Creates (or truncates) a file for writing
+              * @param path Path of the file
+              * @return true if the file could not be opened, false on success
+              */
+            [[nodiscard]] bool open(const std::string& path) noexcept {
+                (void)close();
+                m_file = std::fopen(path.c_str(), "wb");
+                m_error = (m_file == nullptr);
+                m_written = 0;
+                if (m_file) {
+                    std::setvbuf(m_file, nullptr, _IONBF, 0); // We already buffer in m_buffer
+                }
+                return m_error;
+            }
+
+            /**
+             * @brief Checks if the writer has an open file
+             * @return true if a file is open
+             */
+            [[nodiscard]] bool isOpen() const noexcept { return m_file != nullptr; }
+
+            /**
+             * @brief Checks if any write has failed
+             * @return true if the writer is in an error state
+             */
+            [[nodiscard]] bool error() const noexcept { return m_error; }
+
+            /**
+             * @brief Gets the number of bytes written so far, including buffered bytes
+             * @return Logical file position
+             */
+            [[nodiscard]] uint64_t position() const noexcept { return m_written + m_buffer.size(); }
+
+            /**
+             * @brief Writes all buffered bytes to the file
+             * @return true if the writer is in an error state, false on success
+             */
+            [[nodiscard]] bool flush() noexcept {
+                if (!m_error && m_file && !m_buffer.empty()) {
+                    m_error = std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size();
+                    m_written += m_buffer.size();
+                }
+                m_buffer.clear();
+                return m_error;
+            }
+
+            /**
+             * @brief Flushes and asks the operating system to commit the file to storage
+             * @return true if no file is open, or a write or the sync failed, false on success
+             *
+             * Used before renaming a file into place, so that after a power loss
+             * the new name never refers to incomplete data.
+             */
+            [[nodiscard]] bool sync() noexcept {
+                if (!m_file) {
+                    return true; // Error (no open file)
+                }
+                if (!flush()) {
+                    m_error = std::fflush(m_file) != 0;
+#if defined(_MSC_VER)
+                    m_error = m_error || _commit(_fileno(m_file)) != 0;
+#elif defined(__unix__) || defined(__APPLE__)
+                    m_error = m_error || fsync(fileno(m_file)) != 0;
+#endif
+                }
+                return m_error;
+            }
+
+            /**
+             * @brief Flushes and closes the file
+             * @return true if any write or the close failed, false on success
+             */
+            [[nodiscard]] bool close() noexcept {
+                if (m_file) {
+                    (void)flush();
+                    m_error = (std::fclose(m_file) != 0) || m_error;
+                    m_file = nullptr;
+                }
+                return m_error;
+            }
+            /** @} */
+
+            /**
+             * @name Write Operations
+             * @{
+             */
+
+             /**
+              * @brief Appends a value using the matching BasicVector::pushBack overload
+              * @tparam T Any type BasicVector<Encoding>::pushBack accepts
+              * @param value Value to append
+              */
+            template <typename T>
+                requires requires(BasicVector<Encoding>& vector, const T& item) { vector.pushBack(item); }
+            void pushBack(const T& value) noexcept {
+                m_buffer.pushBack(value);
+                flushIfFull();
+            }
+
+            /**
+             * @brief Appends raw bytes without endianness conversion
+             * @param bytes Bytes to append
+             */
+            void write(std::span<const uint8_t> bytes) noexcept {
+                if (bytes.size() >= m_blockSize) {
+                    // Large writes bypass the buffer
+                    (void)flush();
+                    if (!m_error && m_file) {
+                        m_error = std::fwrite(bytes.data(), 1, bytes.size(), m_file) != bytes.size();
+                        m_written += bytes.size();
+                    }
+                    return;
+                }
+                m_buffer.pushBack(bytes);
+                flushIfFull();
+            }
+
+            /**
+             * @brief Gets the pending (not yet written) bytes
+             * @return Reference to the staging vector
+             *
+             * Callers may append to the vector directly; the next pushBack, write
+             * or flush takes care of writing it out.
+             */
+            [[nodiscard]] BasicVector<Encoding>& buffer() noexcept { return m_buffer; }
+            /** @} */
+
+        private:
+            std::FILE* m_file{ nullptr };    ///< Open file, or nullptr
+            BasicVector<Encoding> m_buffer;  ///< Bytes not yet written
+            size_t m_blockSize{ 0 };         ///< Write granularity
+            uint64_t m_written{ 0 };         ///< Bytes handed to the file so far
+            bool m_error{ false };           ///< Sticky error flag
+
+            /**
+             * @brief Writes the buffer out once it reaches the block size
+             */
+            void flushIfFull() noexcept {
+                if (m_buffer.size() >= m_blockSize) {
+                    (void)flush();
+                }
+            }
+        };
+
+        /**
+         * @class BasicFileReader
+         * @brief Buffered, endian-aware reader that streams from a file
+         *
+         * The reader keeps a window of the file in memory. require() makes sure
+         * at least a given number of bytes are in the window (reading ahead by a
+         * whole block), window() exposes it as a BasicReadBuffer, and consume()
+         * drops bytes from its front. On Linux the kernel is also told that the
+         * file is read sequentially so it prefetches aggressively.
+         *
+         * @tparam Encoding Source endianness of the data
+         */
+        template <std::endian Encoding>
+        class BasicFileReader {
+        public:
+            /// Default size of each read issued to the file
+            static constexpr size_t default_block_size{ size_t{ 1 } << 20 };
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs a closed reader
+              * @param blockSize Size of each read issued to the file
+              */
+            explicit BasicFileReader(size_t blockSize = default_block_size) noexcept
+                : m_blockSize{ blockSize ? blockSize : default_block_size } {
+            }
+
+            BasicFileReader(const BasicFileReader&) = delete;
+            BasicFileReader& operator=(const BasicFileReader&) = delete;
+
+            /**
+             * @brief Move constructor
+             * @param other Reader to move from; left closed
+             */
+            BasicFileReader(BasicFileReader&& other) noexcept
+                : m_file{ other.m_file }, m_buffer{ std::move(other.m_buffer) }
+                , m_begin{ other.m_begin }, m_blockSize{ other.m_blockSize }, m_eof{ other.m_eof } {
+                other.m_file = nullptr;
+                other.m_begin = 0;
+            }
+
+            /**
+             * @brief Destructor; closes the file if still open
+             */
+            ~BasicFileReader() noexcept {
+                close();
+            }
+            /** @} */
+
+            /**
+             * @name File Operations
+             * @{
+             */
+
+             /**
+              * @brief Opens a file for reading
+              * @param path Path of the file
+              * @return true if the file could not be opened, false on success
+              */
+            [[nodiscard]] bool open(const std::string& path) noexcept {
+                close();
+                m_file = std::fopen(path.c_str(), "rb");
+                if (!m_file) {
+                    return true; // Error (cannot open)
+                }
+                std::setvbuf(m_file, nullptr, _IONBF, 0); // We already buffer in m_buffer
+#if defined(__linux__)
+                (void)posix_fadvise(fileno(m_file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Closes the file and drops the window
+             */
+            void close() noexcept {
+                if (m_file) {
+                    std::fclose(m_file);
+                    m_file = nullptr;
+                }
+                m_buffer.clear();
+                m_begin = 0;
+                m_eof = false;
+            }
+            /** @} */
+
+            /**
+             * @name Read Operations
+             * @{
+             */
+
+             /**
+              * @brief Ensures at least a number of bytes are in the window
+              * @param bytes Minimum number of bytes needed
+              * @return true if the file ends (or fails) before that many bytes, false on success
+              */
+            [[nodiscard]] bool require(size_t bytes) noexcept {
+                if (available() >= bytes) {
+                    return false; // Success (no error)
+                }
+                if (!m_file || m_eof) {
+                    return true; // Error (end of file)
+                }
+
+                // Move the unread tail to the front, then read at least one block
+                const size_t pending = available();
+                if (m_begin > 0) {
+                    if (pending > 0) {
+                        std::memmove(m_buffer.data(), m_buffer.data() + m_begin, pending);
+                    }
+                    m_begin = 0;
+                }
+                const size_t wanted = (bytes - pending > m_blockSize) ? bytes - pending : m_blockSize;
+                m_buffer.resize(pending + wanted);
+                const size_t got = std::fread(m_buffer.data() + pending, 1, wanted, m_file);
+                m_buffer.resize(pending + got);
+                if (got < wanted) {
+                    m_eof = true;
+                }
+                return available() < bytes;
+            }
+
+            /**
+             * @brief Gets the number of bytes currently in the window
+             * @return Bytes available without further I/O
+             */
+            [[nodiscard]] size_t available() const noexcept {
+                return m_buffer.size() - m_begin;
+            }
+
+            /**
+             * @brief Checks if every byte of the file has been consumed
+             * @return true at end of file
+             */
+            [[nodiscard]] bool empty() noexcept {
+                return available() == 0 && require(1);
+            }
+
+            /**
+             * @brief Gets the current window as a read buffer
+             * @return Read buffer over the bytes currently in memory
+             *
+             * @warning The returned buffer is invalidated by require().
+             */
+            [[nodiscard]] BasicReadBuffer<Encoding> window() const noexcept {
+                return BasicReadBuffer<Encoding>{ m_buffer.data() + m_begin, available() };
+            }
+
+            /**
+             * @brief Drops bytes from the front of the window
+             * @param bytes Number of bytes to drop (capped at available())
+             */
+            void consume(size_t bytes) noexcept {
+                m_begin += (bytes < available()) ? bytes : available();
+            }
+            /** @} */
+
+        private:
+            std::FILE* m_file{ nullptr };    ///< Open file, or nullptr
+            BasicVector<Encoding> m_buffer;  ///< Window of the file
+            size_t m_begin{ 0 };             ///< First unread byte in the window
+            size_t m_blockSize{ 0 };         ///< Read granularity
+            bool m_eof{ false };             ///< Set once a read came back short
+        };
+
+        /**
+         * @brief File writer that uses the default stream endianness
+         */
+        using FileWriter = BasicFileWriter<stream_endian>;
+
+        /**
+         * @brief File reader that uses the default stream endianness
+         */
+        using FileReader = BasicFileReader<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_FILE_STREAM_HEADER_FILE
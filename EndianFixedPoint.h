@@ -0,0 +1,414 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_FIXED_POINT_HEADER_FILE
+#define MZ_ENDIAN_FIXED_POINT_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianFixedPoint.h
+ * @brief Scaled-integer (fixed-point and decimal) span encodings
+ *
+ * This header converts spans of floating-point values to and from integers
+ * scaled by a constant factor, such as prices in cents (scale 100) or
+ * readings in thousandths, fused with the endian swap.
+ *
+ * Decoding divides each integer by the scale, so a decimal scale gives the
+ * correctly rounded double nearest to the decimal value. Encoding multiplies
+ * by the scale, rounds with the selected RoundingMode and saturates to the
+ * wire type; NaN encodes as zero. The product itself is rounded once, so a
+ * value that lies exactly halfway in decimal may already sit slightly to one
+ * side of it in binary.
+ *
+ * The scale is a runtime argument to decodeScaled/encodeScaled and the
+ * buffer helpers, or a compile-time one through ScaledDecimal. With SSE2 the
+ * int32_t wire type converts four elements per step; rounding modes other
+ * than nearestEven are vectorized when SSE4.1 is available, except
+ * nearestAway, which always uses the scalar path.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define MZ_ENDIAN_FIXED_POINT_SSE2 1
+#endif
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#define MZ_ENDIAN_FIXED_POINT_SSE41 1
+#endif
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianSpanConvert.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Rounding applied when encoding a scaled value
+         */
+        enum class RoundingMode : uint8_t {
+            none,               ///< No mode
+            nearestEven = 1,    ///< Nearest, ties to even (IEEE default)
+            nearestAway = 2,    ///< Nearest, ties away from zero
+            towardZero = 3,     ///< Truncate
+            down = 4,           ///< Toward negative infinity
+            up = 5,             ///< Toward positive infinity
+            invalid             ///< Invalid mode
+        };
+
+        /**
+         * @brief Gets the scale of a decimal with the given number of fractional digits
+         * @param decimals Digits after the decimal point (at most 22, where powers of ten stay exact)
+         * @return 10 to the power of decimals
+         */
+        [[nodiscard]] constexpr double decimalScale(unsigned decimals) noexcept {
+            double scale = 1.0;
+            for (unsigned i = 0; i < decimals; ++i) {
+                scale *= 10.0;
+            }
+            return scale;
+        }
+
+        namespace detail {
+
+            template <RoundingMode Mode, std::floating_point T>
+            [[nodiscard]] inline T roundScaled(T value) noexcept {
+                if constexpr (Mode == RoundingMode::nearestAway) { return std::round(value); }
+                else if constexpr (Mode == RoundingMode::towardZero) { return std::trunc(value); }
+                else if constexpr (Mode == RoundingMode::down) { return std::floor(value); }
+                else if constexpr (Mode == RoundingMode::up) { return std::ceil(value); }
+                else { return std::nearbyint(value); }
+            }
+
+#if defined(MZ_ENDIAN_FIXED_POINT_SSE2)
+            [[nodiscard]] inline __m128i swap32Lanes(__m128i block) noexcept {
+                block = _mm_or_si128(_mm_slli_epi16(block, 8), _mm_srli_epi16(block, 8));
+                return _mm_shufflelo_epi16(_mm_shufflehi_epi16(block, 0xB1), 0xB1);
+            }
+
+            template <RoundingMode Mode>
+            static constexpr bool scaled_rounding_vectorized{
+#if defined(MZ_ENDIAN_FIXED_POINT_SSE41)
+                Mode != RoundingMode::nearestAway
+#else
+                Mode == RoundingMode::nearestEven
+#endif
+            };
+
+#if defined(MZ_ENDIAN_FIXED_POINT_SSE41)
+            template <RoundingMode Mode>
+            static constexpr int scaled_round_flags{
+                (Mode == RoundingMode::towardZero ? _MM_FROUND_TO_ZERO
+                    : Mode == RoundingMode::down ? _MM_FROUND_TO_NEG_INF
+                    : Mode == RoundingMode::up ? _MM_FROUND_TO_POS_INF
+                    : _MM_FROUND_TO_NEAREST_INT) | _MM_FROUND_NO_EXC
+            };
+#endif
+
+            /**
+             * @brief Scales, rounds and saturates two doubles to int32 lanes 0 and 1
+             */
+            template <RoundingMode Mode>
+            [[nodiscard]] inline __m128i scaleToInt32(__m128d values, __m128d scale) noexcept {
+                values = _mm_mul_pd(values, scale);
+                values = _mm_and_pd(values, _mm_cmpord_pd(values, values));
+#if defined(MZ_ENDIAN_FIXED_POINT_SSE41)
+                if constexpr (Mode != RoundingMode::nearestEven) {
+                    values = _mm_round_pd(values, scaled_round_flags<Mode>);
+                }
+#endif
+                values = _mm_max_pd(_mm_min_pd(values, _mm_set1_pd(2147483647.0)), _mm_set1_pd(-2147483648.0));
+                return _mm_cvtpd_epi32(values);
+            }
+
+            /**
+             * @brief Scales, rounds and saturates four floats to int32 lanes
+             */
+            template <RoundingMode Mode>
+            [[nodiscard]] inline __m128i scaleToInt32(__m128 values, __m128 scale) noexcept {
+                values = _mm_mul_ps(values, scale);
+                values = _mm_and_ps(values, _mm_cmpord_ps(values, values));
+#if defined(MZ_ENDIAN_FIXED_POINT_SSE41)
+                if constexpr (Mode != RoundingMode::nearestEven) {
+                    values = _mm_round_ps(values, scaled_round_flags<Mode>);
+                }
+#endif
+                // Overflowing lanes convert to INT32_MIN; flipping every bit of the positive ones gives INT32_MAX
+                const __m128i overflow = _mm_castps_si128(_mm_cmpge_ps(values, _mm_set1_ps(2147483648.0f)));
+                return _mm_xor_si128(_mm_cvtps_epi32(values), overflow);
+            }
+#endif
+
+            template <std::endian Encoding, WireIntType Wire, RoundingMode Mode, std::floating_point T, size_t N>
+            inline void encodeScaled(uint8_t* out, const std::span<T, N>& source, std::remove_const_t<T> scale) noexcept {
+                using Value = std::remove_const_t<T>;
+                const size_t count = source.size();
+                size_t i = 0;
+#if defined(MZ_ENDIAN_FIXED_POINT_SSE2)
+                if constexpr (std::same_as<Wire, int32_t> && scaled_rounding_vectorized<Mode>) {
+                    for (; i + 4 <= count; i += 4) {
+                        __m128i block;
+                        if constexpr (std::same_as<Value, double>) {
+                            const __m128d factor = _mm_set1_pd(scale);
+                            const __m128i low = scaleToInt32<Mode>(_mm_loadu_pd(source.data() + i), factor);
+                            const __m128i high = scaleToInt32<Mode>(_mm_loadu_pd(source.data() + i + 2), factor);
+                            block = _mm_unpacklo_epi64(low, high);
+                        }
+                        else {
+                            block = scaleToInt32<Mode>(_mm_loadu_ps(source.data() + i), _mm_set1_ps(scale));
+                        }
+                        if constexpr (Encoding != std::endian::native) {
+                            block = swap32Lanes(block);
+                        }
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), block);
+                    }
+                }
+#endif
+                for (; i < count; ++i) {
+                    const Value scaled = static_cast<Value>(source[i]) * scale;
+                    basicCopy<Encoding>(out + i * sizeof(Wire), saturateCast<Wire>(roundScaled<Mode>(scaled)));
+                }
+            }
+
+        } // namespace detail
+
+        /**
+         * @brief Decodes a span of scaled integers into floating-point values
+         *
+         * @tparam Encoding Byte order of the integers
+         * @tparam Wire Integer type of the stored values
+         * @tparam T Destination floating-point type
+         * @tparam N Size of the span (can be dynamic_extent)
+         * @param destination Receives integer / scale for each stored integer
+         * @param source Source memory address; holds sizeof(Wire) * destination.size() bytes
+         * @param scale Scale factor, such as decimalScale(2) for hundredths
+         */
+        template <std::endian Encoding, WireIntType Wire, std::floating_point T, size_t N>
+            requires (!std::is_const_v<T>)
+        inline void decodeScaled(std::span<T, N> destination, const void* source, T scale) noexcept {
+            const uint8_t* in = static_cast<const uint8_t*>(source);
+            const size_t count = destination.size();
+            size_t i = 0;
+#if defined(MZ_ENDIAN_FIXED_POINT_SSE2)
+            if constexpr (std::same_as<Wire, int32_t> && (std::same_as<T, double> || std::same_as<T, float>)) {
+                for (; i + 4 <= count; i += 4) {
+                    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+                    if constexpr (Encoding != std::endian::native) {
+                        block = detail::swap32Lanes(block);
+                    }
+                    if constexpr (std::same_as<T, double>) {
+                        const __m128d divisor = _mm_set1_pd(scale);
+                        _mm_storeu_pd(destination.data() + i, _mm_div_pd(_mm_cvtepi32_pd(block), divisor));
+                        _mm_storeu_pd(destination.data() + i + 2, _mm_div_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(block, block)), divisor));
+                    }
+                    else {
+                        _mm_storeu_ps(destination.data() + i, _mm_div_ps(_mm_cvtepi32_ps(block), _mm_set1_ps(scale)));
+                    }
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                Wire value;
+                basicCopy<Encoding>(value, in + i * sizeof(Wire));
+                destination[i] = static_cast<T>(value) / scale;
+            }
+        }
+
+        /**
+         * @brief Encodes a span of floating-point values as scaled integers
+         *
+         * @tparam Encoding Byte order of the integers
+         * @tparam Wire Integer type of the stored values
+         * @tparam T Source floating-point type
+         * @tparam N Size of the span (can be dynamic_extent)
+         * @param destination Destination memory address; receives sizeof(Wire) * source.size() bytes
+         * @param source Values to encode as round(value * scale), saturated to Wire
+         * @param scale Scale factor, such as decimalScale(2) for hundredths
+         * @param mode Rounding of the scaled values
+         */
+        template <std::endian Encoding, WireIntType Wire, std::floating_point T, size_t N>
+        inline void encodeScaled(void* destination, const std::span<T, N>& source, std::remove_const_t<T> scale,
+            RoundingMode mode = RoundingMode::nearestEven) noexcept {
+            uint8_t* out = static_cast<uint8_t*>(destination);
+            switch (mode) {
+            case RoundingMode::nearestAway:
+                detail::encodeScaled<Encoding, Wire, RoundingMode::nearestAway>(out, source, scale);
+                break;
+            case RoundingMode::towardZero:
+                detail::encodeScaled<Encoding, Wire, RoundingMode::towardZero>(out, source, scale);
+                break;
+            case RoundingMode::down:
+                detail::encodeScaled<Encoding, Wire, RoundingMode::down>(out, source, scale);
+                break;
+            case RoundingMode::up:
+                detail::encodeScaled<Encoding, Wire, RoundingMode::up>(out, source, scale);
+                break;
+            default:
+                detail::encodeScaled<Encoding, Wire, RoundingMode::nearestEven>(out, source, scale);
+                break;
+            }
+        }
+
+        /**
+         * @name Buffer Helpers
+         * @{
+         */
+
+         /**
+          * @brief Reads scaled integers from the front of a buffer into floating-point values
+          * @tparam Wire Integer type stored in the buffer
+          * @param buffer Source buffer
+          * @param values Receives integer / scale for each stored integer
+          * @param scale Scale factor
+          * @return true if the buffer holds fewer than values.size() integers, false on success
+          */
+        template <WireIntType Wire, std::endian Encoding, std::floating_point T, size_t N>
+            requires (!std::is_const_v<T>)
+        [[nodiscard]] bool popFrontScaled(BasicReadBuffer<Encoding>& buffer, std::span<T, N> values, T scale) noexcept {
+            if (buffer.size() < sizeof(Wire) * values.size()) {
+                return true; // Error (buffer underflow)
+            }
+            decodeScaled<Encoding, Wire>(values, buffer.data(), scale);
+            buffer.skipFront(sizeof(Wire) * values.size());
+            return false; // Success (no error)
+        }
+
+        /**
+         * @brief Writes floating-point values to a buffer as scaled integers
+         * @tparam Wire Integer type written to the buffer
+         * @param buffer Destination buffer
+         * @param values Values to encode as round(value * scale), saturated to Wire
+         * @param scale Scale factor
+         * @param mode Rounding of the scaled values
+         * @return true if the buffer has no room for values.size() integers, false on success
+         */
+        template <WireIntType Wire, std::endian Encoding, std::floating_point T, size_t N>
+        [[nodiscard]] bool pushBackScaled(BasicWriteBuffer<Encoding>& buffer, const std::span<T, N>& values, std::remove_const_t<T> scale,
+            RoundingMode mode = RoundingMode::nearestEven) noexcept {
+            if (buffer.size() < sizeof(Wire) * values.size()) {
+                return true; // Error (buffer full)
+            }
+            encodeScaled<Encoding, Wire>(buffer.data(), values, scale, mode);
+            buffer.skip(sizeof(Wire) * values.size());
+            return false; // Success (no error)
+        }
+
+        /**
+         * @brief Appends floating-point values to a vector as scaled integers
+         * @tparam Wire Integer type appended to the vector
+         * @param vector Destination vector
+         * @param values Values to encode as round(value * scale), saturated to Wire
+         * @param scale Scale factor
+         * @param mode Rounding of the scaled values
+         */
+        template <WireIntType Wire, std::endian Encoding, std::floating_point T, size_t N>
+        void pushBackScaled(BasicVector<Encoding>& vector, const std::span<T, N>& values, std::remove_const_t<T> scale,
+            RoundingMode mode = RoundingMode::nearestEven) noexcept {
+            const size_t offset = vector.size();
+            vector.expandBy(sizeof(Wire) * values.size());
+            encodeScaled<Encoding, Wire>(vector.data() + offset, values, scale, mode);
+        }
+        /** @} */
+
+        /**
+         * @struct ScaledDecimal
+         * @brief Decimal encoding with the scale and rounding fixed at compile time
+         *
+         * @tparam Wire Integer type of the stored values
+         * @tparam Decimals Digits after the decimal point
+         * @tparam Mode Rounding used when encoding
+         */
+        template <WireIntType Wire, unsigned Decimals, RoundingMode Mode = RoundingMode::nearestEven>
+            requires (Decimals <= 22 && Mode != RoundingMode::none && Mode != RoundingMode::invalid)
+        struct ScaledDecimal {
+            static constexpr double scale{ decimalScale(Decimals) };  ///< 10 to the power of Decimals
+
+            /**
+             * @brief Decodes one stored integer
+             * @param value Stored integer
+             * @return value / scale
+             */
+            [[nodiscard]] static double decode(Wire value) noexcept {
+                return static_cast<double>(value) / scale;
+            }
+
+            /**
+             * @brief Encodes one value
+             * @param value Value to encode
+             * @return round(value * scale), saturated to Wire
+             */
+            [[nodiscard]] static Wire encode(double value) noexcept {
+                return detail::saturateCast<Wire>(detail::roundScaled<Mode>(value * scale));
+            }
+
+            /**
+             * @brief Reads stored integers from the front of a buffer
+             * @param buffer Source buffer
+             * @param values Receives the decoded values
+             * @return true if the buffer holds fewer than values.size() integers, false on success
+             */
+            template <std::endian Encoding, size_t N>
+            [[nodiscard]] static bool popFront(BasicReadBuffer<Encoding>& buffer, std::span<double, N> values) noexcept {
+                return popFrontScaled<Wire>(buffer, values, scale);
+            }
+
+            /**
+             * @brief Writes values to a buffer
+             * @param buffer Destination buffer
+             * @param values Values to encode
+             * @return true if the buffer has no room for values.size() integers, false on success
+             */
+            template <std::endian Encoding, size_t N>
+            [[nodiscard]] static bool pushBack(BasicWriteBuffer<Encoding>& buffer, const std::span<const double, N>& values) noexcept {
+                return pushBackScaled<Wire>(buffer, values, scale, Mode);
+            }
+
+            /**
+             * @brief Appends values to a vector
+             * @param vector Destination vector
+             * @param values Values to encode
+             */
+            template <std::endian Encoding, size_t N>
+            static void pushBack(BasicVector<Encoding>& vector, const std::span<const double, N>& values) noexcept {
+                pushBackScaled<Wire>(vector, values, scale, Mode);
+            }
+        };
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_FIXED_POINT_SSE2
+#undef MZ_ENDIAN_FIXED_POINT_SSE41
+
+#endif // MZ_ENDIAN_FIXED_POINT_HEADER_FILE
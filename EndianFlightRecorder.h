@@ -0,0 +1,361 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_FLIGHT_RECORDER_HEADER_FILE
+#define MZ_ENDIAN_FLIGHT_RECORDER_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianFlightRecorder.h
+ * @brief Crash-surviving, file-backed ring of framed telemetry records
+ *
+ * This header defines BasicFlightRecorder, a fixed-size ring buffer that lives
+ * in a memory-mapped file, and readFlightRecorder(), which decodes the most
+ * recent records from such a file after the process is gone.
+ *
+ * Appending is a single relaxed fetch_add on a cursor kept in the file header
+ * followed by plain stores into the mapping, so it costs the same as an
+ * in-memory ring and is safe from any number of threads. Because the stores go
+ * to the page cache, the operating system writes them back even if the
+ * process crashes.
+ *
+ * Every record carries its logical position (total bytes appended before it)
+ * at both ends, and the trailing copy is stored last with release ordering.
+ * The decoder walks backward from the cursor and accepts a record only if both
+ * copies match where it sits, which rejects records torn by the crash and
+ * stale records from earlier laps; on a mismatch it steps back eight bytes and
+ * resynchronizes.
+ *
+ * File layout (integers in Encoding unless noted):
+ *   [uint32_t magic][uint8_t version][uint8_t cursor byte order][uint16_t 0]
+ *   [uint64_t ring capacity][uint64_t cursor, native byte order][zeros to 64 bytes]
+ *   [ring]
+ *
+ * Record layout (8-byte aligned, never split by the ring end):
+ *   [uint32_t record size][uint32_t payload size][uint64_t position][payload][zeros]
+ *   [uint64_t position]
+ * Space skipped at the ring end is filled with 8-byte all-ones pad words.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+#include "EndianMappedFile.h"
+
+namespace mz {
+    namespace endian {
+
+        /// Magic number at the start of a flight recorder file ("MZFR")
+        static constexpr uint32_t flight_recorder_magic{ 0x52465A4DU };
+
+        /// Size of the flight recorder file header
+        static constexpr size_t flight_recorder_header_size{ 64 };
+
+        namespace detail {
+
+            static constexpr uint8_t flight_recorder_version{ 1 };
+            static constexpr size_t flight_record_overhead{ 24 };        ///< Sizes, leading and trailing position
+            static constexpr uint64_t flight_recorder_pad{ ~uint64_t{ 0 } };
+
+            [[nodiscard]] constexpr uint64_t flightRecordSize(size_t payloadSize) noexcept {
+                return (static_cast<uint64_t>(payloadSize) + flight_record_overhead + 7) & ~uint64_t{ 7 };
+            }
+
+            [[nodiscard]] constexpr uint8_t byteOrderTag(std::endian order) noexcept {
+                return order == std::endian::little ? 1 : 2;
+            }
+
+        } // namespace detail
+
+        /**
+         * @class BasicFlightRecorder
+         * @brief Lock-free appender to a file-backed ring of framed records
+         *
+         * Reopening a file whose header matches the capacity continues after the
+         * records already in it; any other file is reinitialized.
+         *
+         * Records are not checksummed, so the ring must be large enough that no
+         * writer stalls between reserving and storing a record while the others
+         * append a whole capacity worth of data; a writer that is lapped that way
+         * overwrites newer records with bytes the decoder may accept.
+         *
+         * @tparam Encoding Endianness of the record frames
+         */
+        template <std::endian Encoding>
+        class BasicFlightRecorder {
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs a closed recorder
+              */
+            explicit BasicFlightRecorder() noexcept = default;
+
+            BasicFlightRecorder(const BasicFlightRecorder&) = delete;
+            BasicFlightRecorder& operator=(const BasicFlightRecorder&) = delete;
+            /** @} */
+
+            /**
+             * @name File Operations
+             * @{
+             */
+
+             /**
+              * @brief Creates or reopens a recorder file
+              * @param path Path of the file
+              * @param capacity Ring size in bytes; rounded down to a multiple of 8, at least 64
+              * @return true if the capacity is too small or the file cannot be mapped, false on success
+              */
+            [[nodiscard]] bool open(const std::string& path, size_t capacity) noexcept {
+                close();
+                capacity &= ~size_t{ 7 };
+                if (capacity < 64 || m_file.create(path, flight_recorder_header_size + capacity)) {
+                    return true; // Error (bad capacity or cannot map)
+                }
+                uint8_t* header = m_file.writableData();
+                uint32_t magic = 0;
+                uint64_t storedCapacity = 0;
+                basicCopy<Encoding>(magic, header);
+                basicCopy<Encoding>(storedCapacity, header + 8);
+                if (magic != flight_recorder_magic || header[4] != detail::flight_recorder_version
+                    || header[5] != detail::byteOrderTag(std::endian::native) || storedCapacity != capacity) {
+                    // Fresh ring: old bytes could carry positions the new cursor will reach again
+                    std::memset(header, 0, m_file.size());
+                    basicCopy<Encoding>(header, flight_recorder_magic);
+                    header[4] = detail::flight_recorder_version;
+                    header[5] = detail::byteOrderTag(std::endian::native);
+                    basicCopy<Encoding>(header + 8, static_cast<uint64_t>(capacity));
+                }
+                m_cursor = reinterpret_cast<uint64_t*>(header + 16);
+                m_ring = header + flight_recorder_header_size;
+                m_capacity = capacity;
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Unmaps the file; records stay in it
+             */
+            void close() noexcept {
+                m_file.close();
+                m_cursor = nullptr;
+                m_ring = nullptr;
+                m_capacity = 0;
+            }
+
+            /**
+             * @brief Writes the ring back to disk
+             * @return true if the recorder is closed or the flush failed, false on success
+             *
+             * Only needed to survive power loss; a process crash loses nothing
+             * that append() has returned from.
+             */
+            [[nodiscard]] bool flush() noexcept {
+                return m_file.flush();
+            }
+            /** @} */
+
+            /**
+             * @name Appending
+             * @{
+             */
+
+             /**
+              * @brief Appends a record whose payload is written in place
+              * @tparam Fill Callable as void(BasicWriteBuffer<Encoding>&)
+              * @param payloadSize Exact number of bytes fill writes
+              * @param fill Writes the payload into a buffer of payloadSize bytes inside the ring
+              * @return true if the recorder is closed or the record is larger than the ring, false on success
+              */
+            template <typename Fill>
+            [[nodiscard]] bool append(size_t payloadSize, Fill&& fill) noexcept {
+                const uint64_t size = detail::flightRecordSize(payloadSize);
+                if (!m_ring || size > m_capacity) {
+                    return true; // Error (closed or record too large)
+                }
+                std::atomic_ref<uint64_t> cursor(*m_cursor);
+                while (true) {
+                    const uint64_t position = cursor.fetch_add(size, std::memory_order_relaxed);
+                    const size_t offset = static_cast<size_t>(position % m_capacity);
+                    if (offset + size <= m_capacity) {
+                        writeRecord(offset, position, size, payloadSize, fill);
+                        return false; // Success (no error)
+                    }
+                    // The reservation straddles the ring end: pad both pieces and reserve again
+                    writePad(offset, m_capacity - offset);
+                    writePad(0, static_cast<size_t>(offset + size - m_capacity));
+                }
+            }
+
+            /**
+             * @brief Appends a record with the given payload
+             * @param payload Payload bytes
+             * @return true if the recorder is closed or the record is larger than the ring, false on success
+             */
+            [[nodiscard]] bool append(std::span<const uint8_t> payload) noexcept {
+                return append(payload.size(), [payload](BasicWriteBuffer<Encoding>& buffer) {
+                    if (!payload.empty()) {
+                        buffer.unsafePushBack(payload);
+                    }
+                });
+            }
+            /** @} */
+
+            /**
+             * @name Accessors
+             * @{
+             */
+
+             /**
+              * @brief Gets the ring size
+              * @return Capacity in bytes, or 0 if closed
+              */
+            [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+            /**
+             * @brief Gets the number of bytes ever reserved, including padding
+             * @return Cursor value, or 0 if closed
+             */
+            [[nodiscard]] uint64_t position() const noexcept {
+                return m_cursor ? std::atomic_ref<uint64_t>(*m_cursor).load(std::memory_order_relaxed) : 0;
+            }
+            /** @} */
+
+        private:
+            MappedFile m_file;                ///< Header and ring
+            uint64_t* m_cursor{ nullptr };    ///< Cursor in the header, updated atomically
+            uint8_t* m_ring{ nullptr };       ///< First ring byte
+            size_t m_capacity{ 0 };           ///< Ring size in bytes
+
+            template <typename Fill>
+            void writeRecord(size_t offset, uint64_t position, uint64_t size, size_t payloadSize, Fill& fill) noexcept {
+                uint8_t* record = m_ring + offset;
+                BasicWriteBuffer<Encoding> frame(record, static_cast<size_t>(size));
+                frame.unsafePushBack(static_cast<uint32_t>(size));
+                frame.unsafePushBack(static_cast<uint32_t>(payloadSize));
+                frame.unsafePushBack(position);
+                BasicWriteBuffer<Encoding> payload(record + detail::flight_record_overhead - 8, payloadSize);
+                fill(payload);
+                const size_t used = detail::flight_record_overhead - 8 + payloadSize;
+                std::memset(record + used, 0, static_cast<size_t>(size) - 8 - used);
+
+                // Trailing position last, so a record is only complete once everything before it is stored
+                uint64_t trailer = 0;
+                basicCopy<Encoding>(&trailer, position);
+                std::atomic_ref<uint64_t>(*reinterpret_cast<uint64_t*>(record + size - 8)).store(trailer, std::memory_order_release);
+            }
+
+            void writePad(size_t offset, size_t bytes) noexcept {
+                std::memset(m_ring + offset, 0xFF, bytes);
+            }
+        };
+
+        /**
+         * @brief Decodes the most recent records of a flight recorder file, newest first
+         * @tparam Encoding Endianness the records were written with
+         * @tparam Visitor Callable as bool(uint64_t position, BasicReadBuffer<Encoding>& payload); return false to stop
+         * @param file Whole file contents, typically from MappedFile
+         * @param maxBytes Maximum number of ring bytes to walk back from the cursor
+         * @param visitor Callback
+         * @return true if the header is invalid or the file is truncated, false on success
+         *
+         * Works on files left behind by crashed processes and on files still
+         * being written, though records appended during the walk may be skipped.
+         */
+        template <std::endian Encoding, typename Visitor>
+        [[nodiscard]] bool readFlightRecorder(std::span<const uint8_t> file, uint64_t maxBytes, Visitor&& visitor) noexcept {
+            if (file.size() < flight_recorder_header_size) {
+                return true; // Error (truncated header)
+            }
+            const uint8_t* header = file.data();
+            uint32_t magic = 0;
+            uint64_t capacity = 0;
+            uint64_t cursor = 0;
+            basicCopy<Encoding>(magic, header);
+            basicCopy<Encoding>(capacity, header + 8);
+            if (header[5] == detail::byteOrderTag(std::endian::little)) {
+                basicCopy<std::endian::little>(cursor, header + 16);
+            }
+            else {
+                basicCopy<std::endian::big>(cursor, header + 16);
+            }
+            if (magic != flight_recorder_magic || header[4] != detail::flight_recorder_version || capacity < 64 || capacity % 8 != 0
+                || capacity > file.size() - flight_recorder_header_size || cursor % 8 != 0) {
+                return true; // Error (bad header or truncated ring)
+            }
+            const uint8_t* ring = header + flight_recorder_header_size;
+            const uint64_t floor = cursor - std::min({ cursor, capacity, maxBytes & ~uint64_t{ 7 } });
+
+            uint64_t end = cursor;
+            while (end - floor >= 8) {
+                const uint64_t endOffset = (end - 1) % capacity + 1;
+                uint64_t start = 0;
+                basicCopy<Encoding>(start, ring + endOffset - 8);
+                if (start == detail::flight_recorder_pad) {
+                    end -= 8;
+                    continue;
+                }
+                const uint64_t size = end - start;
+                if (start < end && start >= floor && size >= detail::flight_record_overhead && size % 8 == 0 && size <= endOffset) {
+                    const uint8_t* record = ring + endOffset - size;
+                    uint32_t storedSize = 0;
+                    uint32_t payloadSize = 0;
+                    uint64_t storedStart = 0;
+                    basicCopy<Encoding>(storedSize, record);
+                    basicCopy<Encoding>(payloadSize, record + 4);
+                    basicCopy<Encoding>(storedStart, record + 8);
+                    if (storedSize == size && storedStart == start && payloadSize <= size - detail::flight_record_overhead) {
+                        BasicReadBuffer<Encoding> payload(record + 16, payloadSize);
+                        if (!visitor(start, payload)) {
+                            return false; // Success (stopped by the visitor)
+                        }
+                        end = start;
+                        continue;
+                    }
+                }
+                end -= 8; // Torn or overwritten record: resynchronize on the previous word
+            }
+            return false; // Success (no error)
+        }
+
+        /**
+         * @brief Flight recorder that uses the default stream endianness
+         */
+        using FlightRecorder = BasicFlightRecorder<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_FLIGHT_RECORDER_HEADER_FILE
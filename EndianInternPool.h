@@ -0,0 +1,290 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_INTERN_POOL_HEADER_FILE
+#define MZ_ENDIAN_INTERN_POOL_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianInternPool.h
+ * @brief Concurrent interning pool for ByteArray keys
+ *
+ * This header defines InternPool, which stores each distinct ByteArray<N>
+ * exactly once and hands out a 32-bit handle for it. Two handles from the same
+ * pool are equal if and only if their keys are equal, so code that holds
+ * handles compares and hashes plain integers instead of N-byte arrays.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <bit>
+
+#include "EndianByteArray.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @class InternPool
+         * @brief Deduplicating, thread-safe store of ByteArray<N> values
+         *
+         * Keys are spread over 2^ShardBits shards by the high bits of
+         * generateHash(); each shard has its own mutex and open-addressing table,
+         * so concurrent interning only contends when two threads hit the same
+         * shard. Shards are cache-line aligned to avoid false sharing.
+         *
+         * Interned keys live in per-shard slabs that double in size and are never
+         * moved or freed before the pool is destroyed, so handles and references
+         * returned by get() stay valid for the lifetime of the pool, and get() does
+         * not take a lock.
+         *
+         * A handle is [shard : ShardBits][index : 32 - ShardBits].
+         *
+         * @tparam N Key size in bytes
+         * @tparam ShardBits log2 of the number of shards
+         */
+        template <size_t N, unsigned ShardBits = 4>
+            requires (N > 0 && ShardBits > 0 && ShardBits < 16)
+        class InternPool {
+        public:
+            /**
+             * @name Type Definitions and Constants
+             * @{
+             */
+            using key_type = ByteArray<N>;    ///< Interned value type
+            using handle_type = uint32_t;     ///< Handle type
+
+            static constexpr size_t shard_count{ size_t{ 1 } << ShardBits };        ///< Number of shards
+            static constexpr unsigned index_bits{ 32 - ShardBits };                   ///< Handle bits for the index
+            static constexpr handle_type invalid_handle{ 0xFFFFFFFFU };               ///< Never returned by intern()
+            static constexpr uint32_t max_per_shard{ (uint32_t{ 1 } << index_bits) - 1 }; ///< Keys per shard
+            /** @} */
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an empty pool
+              */
+            explicit InternPool() noexcept = default;
+
+            InternPool(const InternPool&) = delete;
+            InternPool& operator=(const InternPool&) = delete;
+
+            /**
+             * @brief Destructor; frees every slab
+             */
+            ~InternPool() noexcept {
+                for (Shard& shard : m_shards) {
+                    for (auto& slab : shard.slabs) {
+                        delete[] slab.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+            /** @} */
+
+            /**
+             * @name Interning
+             * @{
+             */
+
+             /**
+              * @brief Interns a key
+              * @param key Key to intern
+              * @param handle Receives the key's handle
+              * @return true if the key's shard is full, false on success
+              *
+              * Returns the existing handle if the key was interned before.
+              */
+            [[nodiscard]] bool intern(const key_type& key, handle_type& handle) noexcept {
+                const uint64_t hash = key.generateHash();
+                const size_t shardIndex = static_cast<size_t>(hash >> (64 - ShardBits));
+                Shard& shard = m_shards[shardIndex];
+
+                std::lock_guard<std::mutex> lock{ shard.mutex };
+                if (shard.slots.empty()) {
+                    shard.slots.resize(initial_table_size, 0);
+                    shard.hashes.resize(initial_table_size, 0);
+                }
+
+                const size_t mask = shard.slots.size() - 1;
+                size_t position = static_cast<size_t>(hash) & mask;
+                while (const uint32_t slot = shard.slots[position]) {
+                    if (shard.hashes[position] == hash && entry(shard, slot - 1) == key) {
+                        handle = makeHandle(shardIndex, slot - 1);
+                        return false; // Success (no error)
+                    }
+                    position = (position + 1) & mask;
+                }
+
+                const uint32_t index = shard.count.load(std::memory_order_relaxed);
+                if (index >= max_per_shard) {
+                    return true; // Error (shard full)
+                }
+                store(shard, index, key);
+                shard.slots[position] = index + 1;
+                shard.hashes[position] = hash;
+                shard.count.store(index + 1, std::memory_order_relaxed);
+
+                if (static_cast<size_t>(index + 1) * 2 > shard.slots.size()) {
+                    grow(shard);
+                }
+                handle = makeHandle(shardIndex, index);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Looks up the handle of a key without interning it
+             * @param key Key to look up
+             * @param handle Receives the key's handle if present
+             * @return true if the key has not been interned, false on success
+             */
+            [[nodiscard]] bool find(const key_type& key, handle_type& handle) const noexcept {
+                const uint64_t hash = key.generateHash();
+                const size_t shardIndex = static_cast<size_t>(hash >> (64 - ShardBits));
+                const Shard& shard = m_shards[shardIndex];
+
+                std::lock_guard<std::mutex> lock{ shard.mutex };
+                if (shard.slots.empty()) {
+                    return true; // Error (not found)
+                }
+                const size_t mask = shard.slots.size() - 1;
+                size_t position = static_cast<size_t>(hash) & mask;
+                while (const uint32_t slot = shard.slots[position]) {
+                    if (shard.hashes[position] == hash && entry(shard, slot - 1) == key) {
+                        handle = makeHandle(shardIndex, slot - 1);
+                        return false; // Success (no error)
+                    }
+                    position = (position + 1) & mask;
+                }
+                return true; // Error (not found)
+            }
+
+            /**
+             * @brief Gets the key behind a handle
+             * @param handle Handle returned by intern() or find() on this pool
+             * @return Reference to the interned key, valid for the lifetime of the pool
+             */
+            [[nodiscard]] const key_type& get(handle_type handle) const noexcept {
+                return entry(m_shards[handle >> index_bits], handle & max_per_shard);
+            }
+
+            /**
+             * @brief Gets the number of distinct keys interned so far
+             * @return Number of keys
+             */
+            [[nodiscard]] size_t size() const noexcept {
+                size_t total = 0;
+                for (const Shard& shard : m_shards) {
+                    total += shard.count.load(std::memory_order_relaxed);
+                }
+                return total;
+            }
+            /** @} */
+
+        private:
+            static constexpr size_t initial_table_size{ 64 };   ///< Table slots per shard on first use
+            static constexpr unsigned first_slab_bits{ 8 };     ///< First slab holds 256 keys
+            static constexpr size_t max_slabs{ index_bits - first_slab_bits + 1 };
+
+            /**
+             * @brief One lock domain: hash table plus slab directory
+             */
+            struct alignas(64) Shard {
+                mutable std::mutex mutex;
+                std::vector<uint32_t> slots;      ///< Key index + 1, or 0 if empty
+                std::vector<uint64_t> hashes;     ///< Full hash of each occupied slot
+                std::atomic<uint32_t> count{ 0 }; ///< Number of keys in the shard
+                std::array<std::atomic<key_type*>, max_slabs> slabs{}; ///< Slab k holds 2^(first_slab_bits + k) keys
+            };
+
+            std::array<Shard, shard_count> m_shards; ///< All shards
+
+            [[nodiscard]] static constexpr handle_type makeHandle(size_t shardIndex, uint32_t index) noexcept {
+                return static_cast<handle_type>(shardIndex << index_bits) | index;
+            }
+
+            /**
+             * @brief Splits a key index into slab number and offset within the slab
+             */
+            static constexpr void locate(uint32_t index, size_t& slab, size_t& offset) noexcept {
+                const uint32_t scaled = (index >> first_slab_bits) + 1;
+                slab = static_cast<size_t>(std::bit_width(scaled)) - 1;
+                offset = static_cast<size_t>(index) - ((size_t{ 1 } << (first_slab_bits + slab)) - (size_t{ 1 } << first_slab_bits));
+            }
+
+            [[nodiscard]] static const key_type& entry(const Shard& shard, uint32_t index) noexcept {
+                size_t slab = 0;
+                size_t offset = 0;
+                locate(index, slab, offset);
+                return shard.slabs[slab].load(std::memory_order_acquire)[offset];
+            }
+
+            static void store(Shard& shard, uint32_t index, const key_type& key) noexcept {
+                size_t slab = 0;
+                size_t offset = 0;
+                locate(index, slab, offset);
+                key_type* keys = shard.slabs[slab].load(std::memory_order_relaxed);
+                if (!keys) {
+                    keys = new key_type[size_t{ 1 } << (first_slab_bits + slab)];
+                    shard.slabs[slab].store(keys, std::memory_order_release);
+                }
+                keys[offset] = key;
+            }
+
+            /**
+             * @brief Doubles a shard's table and reinserts every slot
+             */
+            static void grow(Shard& shard) noexcept {
+                std::vector<uint32_t> slots(shard.slots.size() * 2, 0);
+                std::vector<uint64_t> hashes(slots.size(), 0);
+                const size_t mask = slots.size() - 1;
+                for (size_t i = 0; i < shard.slots.size(); ++i) {
+                    if (shard.slots[i]) {
+                        size_t position = static_cast<size_t>(shard.hashes[i]) & mask;
+                        while (slots[position]) {
+                            position = (position + 1) & mask;
+                        }
+                        slots[position] = shard.slots[i];
+                        hashes[position] = shard.hashes[i];
+                    }
+                }
+                shard.slots.swap(slots);
+                shard.hashes.swap(hashes);
+            }
+        };
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_INTERN_POOL_HEADER_FILE
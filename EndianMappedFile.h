@@ -0,0 +1,325 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_MAPPED_FILE_HEADER_FILE
+#define MZ_ENDIAN_MAPPED_FILE_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianMappedFile.h
+ * @brief Memory-mapped files exposed as endian-aware buffers
+ *
+ * This header defines MappedFile, a small owner of a file mapping that hands
+ * out the mapped bytes as a BasicReadBuffer. Files can be mapped read-only or,
+ * with create(), read-write at a fixed size so writes go straight to the page
+ * cache and survive a crash of the process. It uses mmap on POSIX systems and
+ * file mapping objects on Windows.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <span>
+#include <bit>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "EndianBasicBuffers.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @class MappedFile
+         * @brief Memory mapping of a whole file
+         *
+         * The mapping stays valid until close() or destruction; buffers obtained
+         * from it must not outlive it. Empty files open successfully with no
+         * mapping.
+         */
+        class MappedFile {
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs an object with no mapping
+              */
+            explicit MappedFile() noexcept = default;
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            /**
+             * @brief Move constructor; takes over the mapping
+             * @param other Object to move from; left with no mapping
+             */
+            MappedFile(MappedFile&& other) noexcept
+                : m_data{ other.m_data }, m_size{ other.m_size }, m_writable{ other.m_writable } {
+                other.m_data = nullptr;
+                other.m_size = 0;
+                other.m_writable = false;
+            }
+
+            /**
+             * @brief Move assignment; releases the current mapping first
+             * @param other Object to move from; left with no mapping
+             * @return Reference to this object
+             */
+            MappedFile& operator=(MappedFile&& other) noexcept {
+                if (this != &other) {
+                    close();
+                    m_data = other.m_data;
+                    m_size = other.m_size;
+                    m_writable = other.m_writable;
+                    other.m_data = nullptr;
+                    other.m_size = 0;
+                    other.m_writable = false;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Destructor; unmaps the file
+             */
+            ~MappedFile() noexcept {
+                close();
+            }
+            /** @} */
+
+            /**
+             * @name File Operations
+             * @{
+             */
+
+             /**
+              * @brief Maps a whole file for reading
+              * @param path Path of the file
+              * @return true if the file cannot be opened or mapped, false on success
+              */
+            [[nodiscard]] bool open(const std::string& path) noexcept {
+                close();
+#if defined(_WIN32)
+                HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file == INVALID_HANDLE_VALUE) {
+                    return true; // Error (cannot open)
+                }
+                LARGE_INTEGER size{};
+                if (!GetFileSizeEx(file, &size)) {
+                    CloseHandle(file);
+                    return true; // Error (cannot stat)
+                }
+                if (size.QuadPart > 0) {
+                    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mapping) {
+                        m_data = static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                        CloseHandle(mapping);
+                    }
+                    if (!m_data) {
+                        CloseHandle(file);
+                        return true; // Error (cannot map)
+                    }
+                    m_size = static_cast<size_t>(size.QuadPart);
+                }
+                CloseHandle(file);
+#else
+                const int file = ::open(path.c_str(), O_RDONLY);
+                if (file < 0) {
+                    return true; // Error (cannot open)
+                }
+                struct stat status {};
+                if (fstat(file, &status) != 0) {
+                    ::close(file);
+                    return true; // Error (cannot stat)
+                }
+                if (status.st_size > 0) {
+                    void* address = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+                    if (address == MAP_FAILED) {
+                        ::close(file);
+                        return true; // Error (cannot map)
+                    }
+                    m_data = static_cast<uint8_t*>(address);
+                    m_size = static_cast<size_t>(status.st_size);
+                }
+                ::close(file);
+#endif
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Maps a file for reading and writing, creating or resizing it first
+             * @param path Path of the file
+             * @param size Size of the file and the mapping in bytes (at least 1)
+             * @return true if the file cannot be created, resized or mapped, false on success
+             *
+             * Existing contents up to size are kept; bytes added by growing the
+             * file read as zero.
+             */
+            [[nodiscard]] bool create(const std::string& path, size_t size) noexcept {
+                close();
+                if (size == 0) {
+                    return true; // Error (empty mapping)
+                }
+#if defined(_WIN32)
+                HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file == INVALID_HANDLE_VALUE) {
+                    return true; // Error (cannot open)
+                }
+                LARGE_INTEGER end{};
+                end.QuadPart = static_cast<LONGLONG>(size);
+                if (!SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+                    CloseHandle(file);
+                    return true; // Error (cannot resize)
+                }
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+                if (mapping) {
+                    m_data = static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0));
+                    CloseHandle(mapping);
+                }
+                CloseHandle(file);
+                if (!m_data) {
+                    return true; // Error (cannot map)
+                }
+#else
+                const int file = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+                if (file < 0) {
+                    return true; // Error (cannot open)
+                }
+                if (ftruncate(file, static_cast<off_t>(size)) != 0) {
+                    ::close(file);
+                    return true; // Error (cannot resize)
+                }
+                void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+                ::close(file);
+                if (address == MAP_FAILED) {
+                    return true; // Error (cannot map)
+                }
+                m_data = static_cast<uint8_t*>(address);
+#endif
+                m_size = size;
+                m_writable = true;
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Writes modified pages of a writable mapping back to the file
+             * @return true if nothing is mapped writable or the flush failed, false on success
+             *
+             * Only needed for durability against power loss; after a process crash
+             * the operating system still writes back everything stored in the
+             * mapping.
+             */
+            [[nodiscard]] bool flush() noexcept {
+                if (!m_data || !m_writable) {
+                    return true; // Error (no writable mapping)
+                }
+#if defined(_WIN32)
+                return !FlushViewOfFile(m_data, 0);
+#else
+                return msync(m_data, m_size, MS_SYNC) != 0;
+#endif
+            }
+
+            /**
+             * @brief Unmaps the file
+             */
+            void close() noexcept {
+                if (m_data) {
+#if defined(_WIN32)
+                    UnmapViewOfFile(m_data);
+#else
+                    munmap(m_data, m_size);
+#endif
+                }
+                m_data = nullptr;
+                m_size = 0;
+                m_writable = false;
+            }
+            /** @} */
+
+            /**
+             * @name Accessors
+             * @{
+             */
+
+             /**
+              * @brief Gets the mapped bytes
+              * @return Pointer to the first byte, or nullptr if nothing is mapped
+              */
+            [[nodiscard]] const uint8_t* data() const noexcept { return m_data; }
+
+            /**
+             * @brief Gets the mapped bytes for writing
+             * @return Pointer to the first byte, or nullptr if the mapping is not writable
+             */
+            [[nodiscard]] uint8_t* writableData() noexcept { return m_writable ? m_data : nullptr; }
+
+            /**
+             * @brief Gets the mapped size
+             * @return Size in bytes
+             */
+            [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+            /**
+             * @brief Gets the mapped bytes as a span
+             * @return Span over the whole file
+             */
+            [[nodiscard]] std::span<const uint8_t> bytes() const noexcept { return { m_data, m_size }; }
+
+            /**
+             * @brief Gets the mapped bytes as a read buffer
+             * @tparam Encoding Endianness of the data in the file
+             * @return Buffer over the whole file
+             */
+            template <std::endian Encoding>
+            [[nodiscard]] BasicReadBuffer<Encoding> buffer() const noexcept {
+                return BasicReadBuffer<Encoding>(m_data, m_size);
+            }
+            /** @} */
+
+        private:
+            uint8_t* m_data{ nullptr };  ///< Mapped bytes, or nullptr
+            size_t m_size{ 0 };          ///< Mapped size in bytes
+            bool m_writable{ false };    ///< Mapped by create()
+        };
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_MAPPED_FILE_HEADER_FILE
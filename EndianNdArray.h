@@ -0,0 +1,522 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_NDARRAY_HEADER_FILE
+#define MZ_ENDIAN_NDARRAY_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianNdArray.h
+ * @brief N-dimensional numeric arrays with a shape header and aligned payload
+ *
+ * This header defines writeNdArray(), which appends a typed array with its
+ * shape and strides to a BasicVector, and BasicNdArrayView, which reads one
+ * back from a BasicReadBuffer, typically over a memory-mapped file.
+ *
+ * The payload starts at a multiple of 64 bytes from the start of the vector,
+ * so an array written into a vector that becomes a file at offset 0 is
+ * cache-line aligned in the mapping. Its byte order is recorded in the header.
+ * When that order is native, view() returns a span straight into the mapped
+ * bytes; otherwise copyTo() converts the whole payload in one pass, using
+ * SSSE3 byte shuffles when available.
+ *
+ * Layout (header integers in Encoding):
+ *   [uint32_t magic][uint8_t version][uint8_t dtype][uint8_t payload byte order][uint8_t rank]
+ *   [uint64_t payload offset from the array start][uint64_t payload bytes]
+ *   rank x [uint64_t extent] rank x [int64_t stride in elements]
+ *   [zeros to the payload offset][payload]
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <concepts>
+#include <span>
+#include <bit>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define MZ_ENDIAN_NDARRAY_SSSE3 1
+#endif
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Element type of an ndarray
+         *
+         * Floating-point elements are stored as the bits of the same-size
+         * unsigned integer.
+         */
+        enum class DType : uint8_t {
+            none,          ///< No type
+            int8 = 1,      ///< int8_t
+            uint8 = 2,     ///< uint8_t
+            int16 = 3,     ///< int16_t
+            uint16 = 4,    ///< uint16_t
+            int32 = 5,     ///< int32_t
+            uint32 = 6,    ///< uint32_t
+            int64 = 7,     ///< int64_t
+            uint64 = 8,    ///< uint64_t
+            float32 = 9,   ///< float (IEEE 754 binary32)
+            float64 = 10,  ///< double (IEEE 754 binary64)
+            invalid        ///< Invalid type
+        };
+
+        /**
+         * @brief Types that can be stored in an ndarray
+         */
+        template <typename T>
+        concept NdArrayElement = std::same_as<T, int8_t> || std::same_as<T, uint8_t> || std::same_as<T, int16_t>
+            || std::same_as<T, uint16_t> || std::same_as<T, int32_t> || std::same_as<T, uint32_t> || std::same_as<T, int64_t>
+            || std::same_as<T, uint64_t> || (std::same_as<T, float> && sizeof(float) == 4)
+            || (std::same_as<T, double> && sizeof(double) == 8);
+
+        /// Magic number at the start of an ndarray ("MZNA")
+        static constexpr uint32_t ndarray_magic{ 0x414E5A4DU };
+
+        /// Alignment of the payload from the start of the vector
+        static constexpr size_t ndarray_alignment{ 64 };
+
+        /// Largest supported number of dimensions
+        static constexpr size_t ndarray_max_rank{ 32 };
+
+        /**
+         * @brief Gets the dtype of an element type
+         * @tparam T Element type
+         * @return Matching DType
+         */
+        template <NdArrayElement T>
+        [[nodiscard]] constexpr DType dtypeOf() noexcept {
+            if constexpr (std::same_as<T, int8_t>) { return DType::int8; }
+            else if constexpr (std::same_as<T, uint8_t>) { return DType::uint8; }
+            else if constexpr (std::same_as<T, int16_t>) { return DType::int16; }
+            else if constexpr (std::same_as<T, uint16_t>) { return DType::uint16; }
+            else if constexpr (std::same_as<T, int32_t>) { return DType::int32; }
+            else if constexpr (std::same_as<T, uint32_t>) { return DType::uint32; }
+            else if constexpr (std::same_as<T, int64_t>) { return DType::int64; }
+            else if constexpr (std::same_as<T, uint64_t>) { return DType::uint64; }
+            else if constexpr (std::same_as<T, float>) { return DType::float32; }
+            else { return DType::float64; }
+        }
+
+        /**
+         * @brief Gets the element size of a dtype
+         * @param type Element type
+         * @return Size in bytes, or 0 for none and invalid
+         */
+        [[nodiscard]] constexpr size_t dtypeSize(DType type) noexcept {
+            switch (type) {
+            case DType::int8: case DType::uint8: return 1;
+            case DType::int16: case DType::uint16: return 2;
+            case DType::int32: case DType::uint32: case DType::float32: return 4;
+            case DType::int64: case DType::uint64: case DType::float64: return 8;
+            default: return 0;
+            }
+        }
+
+        namespace detail {
+
+            static constexpr uint8_t ndarray_version{ 1 };
+            static constexpr size_t ndarray_header_size{ 24 };
+
+            [[nodiscard]] constexpr uint8_t ndarrayOrderTag(std::endian order) noexcept {
+                return order == std::endian::little ? 1 : 2;
+            }
+
+            /**
+             * @brief Copies elements while reversing the bytes of each
+             * @param destination Output bytes; may not overlap source
+             * @param source Input bytes
+             * @param count Number of elements
+             * @param elementSize Element size: 1, 2, 4 or 8
+             */
+            inline void swapElements(uint8_t* destination, const uint8_t* source, size_t count, size_t elementSize) noexcept {
+                if (elementSize == 1) {
+                    if (count != 0) {
+                        std::memcpy(destination, source, count);
+                    }
+                    return;
+                }
+                size_t i = 0;
+                const size_t bytes = count * elementSize;
+#if defined(MZ_ENDIAN_NDARRAY_SSSE3)
+                const __m128i shuffle = elementSize == 2 ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                    : elementSize == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                    : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+                for (; i + 16 <= bytes; i += 16) {
+                    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_shuffle_epi8(block, shuffle));
+                }
+#endif
+                for (; i < bytes; i += elementSize) {
+                    if (elementSize == 2) {
+                        uint16_t value = 0;
+                        std::memcpy(&value, source + i, 2);
+                        value = byteSwap(value);
+                        std::memcpy(destination + i, &value, 2);
+                    }
+                    else if (elementSize == 4) {
+                        uint32_t value = 0;
+                        std::memcpy(&value, source + i, 4);
+                        value = byteSwap(value);
+                        std::memcpy(destination + i, &value, 4);
+                    }
+                    else {
+                        uint64_t value = 0;
+                        std::memcpy(&value, source + i, 8);
+                        value = byteSwap(value);
+                        std::memcpy(destination + i, &value, 8);
+                    }
+                }
+            }
+
+            /**
+             * @brief Checks that every index of a strided array lands inside its elements
+             * @return true if a stride is negative or some index reaches count or beyond
+             *
+             * Reaches are bounded before they are multiplied or added, so hostile
+             * strides cannot overflow.
+             */
+            [[nodiscard]] inline bool ndarrayStridesOutside(const uint64_t* shape, const int64_t* strides, size_t rank, uint64_t count) noexcept {
+                if (count == 0) {
+                    return false; // Success (no element to reach)
+                }
+                uint64_t high = 0;
+                for (size_t d = 0; d < rank; ++d) {
+                    const uint64_t extent = shape[d] - 1;
+                    if (extent == 0) {
+                        continue;
+                    }
+                    if (strides[d] < 0) {
+                        return true; // Error (reaches before the first element)
+                    }
+                    const uint64_t step = static_cast<uint64_t>(strides[d]);
+                    if (step > (count - 1) / extent || step * extent > count - 1 - high) {
+                        return true; // Error (reaches past the last element)
+                    }
+                    high += step * extent;
+                }
+                return false; // Success (no error)
+            }
+
+        } // namespace detail
+
+        /**
+         * @brief Appends an ndarray to a vector
+         * @tparam Encoding Endianness of the header
+         * @tparam T Element type
+         * @param vector Destination vector; padding is inserted so the payload is 64-byte aligned within it
+         * @param data Elements, stored contiguously
+         * @param shape Extent of each dimension (at most ndarray_max_rank)
+         * @param strides Element step of each dimension; empty for row-major (C order)
+         * @param payloadOrder Byte order of the stored elements
+         * @return true if the rank is too large, the shape does not match the element
+         *         count, or the strides reach outside the data, false on success
+         */
+        template <std::endian Encoding, NdArrayElement T>
+        [[nodiscard]] bool writeNdArray(BasicVector<Encoding>& vector, std::span<const T> data, std::span<const uint64_t> shape,
+            std::span<const int64_t> strides = {}, std::endian payloadOrder = Encoding) noexcept {
+            if (shape.size() > ndarray_max_rank || (!strides.empty() && strides.size() != shape.size())) {
+                return true; // Error (bad rank)
+            }
+            uint64_t count = 1;
+            for (const uint64_t extent : shape) {
+                if (extent != 0 && count > UINT64_MAX / extent) {
+                    return true; // Error (shape overflows)
+                }
+                count *= extent;
+            }
+            if (count != data.size()) {
+                return true; // Error (shape does not match the data)
+            }
+            std::array<int64_t, ndarray_max_rank> steps{};
+            if (strides.empty()) {
+                int64_t step = 1;
+                for (size_t d = shape.size(); d-- > 0;) {
+                    steps[d] = step;
+                    step *= static_cast<int64_t>(shape[d]);
+                }
+            }
+            else {
+                if (detail::ndarrayStridesOutside(shape.data(), strides.data(), shape.size(), count)) {
+                    return true; // Error (strides reach outside the data)
+                }
+                for (size_t d = 0; d < shape.size(); ++d) {
+                    steps[d] = strides[d];
+                }
+            }
+
+            const size_t start = vector.size();
+            const size_t headerEnd = start + detail::ndarray_header_size + shape.size() * 16;
+            const size_t payloadStart = (headerEnd + ndarray_alignment - 1) & ~(ndarray_alignment - 1);
+            const size_t payloadBytes = data.size() * sizeof(T);
+            vector.pushBack(ndarray_magic);
+            vector.pushBack(detail::ndarray_version);
+            vector.pushBack(static_cast<uint8_t>(dtypeOf<T>()));
+            vector.pushBack(detail::ndarrayOrderTag(payloadOrder));
+            vector.pushBack(static_cast<uint8_t>(shape.size()));
+            vector.pushBack(static_cast<uint64_t>(payloadStart - start));
+            vector.pushBack(static_cast<uint64_t>(payloadBytes));
+            for (const uint64_t extent : shape) {
+                vector.pushBack(extent);
+            }
+            for (size_t d = 0; d < shape.size(); ++d) {
+                vector.pushBack(steps[d]);
+            }
+            vector.expandBy(payloadStart - headerEnd + payloadBytes);
+            uint8_t* payload = vector.data() + payloadStart;
+            std::memset(vector.data() + headerEnd, 0, payloadStart - headerEnd);
+            if (payloadOrder == std::endian::native) {
+                if (payloadBytes != 0) {
+                    std::memcpy(payload, data.data(), payloadBytes);
+                }
+            }
+            else {
+                detail::swapElements(payload, reinterpret_cast<const uint8_t*>(data.data()), data.size(), sizeof(T));
+            }
+            return false; // Success (no error)
+        }
+
+        /**
+         * @class BasicNdArrayView
+         * @brief Read-only view of an ndarray inside a buffer
+         *
+         * The view points into the buffer it was opened from, which must
+         * outlive it.
+         *
+         * @tparam Encoding Endianness of the header
+         */
+        template <std::endian Encoding>
+        class BasicNdArrayView {
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs an empty view
+              */
+            explicit BasicNdArrayView() noexcept = default;
+            /** @} */
+
+            /**
+             * @name Opening
+             * @{
+             */
+
+             /**
+              * @brief Opens the ndarray at the front of a buffer and consumes it
+              * @param buffer Buffer positioned where writeNdArray() started writing
+              * @return true if the header is invalid, the strides reach outside the
+              *         payload or the buffer is too short, false on success
+              */
+            [[nodiscard]] bool open(BasicReadBuffer<Encoding>& buffer) noexcept {
+                *this = BasicNdArrayView{};
+                if (buffer.size() < detail::ndarray_header_size) {
+                    return true; // Error (truncated header)
+                }
+                const uint8_t* start = buffer.data();
+                uint32_t magic = 0;
+                uint8_t version = 0;
+                uint8_t dtype = 0;
+                uint8_t order = 0;
+                uint8_t rank = 0;
+                uint64_t payloadOffset = 0;
+                uint64_t payloadBytes = 0;
+                BasicReadBuffer<Encoding> header(start, buffer.size());
+                header.unsafePopFront(magic);
+                header.unsafePopFront(version);
+                header.unsafePopFront(dtype);
+                header.unsafePopFront(order);
+                header.unsafePopFront(rank);
+                header.unsafePopFront(payloadOffset);
+                header.unsafePopFront(payloadBytes);
+                const size_t elementSize = dtypeSize(static_cast<DType>(dtype));
+                if (magic != ndarray_magic || version != detail::ndarray_version || elementSize == 0
+                    || (order != detail::ndarrayOrderTag(std::endian::little) && order != detail::ndarrayOrderTag(std::endian::big))
+                    || rank > ndarray_max_rank || header.size() < size_t{ rank } * 16
+                    || payloadOffset < detail::ndarray_header_size + size_t{ rank } * 16
+                    || payloadOffset > buffer.size() || payloadBytes > buffer.size() - payloadOffset
+                    || payloadBytes % elementSize != 0) {
+                    return true; // Error (bad header or truncated array)
+                }
+                uint64_t count = 1;
+                for (size_t d = 0; d < rank; ++d) {
+                    header.unsafePopFront(m_shape[d]);
+                    count = m_shape[d] != 0 && count > UINT64_MAX / m_shape[d] ? UINT64_MAX : count * m_shape[d];
+                }
+                for (size_t d = 0; d < rank; ++d) {
+                    header.unsafePopFront(m_strides[d]);
+                }
+                if (count != payloadBytes / elementSize) {
+                    return true; // Error (shape does not match the payload)
+                }
+                if (detail::ndarrayStridesOutside(m_shape.data(), m_strides.data(), rank, count)) {
+                    return true; // Error (strides reach outside the payload)
+                }
+                m_payload = start + payloadOffset;
+                m_size = static_cast<size_t>(count);
+                m_type = static_cast<DType>(dtype);
+                m_order = order == detail::ndarrayOrderTag(std::endian::little) ? std::endian::little : std::endian::big;
+                m_rank = rank;
+                buffer.skipFront(static_cast<size_t>(payloadOffset + payloadBytes));
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Accessors
+             * @{
+             */
+
+             /**
+              * @brief Gets the element type
+              * @return DType, or DType::none if nothing is open
+              */
+            [[nodiscard]] DType dtype() const noexcept { return m_type; }
+
+            /**
+             * @brief Gets the byte order of the stored elements
+             * @return Payload byte order
+             */
+            [[nodiscard]] std::endian byteOrder() const noexcept { return m_order; }
+
+            /**
+             * @brief Gets the number of dimensions
+             * @return Rank
+             */
+            [[nodiscard]] size_t rank() const noexcept { return m_rank; }
+
+            /**
+             * @brief Gets the extent of each dimension
+             * @return Span of rank() extents
+             */
+            [[nodiscard]] std::span<const uint64_t> shape() const noexcept { return { m_shape.data(), m_rank }; }
+
+            /**
+             * @brief Gets the element step of each dimension
+             * @return Span of rank() strides
+             */
+            [[nodiscard]] std::span<const int64_t> strides() const noexcept { return { m_strides.data(), m_rank }; }
+
+            /**
+             * @brief Gets the number of elements
+             * @return Element count
+             */
+            [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+            /**
+             * @brief Gets the payload as stored
+             * @return Span over the payload bytes
+             */
+            [[nodiscard]] std::span<const uint8_t> bytes() const noexcept { return { m_payload, m_size * dtypeSize(m_type) }; }
+
+            /**
+             * @brief Gets the offset of an element in the payload
+             * @param index One index per dimension
+             * @return Element offset, as used with view() or copyTo()
+             */
+            [[nodiscard]] size_t offset(std::span<const uint64_t> index) const noexcept {
+                int64_t position = 0;
+                for (size_t d = 0; d < m_rank; ++d) {
+                    position += m_strides[d] * static_cast<int64_t>(index[d]);
+                }
+                return static_cast<size_t>(position);
+            }
+            /** @} */
+
+            /**
+             * @name Element Access
+             * @{
+             */
+
+             /**
+              * @brief Gets the elements in place, without copying
+              * @tparam T Element type; must match dtype()
+              * @param elements Receives a span over the payload
+              * @return true if T does not match, the byte order is not native, or
+              *         the payload is not aligned for T, false on success
+              */
+            template <NdArrayElement T>
+            [[nodiscard]] bool view(std::span<const T>& elements) const noexcept {
+                if (m_type != dtypeOf<T>() || m_order != std::endian::native
+                    || reinterpret_cast<uintptr_t>(m_payload) % alignof(T) != 0) {
+                    return true; // Error (type, byte order or alignment mismatch)
+                }
+                elements = std::span<const T>(reinterpret_cast<const T*>(m_payload), m_size);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Copies the elements out, converting them to native byte order
+             * @tparam T Element type; must match dtype()
+             * @param elements Destination of exactly size() elements
+             * @return true if T or the size does not match, false on success
+             */
+            template <NdArrayElement T>
+            [[nodiscard]] bool copyTo(std::span<T> elements) const noexcept {
+                if (m_type != dtypeOf<T>() || elements.size() != m_size) {
+                    return true; // Error (type or size mismatch)
+                }
+                if (m_order == std::endian::native) {
+                    if (m_size != 0) {
+                        std::memcpy(elements.data(), m_payload, m_size * sizeof(T));
+                    }
+                }
+                else {
+                    detail::swapElements(reinterpret_cast<uint8_t*>(elements.data()), m_payload, m_size, sizeof(T));
+                }
+                return false; // Success (no error)
+            }
+            /** @} */
+
+        private:
+            const uint8_t* m_payload{ nullptr };                    ///< First payload byte
+            size_t m_size{ 0 };                                     ///< Element count
+            DType m_type{ DType::none };                            ///< Element type
+            std::endian m_order{ std::endian::native };             ///< Payload byte order
+            size_t m_rank{ 0 };                                     ///< Number of dimensions
+            std::array<uint64_t, ndarray_max_rank> m_shape{};       ///< Extents
+            std::array<int64_t, ndarray_max_rank> m_strides{};      ///< Element steps
+        };
+
+        /**
+         * @brief Ndarray view that uses the default stream endianness
+         */
+        using NdArrayView = BasicNdArrayView<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_NDARRAY_SSSE3
+
+#endif // MZ_ENDIAN_NDARRAY_HEADER_FILE
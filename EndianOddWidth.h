@@ -0,0 +1,270 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_ODD_WIDTH_HEADER_FILE
+#define MZ_ENDIAN_ODD_WIDTH_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianOddWidth.h
+ * @brief Endian-aware copies of integers stored in 1 to 8 bytes
+ *
+ * This header provides basicCopyN, the odd-width counterpart of basicCopy,
+ * used by the pushBackN/popFrontN members of the buffers and BasicVector.
+ * Values are stored in their low Bytes bytes in either byte order; on reading,
+ * signed types are sign-extended from the top stored bit.
+ *
+ * The span overloads widen or narrow sixteen bytes at a time with SSSE3
+ * shuffles when available, so packed 24- or 48-bit arrays decode at memory
+ * speed; the remaining elements use the scalar path.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <concepts>
+#include <type_traits>
+#include <span>
+#include <bit>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define MZ_ENDIAN_ODD_WIDTH_SSSE3 1
+#endif
+
+#include "EndianConversions.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Integer types that can be stored in Bytes bytes
+         *
+         * Bytes must be between 1 and 8 and no larger than the type.
+         */
+        template <typename T, size_t Bytes>
+        concept OddWidthType = std::integral<std::remove_const_t<T>> && !std::same_as<std::remove_const_t<T>, bool>
+            && Bytes >= 1 && Bytes <= 8 && Bytes <= sizeof(T);
+
+        namespace detail {
+
+            /**
+             * @brief Converts the low Bytes bytes of a value to their stored form, as a little-endian word
+             */
+            template <std::endian Encoding, size_t Bytes>
+            [[nodiscard]] constexpr uint64_t oddWidthEncode(uint64_t value) noexcept {
+                if constexpr (Encoding == std::endian::big) {
+                    value = byteSwap(value) >> (64 - 8 * Bytes);
+                }
+                if constexpr (std::endian::native == std::endian::big) {
+                    value = byteSwap(value);
+                }
+                return value;
+            }
+
+            /**
+             * @brief Converts a word loaded from the stored bytes back to its value
+             */
+            template <std::endian Encoding, size_t Bytes, typename T>
+            [[nodiscard]] constexpr T oddWidthDecode(uint64_t word) noexcept {
+                if constexpr (std::endian::native == std::endian::big) {
+                    word = byteSwap(word);
+                }
+                if constexpr (Encoding == std::endian::big) {
+                    word = byteSwap(word) >> (64 - 8 * Bytes);
+                }
+                if constexpr (std::is_signed_v<T> && Bytes < 8) {
+                    return static_cast<T>(static_cast<int64_t>(word << (64 - 8 * Bytes)) >> (64 - 8 * Bytes));
+                }
+                else {
+                    return static_cast<T>(word);
+                }
+            }
+
+#if defined(MZ_ENDIAN_ODD_WIDTH_SSSE3)
+            /**
+             * @brief Shuffle that spreads packed Bytes-wide values into Size-wide lanes
+             *
+             * For signed values the stored bytes go to the top of each lane, so an
+             * arithmetic shift can sign-extend them; otherwise they go to the bottom.
+             */
+            template <std::endian Encoding, size_t Bytes, size_t Size, bool High>
+            [[nodiscard]] constexpr std::array<int8_t, 16> oddWidthWidenMask() noexcept {
+                std::array<int8_t, 16> mask{};
+                for (size_t lane = 0; lane < 16 / Size; ++lane) {
+                    for (size_t byte = 0; byte < Size; ++byte) {
+                        const size_t from = High ? byte + Bytes - Size : byte;
+                        const bool stored = High ? byte >= Size - Bytes : byte < Bytes;
+                        const size_t source = lane * Bytes + (Encoding == std::endian::little ? from : Bytes - 1 - from);
+                        mask[lane * Size + byte] = stored ? static_cast<int8_t>(source) : int8_t{ -128 };
+                    }
+                }
+                return mask;
+            }
+
+            /**
+             * @brief Shuffle that packs the low Bytes bytes of Size-wide lanes
+             */
+            template <std::endian Encoding, size_t Bytes, size_t Size>
+            [[nodiscard]] constexpr std::array<int8_t, 16> oddWidthNarrowMask() noexcept {
+                std::array<int8_t, 16> mask{};
+                for (size_t i = 0; i < 16; ++i) {
+                    mask[i] = int8_t{ -128 };
+                }
+                for (size_t lane = 0; lane < 16 / Size; ++lane) {
+                    for (size_t byte = 0; byte < Bytes; ++byte) {
+                        const size_t source = Encoding == std::endian::little ? byte : Bytes - 1 - byte;
+                        mask[lane * Bytes + byte] = static_cast<int8_t>(lane * Size + source);
+                    }
+                }
+                return mask;
+            }
+#endif
+
+        } // namespace detail
+
+        /**
+         * @brief Copies the low Bytes bytes of a value to memory
+         *
+         * @tparam Encoding Byte order of the stored bytes
+         * @tparam Bytes Number of bytes to store (1 to 8)
+         * @tparam T Integer type of the value
+         * @param destination Destination memory address
+         * @param value Value to copy; higher bytes are dropped
+         */
+        template <std::endian Encoding, size_t Bytes, typename T>
+            requires OddWidthType<T, Bytes>
+        inline void basicCopyN(void* destination, T value) noexcept {
+            const uint64_t word = detail::oddWidthEncode<Encoding, Bytes>(static_cast<uint64_t>(value));
+            std::memcpy(destination, &word, Bytes);
+        }
+
+        /**
+         * @brief Copies a span of values to memory, Bytes bytes per value
+         *
+         * @tparam Encoding Byte order of the stored bytes
+         * @tparam Bytes Number of bytes to store per value (1 to 8)
+         * @tparam T Integer type of the values
+         * @tparam N Size of the span (can be dynamic_extent)
+         * @param destination Destination memory address; receives Bytes * source.size() bytes
+         * @param source Span of values; higher bytes are dropped
+         */
+        template <std::endian Encoding, size_t Bytes, typename T, size_t N>
+            requires OddWidthType<T, Bytes>
+        inline void basicCopyN(void* destination, const std::span<T, N>& source) noexcept {
+            uint8_t* out = static_cast<uint8_t*>(destination);
+            const size_t count = source.size();
+            size_t i = 0;
+#if defined(MZ_ENDIAN_ODD_WIDTH_SSSE3)
+            constexpr size_t size = sizeof(T);
+            if constexpr (size > 1 && Bytes < size && (size == 2 || size == 4 || size == 8)) {
+                constexpr size_t lanes = 16 / size;
+                static constexpr auto mask = detail::oddWidthNarrowMask<Encoding, Bytes, size>();
+                const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask.data()));
+                const uint8_t* in = reinterpret_cast<const uint8_t*>(source.data());
+                // Each step stores 16 bytes but advances lanes * Bytes, so stop while a full store still fits
+                for (; i + lanes <= count && i * Bytes + 16 <= count * Bytes; i += lanes) {
+                    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * size));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * Bytes), _mm_shuffle_epi8(block, shuffle));
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                basicCopyN<Encoding, Bytes>(out + i * Bytes, source[i]);
+            }
+        }
+
+        /**
+         * @brief Copies Bytes bytes from memory to a value
+         *
+         * @tparam Encoding Byte order of the stored bytes
+         * @tparam Bytes Number of stored bytes (1 to 8)
+         * @tparam T Integer type of the value; signed types are sign-extended
+         * @param destination Reference to the destination value
+         * @param source Source memory address
+         */
+        template <std::endian Encoding, size_t Bytes, typename T>
+            requires OddWidthType<T, Bytes> && (!std::is_const_v<T>)
+        inline void basicCopyN(T& destination, const void* source) noexcept {
+            uint64_t word = 0;
+            std::memcpy(&word, source, Bytes);
+            destination = detail::oddWidthDecode<Encoding, Bytes, T>(word);
+        }
+
+        /**
+         * @brief Copies Bytes bytes per value from memory to a span of values
+         *
+         * @tparam Encoding Byte order of the stored bytes
+         * @tparam Bytes Number of stored bytes per value (1 to 8)
+         * @tparam T Integer type of the values; signed types are sign-extended
+         * @tparam N Size of the span (can be dynamic_extent)
+         * @param destination Span of destination values
+         * @param source Source memory address; holds Bytes * destination.size() bytes
+         */
+        template <std::endian Encoding, size_t Bytes, typename T, size_t N>
+            requires OddWidthType<T, Bytes> && (!std::is_const_v<T>)
+        inline void basicCopyN(std::span<T, N> destination, const void* source) noexcept {
+            const uint8_t* in = static_cast<const uint8_t*>(source);
+            const size_t count = destination.size();
+            size_t i = 0;
+#if defined(MZ_ENDIAN_ODD_WIDTH_SSSE3)
+            constexpr size_t size = sizeof(T);
+            if constexpr (size > 1 && Bytes < size && (size == 2 || size == 4 || size == 8)) {
+                constexpr size_t lanes = 16 / size;
+                constexpr bool sign = std::is_signed_v<T> && size != 8;
+                static constexpr auto mask = detail::oddWidthWidenMask<Encoding, Bytes, size, sign>();
+                const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask.data()));
+                uint8_t* out = reinterpret_cast<uint8_t*>(destination.data());
+                // Each step loads 16 bytes but consumes lanes * Bytes, so stop while a full load stays in bounds
+                for (; i + lanes <= count && i * Bytes + 16 <= count * Bytes; i += lanes) {
+                    __m128i block = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * Bytes)), shuffle);
+                    if constexpr (sign && size == 2) {
+                        block = _mm_srai_epi16(block, static_cast<int>(16 - 8 * Bytes));
+                    }
+                    else if constexpr (sign && size == 4) {
+                        block = _mm_srai_epi32(block, static_cast<int>(32 - 8 * Bytes));
+                    }
+                    else if constexpr (std::is_signed_v<T> && size == 8) {
+                        // No 64-bit arithmetic shift in SSE: flip the sign bit and subtract it back
+                        const __m128i top = _mm_set1_epi64x(int64_t{ 1 } << (8 * Bytes - 1));
+                        block = _mm_sub_epi64(_mm_xor_si128(block, top), top);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * size), block);
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                basicCopyN<Encoding, Bytes>(destination[i], in + i * Bytes);
+            }
+        }
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_ODD_WIDTH_SSSE3
+
+#endif // MZ_ENDIAN_ODD_WIDTH_HEADER_FILE
@@ -0,0 +1,572 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_OFFSET_PTR_HEADER_FILE
+#define MZ_ENDIAN_OFFSET_PTR_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianOffsetPtr.h
+ * @brief Relocatable offset-pointer layouts usable in place without deserialization
+ *
+ * This header defines field types that live inside one contiguous blob and
+ * refer to each other with offsets relative to their own address, so the blob
+ * can be copied, written to a file and mmapped anywhere without fix-ups:
+ * - PackedValue<T>: An integer stored in stream_endian
+ * - OffsetPtr<T>: A relative pointer to another layout object
+ * - OffsetArray<T>: A relative pointer plus a count, for integers or layout objects
+ * - OffsetString: A relative pointer plus a length, read as std::string_view
+ * - OffsetHashMap<K, V>: An open-addressing hash table from integer or ByteArray keys
+ *
+ * All of them are byte arrays with alignment 1, so user structs built from
+ * them (see OffsetLayout) can be read straight from an mmapped file. Integers
+ * are pinned to stream_endian and converted on access, which is free on hosts
+ * that share that byte order.
+ *
+ * OffsetPtr and OffsetArray accept a type that is still being defined, so
+ * layouts can refer to themselves, for example a linked list:
+ *
+ *   struct Node {
+ *       PackedValue<int32_t> value;
+ *       OffsetString name;
+ *       OffsetPtr<Node> next;
+ *   };
+ *
+ * OffsetBlobWriter builds a blob; openOffsetBlob() validates its header and
+ * returns the root object. The blob is trusted after that: offsets are not
+ * checked on every access.
+ *
+ * Blob layout:
+ *   [uint32_t magic][uint32_t 0][uint64_t blob size][root object][other objects]
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <concepts>
+#include <string_view>
+#include <type_traits>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianByteArray.h"
+#include "EndianBitOps.h"
+#include "EndianSearchTree.h"
+
+namespace mz {
+    namespace endian {
+
+        /// Magic number at the start of an offset blob ("MZOB")
+        static constexpr uint32_t offset_blob_magic{ 0x424F5A4DU };
+
+        /// Size of the offset blob header; the root object follows it
+        static constexpr size_t offset_blob_header_size{ 16 };
+
+        /**
+         * @brief Types that can be placed in a blob and read in place
+         *
+         * Every field type in this header qualifies, as does any standard-layout
+         * struct made only of them.
+         */
+        template <typename T>
+        concept OffsetLayout = std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T> && alignof(T) == 1;
+
+        namespace detail {
+
+            /**
+             * @brief Follows a relative offset stored at a field
+             */
+            [[nodiscard]] inline const uint8_t* resolveOffset(const uint8_t* field) noexcept {
+                int64_t offset = 0;
+                basicCopy<stream_endian>(offset, field);
+                return offset ? field + offset : nullptr;
+            }
+
+            [[nodiscard]] inline uint64_t loadStream64(const uint8_t* field) noexcept {
+                uint64_t value = 0;
+                basicCopy<stream_endian>(value, field);
+                return value;
+            }
+
+            template <std::integral Key>
+            [[nodiscard]] uint64_t offsetKeyHash(const Key& key) noexcept {
+                return mix64(static_cast<uint64_t>(key));
+            }
+
+            template <size_t N>
+            [[nodiscard]] uint64_t offsetKeyHash(const ByteArray<N>& key) noexcept {
+                return mix64(key.generateHash());
+            }
+
+            /**
+             * @brief Control byte of an occupied hash slot: high bit set, 7 hash bits
+             */
+            [[nodiscard]] constexpr uint8_t offsetHashTag(uint64_t hash) noexcept {
+                return static_cast<uint8_t>(0x80 | (hash >> 57));
+            }
+
+        } // namespace detail
+
+        /**
+         * @class PackedValue
+         * @brief An integer or enum stored in stream_endian with alignment 1
+         * @tparam T Value type
+         */
+        template <SwapType T>
+        class PackedValue {
+        public:
+            /**
+             * @brief Reads the value
+             * @return Value in native byte order
+             */
+            [[nodiscard]] T get() const noexcept {
+                T value{};
+                basicCopy<stream_endian>(value, m_bytes);
+                return value;
+            }
+
+        private:
+            uint8_t m_bytes[sizeof(T)];  ///< Value in stream_endian
+        };
+
+        /**
+         * @class OffsetPtr
+         * @brief Relative pointer to a layout object in the same blob
+         *
+         * Stored as a signed 64-bit distance from the pointer itself to its
+         * target; 0 means null. T may still be incomplete where the pointer is
+         * declared, so a layout can point to its own type; it must satisfy
+         * OffsetLayout once the pointer is followed.
+         *
+         * @tparam T Target layout type
+         */
+        template <typename T>
+        class OffsetPtr {
+        public:
+            /**
+             * @brief Resolves the pointer
+             * @return Target object, or nullptr
+             */
+            [[nodiscard]] const T* get() const noexcept {
+                static_assert(OffsetLayout<T>, "OffsetPtr target must be an OffsetLayout type");
+                return reinterpret_cast<const T*>(detail::resolveOffset(m_bytes));
+            }
+
+            [[nodiscard]] const T& operator*() const noexcept { return *get(); }
+            [[nodiscard]] const T* operator->() const noexcept { return get(); }
+            [[nodiscard]] explicit operator bool() const noexcept { return get() != nullptr; }
+
+        private:
+            uint8_t m_bytes[8];  ///< Relative offset in stream_endian
+        };
+
+        /**
+         * @class OffsetArray
+         * @brief Relative pointer to a run of integers or layout objects
+         * @tparam T Element type: an integer/enum (returned by value) or a layout type (returned by
+         *         reference); like OffsetPtr, it may be incomplete where the array is declared
+         */
+        template <typename T>
+        class OffsetArray {
+        public:
+            /**
+             * @brief Gets the number of elements
+             * @return Element count
+             */
+            [[nodiscard]] size_t size() const noexcept {
+                return static_cast<size_t>(detail::loadStream64(m_bytes + 8));
+            }
+
+            /**
+             * @brief Checks if the array has no elements
+             * @return true if empty
+             */
+            [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+            /**
+             * @brief Gets the raw element bytes
+             * @return Pointer to the first element, or nullptr if empty
+             */
+            [[nodiscard]] const uint8_t* data() const noexcept {
+                return detail::resolveOffset(m_bytes);
+            }
+
+            /**
+             * @brief Reads one element
+             * @param index Element index in [0, size())
+             * @return The element (by value for integers, by reference for layout types)
+             */
+            [[nodiscard]] decltype(auto) operator[](size_t index) const noexcept {
+                static_assert(SwapType<T> || OffsetLayout<T>, "OffsetArray elements must be integers, enums or OffsetLayout types");
+                if constexpr (SwapType<T>) {
+                    T value{};
+                    basicCopy<stream_endian>(value, data() + index * sizeof(T));
+                    return value;
+                }
+                else {
+                    return *reinterpret_cast<const T*>(data() + index * sizeof(T));
+                }
+            }
+
+        private:
+            uint8_t m_bytes[16];  ///< [relative offset][count] in stream_endian
+        };
+
+        /**
+         * @class OffsetString
+         * @brief Relative pointer to a run of characters
+         */
+        class OffsetString {
+        public:
+            /**
+             * @brief Gets the string length
+             * @return Length in bytes
+             */
+            [[nodiscard]] size_t size() const noexcept {
+                return static_cast<size_t>(detail::loadStream64(m_bytes + 8));
+            }
+
+            /**
+             * @brief Gets the characters
+             * @return View over the characters inside the blob
+             */
+            [[nodiscard]] std::string_view view() const noexcept {
+                const uint8_t* characters = detail::resolveOffset(m_bytes);
+                return characters ? std::string_view(reinterpret_cast<const char*>(characters), size()) : std::string_view{};
+            }
+
+        private:
+            uint8_t m_bytes[16];  ///< [relative offset][length] in stream_endian
+        };
+
+        /**
+         * @class OffsetHashMap
+         * @brief Open-addressing hash table from keys to integer values
+         *
+         * The table is a power-of-two array of control bytes (0 for empty, else
+         * 0x80 plus seven hash bits) followed by [key][value] slots, probed
+         * linearly. Lookups touch the control bytes first and compare whole keys
+         * only on a tag match.
+         *
+         * @tparam K Key type (integer or ByteArray<N>)
+         * @tparam V Value type
+         */
+        template <SearchTreeKey K, SwapType V>
+        class OffsetHashMap {
+            using Traits = detail::SearchKeyTraits<K>;
+
+        public:
+            /// Bytes per [key][value] slot
+            static constexpr size_t slot_size{ Traits::size + sizeof(V) };
+
+            /**
+             * @brief Gets the number of entries
+             * @return Entry count
+             */
+            [[nodiscard]] size_t size() const noexcept {
+                return static_cast<size_t>(detail::loadStream64(m_bytes + 16));
+            }
+
+            /**
+             * @brief Looks up a key
+             * @param key Key to find
+             * @param value Receives the value when found
+             * @return true if the key is absent, false if found
+             */
+            [[nodiscard]] bool find(const K& key, V& value) const noexcept {
+                const uint64_t capacity = detail::loadStream64(m_bytes + 8);
+                const uint8_t* control = detail::resolveOffset(m_bytes);
+                if (capacity == 0 || !control) {
+                    return true; // Error (empty table)
+                }
+                const uint8_t* slots = control + ((capacity + 7) & ~uint64_t{ 7 });
+                const uint64_t hash = detail::offsetKeyHash(key);
+                const uint8_t tag = detail::offsetHashTag(hash);
+                for (uint64_t probe = hash & (capacity - 1);; probe = (probe + 1) & (capacity - 1)) {
+                    if (control[probe] == 0) {
+                        return true; // Error (key not found)
+                    }
+                    const uint8_t* slot = slots + probe * slot_size;
+                    if (control[probe] == tag && Traits::template equal<stream_endian>(slot, key)) {
+                        basicCopy<stream_endian>(value, slot + Traits::size);
+                        return false; // Success (no error)
+                    }
+                }
+            }
+
+            /**
+             * @brief Checks if a key is present
+             * @param key Key to find
+             * @return true if present
+             */
+            [[nodiscard]] bool contains(const K& key) const noexcept {
+                V value{};
+                return !find(key, value);
+            }
+
+        private:
+            uint8_t m_bytes[24];  ///< [relative offset][capacity][count] in stream_endian
+        };
+
+        /**
+         * @class OffsetBlobWriter
+         * @brief Builds a blob of offset-linked layout objects
+         *
+         * Objects are allocated at positions (byte offsets from the start of the
+         * blob) and their fields filled through the position-based setters; the
+         * first allocation is the root. Because all links are relative, the
+         * finished blob can be copied anywhere with writeTo().
+         */
+        class OffsetBlobWriter {
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs a writer holding just the blob header
+              */
+            explicit OffsetBlobWriter() noexcept {
+                m_blob.expandBy(offset_blob_header_size);
+                std::memset(m_blob.data(), 0, offset_blob_header_size);
+                basicCopy<stream_endian>(m_blob.data(), offset_blob_magic);
+            }
+            /** @} */
+
+            /**
+             * @name Allocation
+             * @{
+             */
+
+             /**
+              * @brief Reserves zeroed bytes in the blob
+              * @param bytes Number of bytes
+              * @param alignment Alignment of the position (a power of two)
+              * @return Position of the bytes
+              */
+            [[nodiscard]] size_t allocate(size_t bytes, size_t alignment = 8) noexcept {
+                const size_t position = (m_blob.size() + alignment - 1) & ~(alignment - 1);
+                const size_t added = position + bytes - m_blob.size();
+                m_blob.expandBy(added);
+                std::memset(m_blob.data() + m_blob.size() - added, 0, added);
+                return position;
+            }
+
+            /**
+             * @brief Reserves a zeroed layout object
+             * @tparam T Layout type
+             * @return Position of the object
+             */
+            template <OffsetLayout T>
+            [[nodiscard]] size_t allocate() noexcept {
+                return allocate(sizeof(T));
+            }
+            /** @} */
+
+            /**
+             * @name Field Setters
+             * @{
+             */
+
+             /**
+              * @brief Sets a PackedValue field
+              * @param field Position of the field
+              * @param value Value to store
+              */
+            template <SwapType T>
+            void store(size_t field, T value) noexcept {
+                basicCopy<stream_endian>(m_blob.data() + field, value);
+            }
+
+            /**
+             * @brief Points an OffsetPtr field (or the offset of an array, string or map) at a position
+             * @param field Position of the field
+             * @param target Position of the target
+             */
+            void link(size_t field, size_t target) noexcept {
+                store(field, static_cast<int64_t>(target) - static_cast<int64_t>(field));
+            }
+
+            /**
+             * @brief Fills an OffsetArray field with integers
+             * @param field Position of the OffsetArray
+             * @param values Elements
+             * @return Position of the first element
+             */
+            template <SwapType T>
+            size_t writeArray(size_t field, std::span<const T> values) noexcept {
+                const size_t payload = allocateArray<T>(field, values.size());
+                if (!values.empty()) {
+                    basicCopy<stream_endian>(m_blob.data() + payload, values);
+                }
+                return payload;
+            }
+
+            /**
+             * @brief Allocates the elements of an OffsetArray field, to be filled by the caller
+             * @tparam T Element type
+             * @param field Position of the OffsetArray
+             * @param count Number of elements
+             * @return Position of the first element; element i is at position + i * sizeof(T)
+             */
+            template <typename T>
+                requires SwapType<T> || OffsetLayout<T>
+            size_t allocateArray(size_t field, size_t count) noexcept {
+                const size_t payload = allocate(count * sizeof(T));
+                if (count) {
+                    link(field, payload);
+                }
+                store(field + 8, static_cast<uint64_t>(count));
+                return payload;
+            }
+
+            /**
+             * @brief Fills an OffsetString field
+             * @param field Position of the OffsetString
+             * @param text Characters
+             */
+            void writeString(size_t field, std::string_view text) noexcept {
+                const size_t payload = allocate(text.size(), 1);
+                if (!text.empty()) {
+                    std::memcpy(m_blob.data() + payload, text.data(), text.size());
+                    link(field, payload);
+                }
+                store(field + 8, static_cast<uint64_t>(text.size()));
+            }
+
+            /**
+             * @brief Fills an OffsetHashMap field
+             * @param field Position of the OffsetHashMap
+             * @param keys Keys, without duplicates
+             * @param values Values, one per key
+             * @return true if the sizes differ or a key is duplicated, false on success
+             */
+            template <SearchTreeKey K, SwapType V>
+            [[nodiscard]] bool writeHashMap(size_t field, std::span<const K> keys, std::span<const V> values) noexcept {
+                using Traits = detail::SearchKeyTraits<K>;
+                constexpr size_t slotSize = OffsetHashMap<K, V>::slot_size;
+                if (keys.size() != values.size()) {
+                    return true; // Error (size mismatch)
+                }
+                if (keys.empty()) {
+                    store(field + 8, uint64_t{ 0 });
+                    store(field + 16, uint64_t{ 0 });
+                    return false; // Success (no error)
+                }
+                const uint64_t capacity = std::bit_ceil(static_cast<uint64_t>(keys.size()) * 2);
+                const size_t controlBytes = static_cast<size_t>((capacity + 7) & ~uint64_t{ 7 });
+                const size_t payload = allocate(controlBytes + static_cast<size_t>(capacity) * slotSize);
+                for (size_t i = 0; i < keys.size(); ++i) {
+                    const uint64_t hash = detail::offsetKeyHash(keys[i]);
+                    uint64_t probe = hash & (capacity - 1);
+                    while (true) {
+                        uint8_t* control = m_blob.data() + payload;
+                        uint8_t* slot = control + controlBytes + probe * slotSize;
+                        if (control[probe] == 0) {
+                            control[probe] = detail::offsetHashTag(hash);
+                            Traits::template store<stream_endian>(slot, keys[i]);
+                            basicCopy<stream_endian>(slot + Traits::size, values[i]);
+                            break;
+                        }
+                        if (control[probe] == detail::offsetHashTag(hash) && Traits::template equal<stream_endian>(slot, keys[i])) {
+                            return true; // Error (duplicate key)
+                        }
+                        probe = (probe + 1) & (capacity - 1);
+                    }
+                }
+                link(field, payload);
+                store(field + 8, capacity);
+                store(field + 16, static_cast<uint64_t>(keys.size()));
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Output
+             * @{
+             */
+
+             /**
+              * @brief Gets the blob size
+              * @return Size in bytes, including the header
+              */
+            [[nodiscard]] size_t size() const noexcept { return m_blob.size(); }
+
+            /**
+             * @brief Gets the finished blob
+             * @return Bytes of the blob
+             */
+            [[nodiscard]] std::span<const uint8_t> bytes() noexcept {
+                store(8, static_cast<uint64_t>(m_blob.size()));
+                return std::span<const uint8_t>(m_blob.data(), m_blob.size());
+            }
+
+            /**
+             * @brief Copies the finished blob into a write buffer
+             * @param buffer Destination; the blob works at any address
+             * @return true if the buffer is too small, false on success
+             */
+            [[nodiscard]] bool writeTo(BasicWriteBuffer<stream_endian>& buffer) noexcept {
+                return buffer.pushBack(bytes());
+            }
+            /** @} */
+
+        private:
+            BasicVector<stream_endian> m_blob;  ///< Blob under construction
+        };
+
+        /**
+         * @brief Validates a blob and gets its root object
+         * @tparam Root Layout type of the root (the first object allocated)
+         * @param buffer Read buffer positioned at the blob; advanced past it on success
+         * @param root Receives the root object, pointing into the buffer
+         * @return true if the header is invalid or the blob is truncated, false on success
+         */
+        template <OffsetLayout Root>
+        [[nodiscard]] bool openOffsetBlob(BasicReadBuffer<stream_endian>& buffer, const Root*& root) noexcept {
+            if (buffer.size() < offset_blob_header_size) {
+                return true; // Error (truncated header)
+            }
+            uint32_t magic = 0;
+            uint64_t size = 0;
+            basicCopy<stream_endian>(magic, buffer.data());
+            basicCopy<stream_endian>(size, buffer.data() + 8);
+            if (magic != offset_blob_magic || size > buffer.size() || size < offset_blob_header_size + sizeof(Root)) {
+                return true; // Error (bad header or truncated blob)
+            }
+            root = reinterpret_cast<const Root*>(buffer.data() + offset_blob_header_size);
+            buffer.skipFront(static_cast<size_t>(size));
+            return false; // Success (no error)
+        }
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_OFFSET_PTR_HEADER_FILE
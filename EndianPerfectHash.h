@@ -0,0 +1,508 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_PERFECT_HASH_HEADER_FILE
+#define MZ_ENDIAN_PERFECT_HASH_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianPerfectHash.h
+ * @brief Minimal perfect hash map over a static set of ByteArray keys
+ *
+ * This header provides buildPerfectHash, which turns a fixed set of
+ * ByteArray<N> keys and their values into a serialized, memory-mappable map,
+ * and BasicPerfectHashView, which queries that serialized form in place.
+ *
+ * The index is a BBHash-style minimal perfect hash function: a cascade of bit
+ * arrays, one per level. Level L hashes every key it receives into its array;
+ * keys that land alone keep their bit, colliding keys move on to level L + 1.
+ * The slot of a key is the number of set bits before its bit (rank), so the n
+ * keys map onto [0, n) with no gaps. Keys still colliding after the last
+ * level are kept in a small sorted fallback list.
+ *
+ * A lookup of a present key typically reads one bit array word (plus its
+ * rank sample in the same region) and then one [key][value] record, whose key
+ * is compared so absent keys are reported as such.
+ *
+ * Serialized layout (all integers in Encoding):
+ *   [uint32_t magic][uint32_t keySize][uint32_t valueSize][uint32_t levels]
+ *   [uint64_t count][uint64_t fallbackCount][uint64_t bitWords][24 bytes zero]
+ *   [levels x (uint64_t bitOffset, uint64_t bitCount)], padded to 64 bytes
+ *   [bitWords x uint64_t bits][(bitWords / 8 + 1) x uint64_t rank samples]
+ *   [fallbackCount x N bytes, sorted][count x ([N key bytes][value])]
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianByteArray.h"
+#include "EndianBitOps.h"
+
+namespace mz {
+    namespace endian {
+
+        /// Magic number at the start of a serialized perfect hash ("MZPH")
+        static constexpr uint32_t perfect_hash_magic{ 0x48505A4DU };
+
+        /**
+         * @brief Tuning options for buildPerfectHash
+         */
+        struct PerfectHashOptions {
+            double gamma{ 2.0 };        ///< Bits per remaining key at each level (>= 1; larger builds faster, uses more space)
+            size_t threadCount{ 0 };    ///< Build threads (0 = hardware concurrency)
+            size_t maxLevels{ 32 };     ///< Levels before leftover keys go to the fallback list
+        };
+
+        namespace detail {
+
+            static constexpr size_t perfect_hash_header_size{ 64 };
+
+            /**
+             * @brief Hash of a key for one level, seeded from ByteArray::generateHash
+             */
+            [[nodiscard]] inline uint64_t perfectHashLevel(uint64_t keyHash, size_t level) noexcept {
+                return mix64(keyHash + (static_cast<uint64_t>(level) + 1) * 0x9E3779B97F4A7C15ULL);
+            }
+
+            /**
+             * @brief Runs fn(begin, end) over [0, count) split across threads
+             */
+            template <typename Fn>
+            void parallelChunks(size_t threadCount, size_t count, Fn&& fn) noexcept {
+                const size_t threads = std::min(threadCount, std::max<size_t>(count / 4096, 1));
+                if (threads <= 1) {
+                    fn(size_t{ 0 }, count);
+                    return;
+                }
+                std::vector<std::thread> workers;
+                workers.reserve(threads - 1);
+                const size_t chunk = (count + threads - 1) / threads;
+                for (size_t t = 1; t < threads; ++t) {
+                    const size_t begin = std::min(count, t * chunk);
+                    const size_t end = std::min(count, begin + chunk);
+                    workers.emplace_back([&fn, begin, end]() { fn(begin, end); });
+                }
+                fn(size_t{ 0 }, std::min(count, chunk));
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }
+
+            /**
+             * @brief Shared query logic for the builder and the view
+             */
+            template <std::endian Encoding>
+            struct PerfectHashLayout {
+                const uint8_t* levels{ nullptr };   ///< Level table
+                const uint8_t* bits{ nullptr };     ///< Concatenated level bit arrays
+                const uint8_t* ranks{ nullptr };    ///< Rank samples
+                size_t levelCount{ 0 };
+
+                [[nodiscard]] uint64_t load64(const uint8_t* base, size_t index) const noexcept {
+                    uint64_t value = 0;
+                    basicCopy<Encoding>(value, base + index * 8);
+                    return value;
+                }
+
+                /**
+                 * @brief Finds the slot of a key in the cascade
+                 * @return true if no level holds the key, false on success
+                 */
+                [[nodiscard]] bool slotOf(uint64_t keyHash, uint64_t& slot) const noexcept {
+                    for (size_t level = 0; level < levelCount; ++level) {
+                        const uint64_t offset = load64(levels, 2 * level);
+                        const uint64_t size = load64(levels, 2 * level + 1);
+                        const uint64_t position = offset + mulHigh64(perfectHashLevel(keyHash, level), size);
+                        const size_t wordIndex = static_cast<size_t>(position / 64);
+                        const uint64_t word = load64(bits, wordIndex);
+                        const uint64_t bit = uint64_t{ 1 } << (position % 64);
+                        if (word & bit) {
+                            uint64_t rank = load64(ranks, wordIndex / 8);
+                            for (size_t w = wordIndex & ~size_t{ 7 }; w < wordIndex; ++w) {
+                                rank += static_cast<uint64_t>(std::popcount(load64(bits, w)));
+                            }
+                            slot = rank + static_cast<uint64_t>(std::popcount(word & (bit - 1)));
+                            return false; // Success (no error)
+                        }
+                    }
+                    return true; // Error (not in any level)
+                }
+            };
+
+        } // namespace detail
+
+        /**
+         * @brief Builds a serialized minimal perfect hash map
+         * @tparam Encoding Endianness of integers in the output
+         * @tparam N Key size in bytes
+         * @tparam V Value type
+         * @param keys Distinct keys (any order)
+         * @param values One value per key, in the same order
+         * @param vector Vector to append the map to
+         * @param options Build options
+         * @return true if the inputs are invalid (size mismatch, duplicate keys), false on success
+         *
+         * Each level hashes its keys into a pair of shared atomic bit arrays
+         * ("seen" and "collided") from several threads, then each thread keeps
+         * its keys that landed alone and forwards the rest.
+         */
+        template <std::endian Encoding, size_t N, SwapType V>
+        [[nodiscard]] bool buildPerfectHash(std::span<const ByteArray<N>> keys, std::span<const V> values,
+            BasicVector<Encoding>& vector, const PerfectHashOptions& options = {}) noexcept {
+            if (keys.size() != values.size()) {
+                return true; // Error (size mismatch)
+            }
+            const size_t count = keys.size();
+            size_t threadCount = options.threadCount ? options.threadCount : std::thread::hardware_concurrency();
+            threadCount = std::max<size_t>(threadCount, 1);
+            const double gamma = std::max(options.gamma, 1.0);
+
+            std::vector<uint64_t> hashes(count);
+            detail::parallelChunks(threadCount, count, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    hashes[i] = keys[i].generateHash();
+                }
+            });
+
+            // Build the level cascade
+            std::vector<uint32_t> remaining(count);
+            for (size_t i = 0; i < count; ++i) {
+                remaining[i] = static_cast<uint32_t>(i);
+            }
+            std::vector<uint64_t> levelTable;          // (bitOffset, bitCount) pairs
+            std::vector<uint64_t> bitWords;
+            for (size_t level = 0; level < options.maxLevels && !remaining.empty(); ++level) {
+                const size_t words = std::max<size_t>((static_cast<size_t>(gamma * static_cast<double>(remaining.size())) + 63) / 64, 1);
+                const uint64_t size = static_cast<uint64_t>(words) * 64;
+                std::vector<std::atomic<uint64_t>> seen(words);
+                std::vector<std::atomic<uint64_t>> collided(words);
+
+                detail::parallelChunks(threadCount, remaining.size(), [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        const uint64_t position = mulHigh64(detail::perfectHashLevel(hashes[remaining[i]], level), size);
+                        const uint64_t bit = uint64_t{ 1 } << (position % 64);
+                        if (seen[position / 64].fetch_or(bit, std::memory_order_relaxed) & bit) {
+                            collided[position / 64].fetch_or(bit, std::memory_order_relaxed);
+                        }
+                    }
+                });
+
+                std::vector<uint32_t> next;
+                std::vector<std::vector<uint32_t>> forwarded(threadCount);
+                std::atomic<size_t> chunkIndex{ 0 };
+                detail::parallelChunks(threadCount, remaining.size(), [&](size_t begin, size_t end) {
+                    auto& out = forwarded[chunkIndex.fetch_add(1, std::memory_order_relaxed)];
+                    for (size_t i = begin; i < end; ++i) {
+                        const uint64_t position = mulHigh64(detail::perfectHashLevel(hashes[remaining[i]], level), size);
+                        if (collided[position / 64].load(std::memory_order_relaxed) & (uint64_t{ 1 } << (position % 64))) {
+                            out.push_back(remaining[i]);
+                        }
+                    }
+                });
+                for (auto& part : forwarded) {
+                    next.insert(next.end(), part.begin(), part.end());
+                }
+
+                levelTable.push_back(static_cast<uint64_t>(bitWords.size()) * 64);
+                levelTable.push_back(size);
+                for (size_t w = 0; w < words; ++w) {
+                    bitWords.push_back(seen[w].load(std::memory_order_relaxed) & ~collided[w].load(std::memory_order_relaxed));
+                }
+                remaining.swap(next);
+            }
+
+            // Keys that never landed alone, sorted for binary search
+            std::vector<ByteArray<N>> fallback;
+            fallback.reserve(remaining.size());
+            for (uint32_t index : remaining) {
+                fallback.push_back(keys[index]);
+            }
+            std::sort(fallback.begin(), fallback.end());
+            if (std::adjacent_find(fallback.begin(), fallback.end()) != fallback.end()) {
+                return true; // Error (duplicate keys)
+            }
+
+            // Emit the layout
+            const size_t levels = levelTable.size() / 2;
+            const size_t levelBytes = ((levels * 16 + 63) / 64) * 64;
+            const size_t rankCount = bitWords.size() / 8 + 1;
+            const size_t recordSize = N + sizeof(V);
+            const size_t fallbackCount = fallback.size();
+
+            const size_t start = vector.size();
+            vector.expandBy(detail::perfect_hash_header_size + levelBytes + (bitWords.size() + rankCount) * 8
+                + fallbackCount * N + count * recordSize);
+            uint8_t* header = vector.data() + start;
+            std::memset(header, 0, detail::perfect_hash_header_size + levelBytes);
+            basicCopy<Encoding>(header, perfect_hash_magic);
+            basicCopy<Encoding>(header + 4, static_cast<uint32_t>(N));
+            basicCopy<Encoding>(header + 8, static_cast<uint32_t>(sizeof(V)));
+            basicCopy<Encoding>(header + 12, static_cast<uint32_t>(levels));
+            basicCopy<Encoding>(header + 16, static_cast<uint64_t>(count));
+            basicCopy<Encoding>(header + 24, static_cast<uint64_t>(fallbackCount));
+            basicCopy<Encoding>(header + 32, static_cast<uint64_t>(bitWords.size()));
+
+            detail::PerfectHashLayout<Encoding> layout;
+            uint8_t* levelArea = header + detail::perfect_hash_header_size;
+            uint8_t* bitArea = levelArea + levelBytes;
+            uint8_t* rankArea = bitArea + bitWords.size() * 8;
+            uint8_t* fallbackArea = rankArea + rankCount * 8;
+            uint8_t* recordArea = fallbackArea + fallbackCount * N;
+            if (!levelTable.empty()) {
+                basicCopy<Encoding>(levelArea, std::span<const uint64_t>(levelTable));
+                basicCopy<Encoding>(bitArea, std::span<const uint64_t>(bitWords));
+            }
+            uint64_t ones = 0;
+            for (size_t w = 0; w < bitWords.size(); ++w) {
+                if (w % 8 == 0) {
+                    basicCopy<Encoding>(rankArea + (w / 8) * 8, ones);
+                }
+                ones += static_cast<uint64_t>(std::popcount(bitWords[w]));
+            }
+            if (bitWords.size() % 8 == 0) {
+                basicCopy<Encoding>(rankArea + (rankCount - 1) * 8, ones);
+            }
+            for (size_t i = 0; i < fallbackCount; ++i) {
+                std::memcpy(fallbackArea + i * N, fallback[i].data(), N);
+            }
+
+            // Place every record at its slot
+            layout.levels = levelArea;
+            layout.bits = bitArea;
+            layout.ranks = rankArea;
+            layout.levelCount = levels;
+            const uint64_t cascadeCount = ones;
+            detail::parallelChunks(threadCount, count, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    uint64_t slot = 0;
+                    if (layout.slotOf(hashes[i], slot)) {
+                        const auto it = std::lower_bound(fallback.begin(), fallback.end(), keys[i]);
+                        slot = cascadeCount + static_cast<uint64_t>(it - fallback.begin());
+                    }
+                    uint8_t* record = recordArea + static_cast<size_t>(slot) * recordSize;
+                    std::memcpy(record, keys[i].data(), N);
+                    basicCopy<Encoding>(record + N, values[i]);
+                }
+            });
+            return false; // Success (no error)
+        }
+
+        /**
+         * @class BasicPerfectHashView
+         * @brief Read-only lookups on a serialized minimal perfect hash map
+         *
+         * The view only stores pointers into the buffer it was opened on; the
+         * buffer must outlive it. Opening validates sizes only, so it costs the
+         * same for any map size.
+         *
+         * @tparam Encoding Endianness of integers in the map
+         * @tparam N Key size in bytes
+         * @tparam V Value type
+         */
+        template <std::endian Encoding, size_t N, SwapType V>
+        class BasicPerfectHashView {
+        public:
+            using key_type = ByteArray<N>;  ///< Key type
+            using mapped_type = V;          ///< Value type
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an empty view
+              */
+            explicit BasicPerfectHashView() noexcept = default;
+            /** @} */
+
+            /**
+             * @name Opening
+             * @{
+             */
+
+             /**
+              * @brief Attaches the view to a serialized map
+              * @param buffer Read buffer positioned at the map; advanced past it on success
+              * @return true if the header or size is invalid, false on success
+              */
+            [[nodiscard]] bool open(BasicReadBuffer<Encoding>& buffer) noexcept {
+                if (buffer.size() < detail::perfect_hash_header_size) {
+                    return true; // Error (truncated header)
+                }
+                const uint8_t* header = buffer.data();
+                uint32_t magic = 0;
+                uint32_t keySize = 0;
+                uint32_t valueSize = 0;
+                uint32_t levels = 0;
+                uint64_t count = 0;
+                uint64_t fallbackCount = 0;
+                uint64_t bitWords = 0;
+                basicCopy<Encoding>(magic, header);
+                basicCopy<Encoding>(keySize, header + 4);
+                basicCopy<Encoding>(valueSize, header + 8);
+                basicCopy<Encoding>(levels, header + 12);
+                basicCopy<Encoding>(count, header + 16);
+                basicCopy<Encoding>(fallbackCount, header + 24);
+                basicCopy<Encoding>(bitWords, header + 32);
+                const uint64_t available = buffer.size() - detail::perfect_hash_header_size;
+                if (magic != perfect_hash_magic || keySize != N || valueSize != sizeof(V)
+                    || levels > 4096 || fallbackCount > count
+                    || count > available / (N + sizeof(V)) || bitWords > available / 8) {
+                    return true; // Error (bad header)
+                }
+                const size_t levelBytes = ((static_cast<size_t>(levels) * 16 + 63) / 64) * 64;
+                const size_t rankCount = static_cast<size_t>(bitWords) / 8 + 1;
+                const uint64_t bodySize = levelBytes + (bitWords + rankCount) * 8
+                    + fallbackCount * N + count * (N + sizeof(V));
+                if (bodySize > available) {
+                    return true; // Error (truncated body)
+                }
+
+                m_layout.levels = header + detail::perfect_hash_header_size;
+                m_layout.bits = m_layout.levels + levelBytes;
+                m_layout.ranks = m_layout.bits + bitWords * 8;
+                m_layout.levelCount = levels;
+                for (size_t level = 0; level < levels; ++level) {
+                    const uint64_t offset = m_layout.load64(m_layout.levels, 2 * level);
+                    const uint64_t size = m_layout.load64(m_layout.levels, 2 * level + 1);
+                    if (size == 0 || offset > bitWords * 64 || size > bitWords * 64 - offset) {
+                        return true; // Error (level outside the bit array)
+                    }
+                }
+                m_fallback = m_layout.ranks + rankCount * 8;
+                m_records = m_fallback + fallbackCount * N;
+                m_count = static_cast<size_t>(count);
+                m_fallbackCount = static_cast<size_t>(fallbackCount);
+                buffer.skipFront(detail::perfect_hash_header_size + static_cast<size_t>(bodySize));
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Queries
+             * @{
+             */
+
+             /**
+              * @brief Gets the number of keys
+              * @return Number of keys in the map
+              */
+            [[nodiscard]] size_t size() const noexcept { return m_count; }
+
+            /**
+             * @brief Finds the slot of a key
+             * @param key Key to look up
+             * @param slot Receives the key's slot in [0, size())
+             * @return true if the key is not in the map, false on success
+             */
+            [[nodiscard]] bool slotOf(const key_type& key, size_t& slot) const noexcept {
+                uint64_t candidate = 0;
+                if (m_layout.slotOf(key.generateHash(), candidate)) {
+                    // Binary search over the (small) fallback list
+                    size_t low = 0;
+                    size_t high = m_fallbackCount;
+                    while (low < high) {
+                        const size_t middle = low + (high - low) / 2;
+                        if (std::memcmp(m_fallback + middle * N, key.data(), N) < 0) {
+                            low = middle + 1;
+                        }
+                        else {
+                            high = middle;
+                        }
+                    }
+                    if (low == m_fallbackCount) {
+                        return true; // Error (not found)
+                    }
+                    candidate = (m_count - m_fallbackCount) + low;
+                }
+                if (candidate >= m_count || std::memcmp(record(static_cast<size_t>(candidate)), key.data(), N) != 0) {
+                    return true; // Error (not found)
+                }
+                slot = static_cast<size_t>(candidate);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Looks up the value of a key
+             * @param key Key to look up
+             * @param value Receives the value
+             * @return true if the key is not in the map, false on success
+             */
+            [[nodiscard]] bool find(const key_type& key, V& value) const noexcept {
+                size_t slot = 0;
+                if (slotOf(key, slot)) {
+                    return true; // Error (not found)
+                }
+                basicCopy<Encoding>(value, record(slot) + N);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Gets the value stored at a slot
+             * @param slot Slot in [0, size())
+             * @return The value
+             */
+            [[nodiscard]] V valueAt(size_t slot) const noexcept {
+                V value{};
+                basicCopy<Encoding>(value, record(slot) + N);
+                return value;
+            }
+            /** @} */
+
+        private:
+            detail::PerfectHashLayout<Encoding> m_layout;   ///< Level cascade
+            const uint8_t* m_fallback{ nullptr };           ///< Sorted fallback keys
+            const uint8_t* m_records{ nullptr };            ///< [key][value] records by slot
+            size_t m_count{ 0 };                            ///< Number of keys
+            size_t m_fallbackCount{ 0 };                    ///< Keys in the fallback list
+
+            [[nodiscard]] const uint8_t* record(size_t slot) const noexcept {
+                return m_records + slot * (N + sizeof(V));
+            }
+        };
+
+        /**
+         * @brief Perfect hash view that uses the default stream endianness
+         * @tparam N Key size in bytes
+         * @tparam V Value type
+         */
+        template <size_t N, SwapType V>
+        using PerfectHashView = BasicPerfectHashView<stream_endian, N, V>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_PERFECT_HASH_HEADER_FILE
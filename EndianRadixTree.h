@@ -0,0 +1,1057 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_RADIX_TREE_HEADER_FILE
+#define MZ_ENDIAN_RADIX_TREE_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianRadixTree.h
+ * @brief Adaptive radix tree (ART) keyed by ByteArray
+ *
+ * This header defines RadixTree, an ordered map from ByteArray<N> keys to
+ * values based on the adaptive radix tree of Leis et al. Inner nodes grow
+ * through four sizes (4, 16, 48 and 256 children) so sparse and dense levels
+ * both stay compact, common key segments are path-compressed into the node
+ * above them, and leaves are created lazily as soon as a key is unique.
+ *
+ * Iteration is in byte (memcmp) order, which matches ByteArray::operator<.
+ * Node16 child lookups compare all 16 key bytes at once with SSE2 when
+ * available; Node48 and Node256 look children up by direct indexing.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <span>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define MZ_ENDIAN_RADIX_TREE_SSE2 1
+#endif
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianByteArray.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @class RadixTree
+         * @brief Ordered, prefix-searchable map from ByteArray<N> to values
+         *
+         * @tparam N Key size in bytes
+         * @tparam V Value type (must satisfy SwapType so it can be serialized)
+         */
+        template <size_t N, SwapType V>
+            requires (N > 0)
+        class RadixTree {
+        public:
+            /**
+             * @name Type Definitions
+             * @{
+             */
+            using key_type = ByteArray<N>;   ///< Key type
+            using mapped_type = V;           ///< Value type
+            /** @} */
+
+            /// Magic number at the start of a serialized tree ("MZRT")
+            static constexpr uint32_t serial_magic{ 0x54525A4DU };
+
+            /**
+             * @name Constructors and Assignment
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an empty tree
+              */
+            explicit RadixTree() noexcept = default;
+
+            RadixTree(const RadixTree&) = delete;
+            RadixTree& operator=(const RadixTree&) = delete;
+
+            /**
+             * @brief Move constructor
+             * @param other Tree to move from; left empty
+             */
+            RadixTree(RadixTree&& other) noexcept
+                : m_root{ other.m_root }, m_size{ other.m_size } {
+                other.m_root = nullptr;
+                other.m_size = 0;
+            }
+
+            /**
+             * @brief Move assignment operator
+             * @param other Tree to move from; left empty
+             * @return Reference to this tree
+             */
+            RadixTree& operator=(RadixTree&& other) noexcept {
+                if (this != &other) {
+                    clear();
+                    m_root = other.m_root;
+                    m_size = other.m_size;
+                    other.m_root = nullptr;
+                    other.m_size = 0;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Destructor; frees every node
+             */
+            ~RadixTree() noexcept {
+                clear();
+            }
+            /** @} */
+
+            /**
+             * @name Capacity
+             * @{
+             */
+
+             /**
+              * @brief Gets the number of keys in the tree
+              * @return Number of keys
+              */
+            [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+            /**
+             * @brief Checks if the tree is empty
+             * @return true if the tree holds no keys
+             */
+            [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+            /**
+             * @brief Removes every key and frees all nodes
+             */
+            void clear() noexcept {
+                destroy(m_root);
+                m_root = nullptr;
+                m_size = 0;
+            }
+            /** @} */
+
+            /**
+             * @name Lookup and Modification
+             * @{
+             */
+
+             /**
+              * @brief Finds the value stored for a key
+              * @param key Key to look up
+              * @return Pointer to the value, or nullptr if the key is absent
+              *
+              * Compressed prefixes are skipped optimistically; the full key is
+              * compared once at the leaf.
+              */
+            [[nodiscard]] const V* find(const key_type& key) const noexcept {
+                const uint8_t* bytes = key.data();
+                const Header* node = m_root;
+                size_t depth = 0;
+                while (node) {
+                    if (node->type == NodeType::leaf) {
+                        const Leaf* leaf = static_cast<const Leaf*>(node);
+                        return (leaf->key == key) ? &leaf->value : nullptr;
+                    }
+                    const Inner* inner = static_cast<const Inner*>(node);
+                    if (inner->prefixLength > 0) {
+                        const size_t stored = std::min<size_t>(inner->prefixLength, max_prefix);
+                        if (std::memcmp(inner->prefix, bytes + depth, stored) != 0) {
+                            return nullptr;
+                        }
+                        depth += inner->prefixLength;
+                    }
+                    if (depth >= N) {
+                        return nullptr;
+                    }
+                    Header* const* child = findChild(inner, bytes[depth]);
+                    node = child ? *child : nullptr;
+                    ++depth;
+                }
+                return nullptr;
+            }
+
+            /**
+             * @brief Finds the value stored for a key (mutable version)
+             * @param key Key to look up
+             * @return Pointer to the value, or nullptr if the key is absent
+             */
+            [[nodiscard]] V* find(const key_type& key) noexcept {
+                return const_cast<V*>(static_cast<const RadixTree*>(this)->find(key));
+            }
+
+            /**
+             * @brief Checks if a key is present
+             * @param key Key to look up
+             * @return true if the tree holds the key
+             */
+            [[nodiscard]] bool contains(const key_type& key) const noexcept {
+                return find(key) != nullptr;
+            }
+
+            /**
+             * @brief Inserts a key or replaces its value
+             * @param key Key to insert
+             * @param value Value to store
+             * @return true if the key was already present (its value was replaced), false if it was added
+             */
+            bool insert(const key_type& key, V value) noexcept {
+                return insertAt(m_root, key, value, 0);
+            }
+
+            /**
+             * @brief Removes a key
+             * @param key Key to remove
+             * @return true if the key was not present, false if it was removed
+             *
+             * Inner nodes move down a size once well below the smaller capacity,
+             * and a Node4 left with a single child is merged into that child so
+             * paths stay compressed.
+             */
+            bool erase(const key_type& key) noexcept {
+                return eraseAt(m_root, key, 0);
+            }
+            /** @} */
+
+            /**
+             * @name Ordered Traversal
+             * @{
+             */
+
+             /**
+              * @brief Visits every key in byte order
+              * @tparam Visitor Callable as bool(const key_type&, const V&); return false to stop
+              * @param visitor Function called for each entry
+              */
+            template <typename Visitor>
+            void forEach(Visitor&& visitor) const noexcept {
+                (void)visitAll(m_root, visitor);
+            }
+
+            /**
+             * @brief Visits the keys in [low, high) in byte order
+             * @tparam Visitor Callable as bool(const key_type&, const V&); return false to stop
+             * @param low Inclusive lower bound
+             * @param high Exclusive upper bound
+             * @param visitor Function called for each entry in range
+             *
+             * Subtrees entirely outside the range are pruned using the bytes on
+             * the path, so the cost is proportional to the depth plus the number
+             * of keys visited.
+             */
+            template <typename Visitor>
+            void forEachInRange(const key_type& low, const key_type& high, Visitor&& visitor) const noexcept {
+                (void)visitRange(m_root, 0, low.data(), high.data(), true, true, visitor);
+            }
+
+            /**
+             * @brief Visits the keys that start with a prefix, in byte order
+             * @tparam Visitor Callable as bool(const key_type&, const V&); return false to stop
+             * @param prefix Leading key bytes (at most N)
+             * @param visitor Function called for each matching entry
+             */
+            template <typename Visitor>
+            void forEachWithPrefix(std::span<const uint8_t> prefix, Visitor&& visitor) const noexcept {
+                if (prefix.size() > N) {
+                    return;
+                }
+                const Header* node = m_root;
+                size_t depth = 0;
+                while (node && depth < prefix.size()) {
+                    if (node->type == NodeType::leaf) {
+                        break; // Checked below
+                    }
+                    const Inner* inner = static_cast<const Inner*>(node);
+                    if (inner->prefixLength > 0) {
+                        const uint8_t* path = minimumLeaf(inner)->key.data() + depth;
+                        const size_t overlap = std::min<size_t>(inner->prefixLength, prefix.size() - depth);
+                        if (std::memcmp(path, prefix.data() + depth, overlap) != 0) {
+                            return;
+                        }
+                        depth += inner->prefixLength;
+                        if (depth >= prefix.size()) {
+                            break;
+                        }
+                    }
+                    Header* const* child = findChild(inner, prefix[depth]);
+                    node = child ? *child : nullptr;
+                    ++depth;
+                }
+                if (!node) {
+                    return;
+                }
+                if (node->type == NodeType::leaf) {
+                    const Leaf* leaf = static_cast<const Leaf*>(node);
+                    if (std::memcmp(leaf->key.data(), prefix.data(), prefix.size()) == 0) {
+                        (void)visitor(leaf->key, leaf->value);
+                    }
+                    return;
+                }
+                (void)visitAll(node, visitor);
+            }
+            /** @} */
+
+            /**
+             * @name Serialization
+             * @{
+             */
+
+             /**
+              * @brief Appends the tree to a vector
+              * @tparam Encoding Endianness of the serialized integers
+              * @param vector Vector to append to
+              *
+              * Layout: [uint32_t magic][uint32_t N][uint64_t count] followed by
+              * count entries of [N key bytes][value], in key order.
+              */
+            template <std::endian Encoding>
+            void serialize(BasicVector<Encoding>& vector) const noexcept {
+                vector.pushBack(serial_magic);
+                vector.pushBack(static_cast<uint32_t>(N));
+                vector.pushBack(static_cast<uint64_t>(m_size));
+                forEach([&vector](const key_type& key, const V& value) {
+                    vector.pushBack(key.span());
+                    vector.pushBack(value);
+                    return true;
+                });
+            }
+
+            /**
+             * @brief Replaces the tree with one read from a buffer
+             * @tparam Encoding Endianness of the serialized integers
+             * @param buffer Read buffer positioned at a serialized tree; advanced past it
+             * @return true if the data is malformed, false on success
+             *
+             * Entries arrive sorted, so each insert walks the rightmost path,
+             * which is already in cache.
+             */
+            template <std::endian Encoding>
+            [[nodiscard]] bool deserialize(BasicReadBuffer<Encoding>& buffer) noexcept {
+                clear();
+                uint32_t magic = 0;
+                uint32_t keySize = 0;
+                uint64_t count = 0;
+                if (buffer.popFront(magic) || buffer.popFront(keySize) || buffer.popFront(count)
+                    || magic != serial_magic || keySize != N || count > buffer.size() / (N + sizeof(V))) {
+                    return true; // Error (bad header)
+                }
+                key_type key;
+                for (uint64_t i = 0; i < count; ++i) {
+                    V value{};
+                    if (buffer.popFront(key.span()) || buffer.popFront(value)) {
+                        clear();
+                        return true; // Error (truncated)
+                    }
+                    insert(key, value);
+                }
+                return false; // Success (no error)
+            }
+            /** @} */
+
+        private:
+            /// Number of compressed prefix bytes stored inline in each inner node
+            static constexpr size_t max_prefix{ 8 };
+
+            enum class NodeType : uint8_t { leaf, node4, node16, node48, node256 };
+
+            struct Header {
+                NodeType type;
+            };
+
+            struct Leaf : Header {
+                key_type key;
+                V value;
+            };
+
+            struct Inner : Header {
+                uint16_t count{ 0 };          ///< Number of children
+                uint32_t prefixLength{ 0 };   ///< Full length of the compressed prefix
+                uint8_t prefix[max_prefix]{}; ///< First max_prefix bytes of the prefix
+            };
+
+            struct Node4 : Inner {
+                uint8_t keys[4]{};
+                Header* children[4]{};
+            };
+
+            struct Node16 : Inner {
+                uint8_t keys[16]{};
+                Header* children[16]{};
+            };
+
+            struct Node48 : Inner {
+                uint8_t index[256]{};        ///< Child slot + 1, or 0 if absent
+                Header* children[48]{};
+            };
+
+            struct Node256 : Inner {
+                Header* children[256]{};
+            };
+
+            Header* m_root{ nullptr };  ///< Root node, or nullptr when empty
+            size_t m_size{ 0 };         ///< Number of keys
+
+            /**
+             * @name Node Management
+             * @{
+             */
+
+            [[nodiscard]] static Leaf* makeLeaf(const key_type& key, V value) noexcept {
+                Leaf* leaf = new Leaf{};
+                leaf->type = NodeType::leaf;
+                leaf->key = key;
+                leaf->value = value;
+                return leaf;
+            }
+
+            template <typename NodeT>
+            [[nodiscard]] static NodeT* makeInner(NodeType type) noexcept {
+                NodeT* node = new NodeT{};
+                node->type = type;
+                return node;
+            }
+
+            static void destroy(Header* node) noexcept {
+                if (!node) {
+                    return;
+                }
+                switch (node->type) {
+                case NodeType::leaf:
+                    delete static_cast<Leaf*>(node);
+                    break;
+                case NodeType::node4: {
+                    Node4* n = static_cast<Node4*>(node);
+                    for (size_t i = 0; i < n->count; ++i) destroy(n->children[i]);
+                    delete n;
+                    break;
+                }
+                case NodeType::node16: {
+                    Node16* n = static_cast<Node16*>(node);
+                    for (size_t i = 0; i < n->count; ++i) destroy(n->children[i]);
+                    delete n;
+                    break;
+                }
+                case NodeType::node48: {
+                    Node48* n = static_cast<Node48*>(node);
+                    for (Header* child : n->children) destroy(child);
+                    delete n;
+                    break;
+                }
+                case NodeType::node256: {
+                    Node256* n = static_cast<Node256*>(node);
+                    for (Header* child : n->children) destroy(child);
+                    delete n;
+                    break;
+                }
+                }
+            }
+
+            /**
+             * @brief Copies the header fields shared by all inner nodes
+             */
+            static void copyHeader(Inner* destination, const Inner* source) noexcept {
+                destination->count = source->count;
+                destination->prefixLength = source->prefixLength;
+                std::memcpy(destination->prefix, source->prefix, max_prefix);
+            }
+
+            /**
+             * @brief Finds the slot holding the child for a key byte
+             * @return Pointer to the child slot, or nullptr if there is no such child
+             */
+            [[nodiscard]] static Header* const* findChild(const Inner* node, uint8_t byte) noexcept {
+                switch (node->type) {
+                case NodeType::node4: {
+                    const Node4* n = static_cast<const Node4*>(node);
+                    for (size_t i = 0; i < n->count; ++i) {
+                        if (n->keys[i] == byte) return &n->children[i];
+                    }
+                    return nullptr;
+                }
+                case NodeType::node16: {
+                    const Node16* n = static_cast<const Node16*>(node);
+#if defined(MZ_ENDIAN_RADIX_TREE_SSE2)
+                    const __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys));
+                    const __m128i matches = _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(byte)));
+                    const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches)) & ((1U << n->count) - 1U);
+                    return mask ? &n->children[std::countr_zero(mask)] : nullptr;
+#else
+                    for (size_t i = 0; i < n->count; ++i) {
+                        if (n->keys[i] == byte) return &n->children[i];
+                    }
+                    return nullptr;
+#endif
+                }
+                case NodeType::node48: {
+                    const Node48* n = static_cast<const Node48*>(node);
+                    return n->index[byte] ? &n->children[n->index[byte] - 1] : nullptr;
+                }
+                case NodeType::node256: {
+                    const Node256* n = static_cast<const Node256*>(node);
+                    return n->children[byte] ? &n->children[byte] : nullptr;
+                }
+                default:
+                    return nullptr;
+                }
+            }
+
+            [[nodiscard]] static Header** findChild(Inner* node, uint8_t byte) noexcept {
+                return const_cast<Header**>(findChild(static_cast<const Inner*>(node), byte));
+            }
+
+            /**
+             * @brief Inserts a key byte into a sorted key array, shifting children along
+             */
+            template <size_t Capacity>
+            static void insertSorted(uint8_t (&keys)[Capacity], Header* (&children)[Capacity], size_t count, uint8_t byte, Header* child) noexcept {
+                size_t position = 0;
+                while (position < count && keys[position] < byte) {
+                    ++position;
+                }
+                std::memmove(keys + position + 1, keys + position, count - position);
+                std::memmove(children + position + 1, children + position, (count - position) * sizeof(Header*));
+                keys[position] = byte;
+                children[position] = child;
+            }
+
+            /**
+             * @brief Adds a child, growing the node to the next size when full
+             * @param ref Slot holding the node; updated if the node is replaced
+             */
+            static void addChild(Header*& ref, uint8_t byte, Header* child) noexcept {
+                Inner* node = static_cast<Inner*>(ref);
+                switch (node->type) {
+                case NodeType::node4: {
+                    Node4* n = static_cast<Node4*>(node);
+                    if (n->count < 4) {
+                        insertSorted(n->keys, n->children, n->count, byte, child);
+                        ++n->count;
+                        return;
+                    }
+                    Node16* grown = makeInner<Node16>(NodeType::node16);
+                    copyHeader(grown, n);
+                    std::memcpy(grown->keys, n->keys, 4);
+                    std::memcpy(grown->children, n->children, 4 * sizeof(Header*));
+                    delete n;
+                    ref = grown;
+                    addChild(ref, byte, child);
+                    return;
+                }
+                case NodeType::node16: {
+                    Node16* n = static_cast<Node16*>(node);
+                    if (n->count < 16) {
+                        insertSorted(n->keys, n->children, n->count, byte, child);
+                        ++n->count;
+                        return;
+                    }
+                    Node48* grown = makeInner<Node48>(NodeType::node48);
+                    copyHeader(grown, n);
+                    for (size_t i = 0; i < 16; ++i) {
+                        grown->children[i] = n->children[i];
+                        grown->index[n->keys[i]] = static_cast<uint8_t>(i + 1);
+                    }
+                    delete n;
+                    ref = grown;
+                    addChild(ref, byte, child);
+                    return;
+                }
+                case NodeType::node48: {
+                    Node48* n = static_cast<Node48*>(node);
+                    if (n->count < 48) {
+                        size_t slot = 0;
+                        while (n->children[slot]) {
+                            ++slot;
+                        }
+                        n->children[slot] = child;
+                        n->index[byte] = static_cast<uint8_t>(slot + 1);
+                        ++n->count;
+                        return;
+                    }
+                    Node256* grown = makeInner<Node256>(NodeType::node256);
+                    copyHeader(grown, n);
+                    for (size_t i = 0; i < 256; ++i) {
+                        if (n->index[i]) {
+                            grown->children[i] = n->children[n->index[i] - 1];
+                        }
+                    }
+                    delete n;
+                    ref = grown;
+                    addChild(ref, byte, child);
+                    return;
+                }
+                case NodeType::node256: {
+                    Node256* n = static_cast<Node256*>(node);
+                    n->children[byte] = child;
+                    ++n->count;
+                    return;
+                }
+                default:
+                    return;
+                }
+            }
+
+            /**
+             * @brief Removes the child for a key byte (the child itself is not freed)
+             */
+            static void removeChild(Inner* node, uint8_t byte) noexcept {
+                switch (node->type) {
+                case NodeType::node4:
+                case NodeType::node16: {
+                    uint8_t* keys = (node->type == NodeType::node4) ? static_cast<Node4*>(node)->keys : static_cast<Node16*>(node)->keys;
+                    Header** children = (node->type == NodeType::node4) ? static_cast<Node4*>(node)->children : static_cast<Node16*>(node)->children;
+                    size_t position = 0;
+                    while (keys[position] != byte) {
+                        ++position;
+                    }
+                    std::memmove(keys + position, keys + position + 1, node->count - position - 1);
+                    std::memmove(children + position, children + position + 1, (node->count - position - 1) * sizeof(Header*));
+                    children[node->count - 1] = nullptr;
+                    break;
+                }
+                case NodeType::node48: {
+                    Node48* n = static_cast<Node48*>(node);
+                    n->children[n->index[byte] - 1] = nullptr;
+                    n->index[byte] = 0;
+                    break;
+                }
+                case NodeType::node256:
+                    static_cast<Node256*>(node)->children[byte] = nullptr;
+                    break;
+                default:
+                    return;
+                }
+                --node->count;
+            }
+
+            /**
+             * @brief Finds the leftmost leaf below a node
+             *
+             * Every leaf below a node shares the node's full compressed prefix, so
+             * this is also how prefix bytes beyond max_prefix are recovered.
+             */
+            [[nodiscard]] static const Leaf* minimumLeaf(const Header* node) noexcept {
+                while (node->type != NodeType::leaf) {
+                    switch (node->type) {
+                    case NodeType::node4:
+                        node = static_cast<const Node4*>(node)->children[0];
+                        break;
+                    case NodeType::node16:
+                        node = static_cast<const Node16*>(node)->children[0];
+                        break;
+                    case NodeType::node48: {
+                        const Node48* n = static_cast<const Node48*>(node);
+                        size_t i = 0;
+                        while (!n->index[i]) ++i;
+                        node = n->children[n->index[i] - 1];
+                        break;
+                    }
+                    case NodeType::node256: {
+                        const Node256* n = static_cast<const Node256*>(node);
+                        size_t i = 0;
+                        while (!n->children[i]) ++i;
+                        node = n->children[i];
+                        break;
+                    }
+                    default:
+                        break;
+                    }
+                }
+                return static_cast<const Leaf*>(node);
+            }
+            /** @} */
+
+            /**
+             * @brief Counts how many bytes of a node's prefix match the key
+             */
+            [[nodiscard]] static size_t prefixMismatch(const Inner* node, const uint8_t* key, size_t depth) noexcept {
+                const size_t stored = std::min<size_t>(node->prefixLength, max_prefix);
+                size_t i = 0;
+                for (; i < stored; ++i) {
+                    if (node->prefix[i] != key[depth + i]) {
+                        return i;
+                    }
+                }
+                if (node->prefixLength > max_prefix) {
+                    const uint8_t* path = minimumLeaf(node)->key.data();
+                    for (; i < node->prefixLength; ++i) {
+                        if (path[depth + i] != key[depth + i]) {
+                            return i;
+                        }
+                    }
+                }
+                return i;
+            }
+
+            bool insertAt(Header*& ref, const key_type& key, V value, size_t depth) noexcept {
+                const uint8_t* bytes = key.data();
+                if (!ref) {
+                    ref = makeLeaf(key, value);
+                    ++m_size;
+                    return false;
+                }
+
+                if (ref->type == NodeType::leaf) {
+                    Leaf* leaf = static_cast<Leaf*>(ref);
+                    if (leaf->key == key) {
+                        leaf->value = value;
+                        return true;
+                    }
+                    // Split the leaf: new Node4 holding the common part as its prefix
+                    const uint8_t* other = leaf->key.data();
+                    size_t common = 0;
+                    while (other[depth + common] == bytes[depth + common]) {
+                        ++common;
+                    }
+                    Node4* node = makeInner<Node4>(NodeType::node4);
+                    node->prefixLength = static_cast<uint32_t>(common);
+                    std::memcpy(node->prefix, bytes + depth, std::min(common, max_prefix));
+                    Header* replacement = node;
+                    addChild(replacement, other[depth + common], leaf);
+                    addChild(replacement, bytes[depth + common], makeLeaf(key, value));
+                    ref = replacement;
+                    ++m_size;
+                    return false;
+                }
+
+                Inner* node = static_cast<Inner*>(ref);
+                if (node->prefixLength > 0) {
+                    const size_t mismatch = prefixMismatch(node, bytes, depth);
+                    if (mismatch < node->prefixLength) {
+                        // The key leaves the compressed path: split it at the mismatch
+                        Node4* parent = makeInner<Node4>(NodeType::node4);
+                        parent->prefixLength = static_cast<uint32_t>(mismatch);
+                        std::memcpy(parent->prefix, bytes + depth, std::min(mismatch, max_prefix));
+
+                        uint8_t splitByte = 0;
+                        if (node->prefixLength <= max_prefix) {
+                            splitByte = node->prefix[mismatch];
+                            node->prefixLength -= static_cast<uint32_t>(mismatch + 1);
+                            std::memmove(node->prefix, node->prefix + mismatch + 1, node->prefixLength);
+                        }
+                        else {
+                            const uint8_t* path = minimumLeaf(node)->key.data();
+                            splitByte = path[depth + mismatch];
+                            node->prefixLength -= static_cast<uint32_t>(mismatch + 1);
+                            std::memcpy(node->prefix, path + depth + mismatch + 1, std::min<size_t>(node->prefixLength, max_prefix));
+                        }
+
+                        Header* replacement = parent;
+                        addChild(replacement, splitByte, node);
+                        addChild(replacement, bytes[depth + mismatch], makeLeaf(key, value));
+                        ref = replacement;
+                        ++m_size;
+                        return false;
+                    }
+                    depth += node->prefixLength;
+                }
+
+                if (Header** child = findChild(node, bytes[depth])) {
+                    return insertAt(*child, key, value, depth + 1);
+                }
+                addChild(ref, bytes[depth], makeLeaf(key, value));
+                ++m_size;
+                return false;
+            }
+
+            bool eraseAt(Header*& ref, const key_type& key, size_t depth) noexcept {
+                if (!ref) {
+                    return true;
+                }
+                if (ref->type == NodeType::leaf) {
+                    // Only reached for the root
+                    if (static_cast<Leaf*>(ref)->key != key) {
+                        return true;
+                    }
+                    destroy(ref);
+                    ref = nullptr;
+                    --m_size;
+                    return false;
+                }
+
+                Inner* node = static_cast<Inner*>(ref);
+                const uint8_t* bytes = key.data();
+                if (node->prefixLength > 0) {
+                    if (prefixMismatch(node, bytes, depth) != node->prefixLength) {
+                        return true;
+                    }
+                    depth += node->prefixLength;
+                }
+
+                Header** child = findChild(node, bytes[depth]);
+                if (!child) {
+                    return true;
+                }
+                if ((*child)->type != NodeType::leaf) {
+                    if (eraseAt(*child, key, depth + 1)) {
+                        return true;
+                    }
+                    if (*child) {
+                        return false;
+                    }
+                }
+                else {
+                    if (static_cast<Leaf*>(*child)->key != key) {
+                        return true;
+                    }
+                    destroy(*child);
+                    --m_size;
+                }
+
+                removeChild(node, bytes[depth]);
+                shrink(ref);
+                return false;
+            }
+
+            /**
+             * @brief Shrinks an inner node after a child was removed
+             *
+             * An empty node is freed and ref set to nullptr. Node256, Node48 and
+             * Node16 move down one size once well below the smaller capacity, so
+             * repeated insert/erase at a boundary does not thrash. A Node4 left
+             * with a single child is merged into that child.
+             */
+            static void shrink(Header*& ref) noexcept {
+                Inner* node = static_cast<Inner*>(ref);
+                if (node->count == 0) {
+                    destroy(node);
+                    ref = nullptr;
+                    return;
+                }
+                switch (node->type) {
+                case NodeType::node4: {
+                    if (node->count != 1) {
+                        return;
+                    }
+                    // Merge the single remaining child into this node's position
+                    Node4* n = static_cast<Node4*>(node);
+                    Header* only = n->children[0];
+                    if (only->type != NodeType::leaf) {
+                        Inner* inner = static_cast<Inner*>(only);
+                        uint8_t merged[max_prefix];
+                        size_t length = std::min<size_t>(n->prefixLength, max_prefix);
+                        std::memcpy(merged, n->prefix, length);
+                        if (length < max_prefix) {
+                            merged[length++] = n->keys[0];
+                        }
+                        if (length < max_prefix) {
+                            const size_t extra = std::min<size_t>(inner->prefixLength, max_prefix - length);
+                            std::memcpy(merged + length, inner->prefix, extra);
+                        }
+                        inner->prefixLength += n->prefixLength + 1;
+                        std::memcpy(inner->prefix, merged, max_prefix);
+                    }
+                    delete n;
+                    ref = only;
+                    return;
+                }
+                case NodeType::node16: {
+                    if (node->count > 3) {
+                        return;
+                    }
+                    Node16* n = static_cast<Node16*>(node);
+                    Node4* shrunk = makeInner<Node4>(NodeType::node4);
+                    copyHeader(shrunk, n);
+                    std::memcpy(shrunk->keys, n->keys, n->count);
+                    std::memcpy(shrunk->children, n->children, n->count * sizeof(Header*));
+                    delete n;
+                    ref = shrunk;
+                    return;
+                }
+                case NodeType::node48: {
+                    if (node->count > 12) {
+                        return;
+                    }
+                    Node48* n = static_cast<Node48*>(node);
+                    Node16* shrunk = makeInner<Node16>(NodeType::node16);
+                    copyHeader(shrunk, n);
+                    size_t slot = 0;
+                    for (size_t i = 0; i < 256; ++i) {
+                        if (n->index[i]) {
+                            shrunk->keys[slot] = static_cast<uint8_t>(i);
+                            shrunk->children[slot++] = n->children[n->index[i] - 1];
+                        }
+                    }
+                    delete n;
+                    ref = shrunk;
+                    return;
+                }
+                case NodeType::node256: {
+                    if (node->count > 37) {
+                        return;
+                    }
+                    Node256* n = static_cast<Node256*>(node);
+                    Node48* shrunk = makeInner<Node48>(NodeType::node48);
+                    copyHeader(shrunk, n);
+                    size_t slot = 0;
+                    for (size_t i = 0; i < 256; ++i) {
+                        if (n->children[i]) {
+                            shrunk->children[slot] = n->children[i];
+                            shrunk->index[i] = static_cast<uint8_t>(++slot);
+                        }
+                    }
+                    delete n;
+                    ref = shrunk;
+                    return;
+                }
+                default:
+                    return;
+                }
+            }
+
+            template <typename Visitor>
+            [[nodiscard]] static bool visitAll(const Header* node, Visitor& visitor) noexcept {
+                if (!node) {
+                    return true;
+                }
+                switch (node->type) {
+                case NodeType::leaf: {
+                    const Leaf* leaf = static_cast<const Leaf*>(node);
+                    return visitor(leaf->key, leaf->value);
+                }
+                case NodeType::node4: {
+                    const Node4* n = static_cast<const Node4*>(node);
+                    for (size_t i = 0; i < n->count; ++i) {
+                        if (!visitAll(n->children[i], visitor)) return false;
+                    }
+                    return true;
+                }
+                case NodeType::node16: {
+                    const Node16* n = static_cast<const Node16*>(node);
+                    for (size_t i = 0; i < n->count; ++i) {
+                        if (!visitAll(n->children[i], visitor)) return false;
+                    }
+                    return true;
+                }
+                case NodeType::node48: {
+                    const Node48* n = static_cast<const Node48*>(node);
+                    for (size_t i = 0; i < 256; ++i) {
+                        if (n->index[i] && !visitAll(n->children[n->index[i] - 1], visitor)) return false;
+                    }
+                    return true;
+                }
+                case NodeType::node256: {
+                    const Node256* n = static_cast<const Node256*>(node);
+                    for (size_t i = 0; i < 256; ++i) {
+                        if (n->children[i] && !visitAll(n->children[i], visitor)) return false;
+                    }
+                    return true;
+                }
+                }
+                return true;
+            }
+
+            /**
+             * @brief Visits one child during a range scan, narrowing the bounds
+             */
+            template <typename Visitor>
+            [[nodiscard]] static bool visitRangeChild(const Header* child, uint8_t byte, size_t depth,
+                const uint8_t* low, const uint8_t* high, bool lowTight, bool highTight, Visitor& visitor) noexcept {
+                if (lowTight && byte < low[depth]) return true;    // Entirely below the range
+                if (highTight && byte > high[depth]) return false; // Entirely above; later children too
+                return visitRange(child, depth + 1, low, high,
+                    lowTight && byte == low[depth], highTight && byte == high[depth], visitor);
+            }
+
+            template <typename Visitor>
+            [[nodiscard]] static bool visitRange(const Header* node, size_t depth, const uint8_t* low, const uint8_t* high,
+                bool lowTight, bool highTight, Visitor& visitor) noexcept {
+                if (!node) {
+                    return true;
+                }
+                if (node->type == NodeType::leaf) {
+                    const Leaf* leaf = static_cast<const Leaf*>(node);
+                    if (std::memcmp(leaf->key.data(), low, N) < 0) return true;
+                    if (std::memcmp(leaf->key.data(), high, N) >= 0) return false;
+                    return visitor(leaf->key, leaf->value);
+                }
+                if (!lowTight && !highTight) {
+                    return visitAll(node, visitor);
+                }
+
+                const Inner* inner = static_cast<const Inner*>(node);
+                if (inner->prefixLength > 0) {
+                    const uint8_t* path = minimumLeaf(inner)->key.data() + depth;
+                    if (lowTight) {
+                        const int order = std::memcmp(path, low + depth, inner->prefixLength);
+                        if (order < 0) return true;
+                        lowTight = (order == 0);
+                    }
+                    if (highTight) {
+                        const int order = std::memcmp(path, high + depth, inner->prefixLength);
+                        if (order > 0) return false;
+                        highTight = (order == 0);
+                    }
+                    depth += inner->prefixLength;
+                    if (!lowTight && !highTight) {
+                        return visitAll(node, visitor);
+                    }
+                }
+
+                switch (node->type) {
+                case NodeType::node4: {
+                    const Node4* n = static_cast<const Node4*>(node);
+                    for (size_t i = 0; i < n->count; ++i) {
+                        if (!visitRangeChild(n->children[i], n->keys[i], depth, low, high, lowTight, highTight, visitor)) return false;
+                    }
+                    return true;
+                }
+                case NodeType::node16: {
+                    const Node16* n = static_cast<const Node16*>(node);
+                    for (size_t i = 0; i < n->count; ++i) {
+                        if (!visitRangeChild(n->children[i], n->keys[i], depth, low, high, lowTight, highTight, visitor)) return false;
+                    }
+                    return true;
+                }
+                case NodeType::node48: {
+                    const Node48* n = static_cast<const Node48*>(node);
+                    for (size_t i = 0; i < 256; ++i) {
+                        if (n->index[i] && !visitRangeChild(n->children[n->index[i] - 1], static_cast<uint8_t>(i), depth, low, high, lowTight, highTight, visitor)) return false;
+                    }
+                    return true;
+                }
+                case NodeType::node256: {
+                    const Node256* n = static_cast<const Node256*>(node);
+                    for (size_t i = 0; i < 256; ++i) {
+                        if (n->children[i] && !visitRangeChild(n->children[i], static_cast<uint8_t>(i), depth, low, high, lowTight, highTight, visitor)) return false;
+                    }
+                    return true;
+                }
+                default:
+                    return true;
+                }
+            }
+        };
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_RADIX_TREE_SSE2
+
+#endif // MZ_ENDIAN_RADIX_TREE_HEADER_FILE
@@ -0,0 +1,1086 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_ROARING_HEADER_FILE
+#define MZ_ENDIAN_ROARING_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianRoaring.h
+ * @brief Roaring compressed bitmaps for uint32_t sets
+ *
+ * This header defines RoaringBitmap, an in-memory compressed set of uint32_t
+ * values, and BasicRoaringView, which reads the serialized form of a
+ * RoaringBitmap in place. Set algebra (setIntersection, setUnion) accepts any
+ * mix of bitmaps and views, so sets stored in a mapped file are intersected
+ * and united without being loaded first.
+ *
+ * Values are grouped by their high 16 bits; each group's low 16 bits are kept
+ * in the cheapest of three containers:
+ * - array: sorted uint16_t values (at most 4096)
+ * - bitmap: 1024 uint64_t words (8 KiB)
+ * - run: sorted (start, length - 1) uint16_t pairs
+ *
+ * Serialized layout (all integers in Encoding):
+ *   [uint32_t magic][uint32_t containers][uint64_t totalBytes]
+ *   containers x [uint16_t key][uint8_t type][uint8_t 0][uint32_t cardinality]
+ *                [uint32_t offset][uint32_t count]
+ *   payloads, each padded to 8 bytes (offsets are from the start of the blob)
+ *
+ * count is the number of array values, the number of runs, or 1024 words.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <span>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define MZ_ENDIAN_ROARING_SSE2 1
+#endif
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Container kinds of a roaring bitmap
+         */
+        enum class RoaringContainer : uint8_t {
+            none,        ///< No container
+            array = 1,   ///< Sorted uint16_t values
+            bitmap = 2,  ///< 65536-bit bitmap
+            run = 3,     ///< (start, length - 1) pairs
+            invalid      ///< Invalid container
+        };
+
+        /// Magic number at the start of a serialized roaring bitmap ("MZRB")
+        static constexpr uint32_t roaring_magic{ 0x42525A4DU };
+
+        namespace detail {
+
+            static constexpr uint32_t roaring_array_max{ 4096 };      ///< Largest array container
+            static constexpr size_t roaring_bitmap_words{ 1024 };     ///< Words in a bitmap container
+            static constexpr size_t roaring_header_size{ 16 };
+            static constexpr size_t roaring_directory_entry{ 16 };
+
+            /**
+             * @brief Read-only reference to one container, in memory or serialized
+             *
+             * In-memory containers are referenced with Encoding == native_endian,
+             * serialized ones with the file's encoding, so the set algebra below
+             * is written once for both.
+             *
+             * @tparam Encoding Endianness of the referenced data
+             */
+            template <std::endian Encoding>
+            struct RoaringContainerRef {
+                RoaringContainer type{ RoaringContainer::none };
+                uint32_t cardinality{ 0 };
+                uint32_t count{ 0 };               ///< Array values, runs, or bitmap words
+                const uint8_t* data{ nullptr };
+
+                [[nodiscard]] uint16_t value(size_t index) const noexcept {
+                    uint16_t result = 0;
+                    basicCopy<Encoding>(result, data + index * 2);
+                    return result;
+                }
+
+                [[nodiscard]] uint64_t word(size_t index) const noexcept {
+                    uint64_t result = 0;
+                    basicCopy<Encoding>(result, data + index * 8);
+                    return result;
+                }
+
+                [[nodiscard]] bool contains(uint16_t x) const noexcept {
+                    switch (type) {
+                    case RoaringContainer::array: {
+                        size_t low = 0;
+                        size_t high = count;
+                        while (low < high) {
+                            const size_t middle = low + (high - low) / 2;
+                            if (value(middle) < x) low = middle + 1;
+                            else high = middle;
+                        }
+                        return low < count && value(low) == x;
+                    }
+                    case RoaringContainer::bitmap:
+                        return (word(x >> 6) >> (x & 63)) & 1;
+                    case RoaringContainer::run: {
+                        // Last run starting at or before x
+                        size_t low = 0;
+                        size_t high = count;
+                        while (low < high) {
+                            const size_t middle = low + (high - low) / 2;
+                            if (value(2 * middle) <= x) low = middle + 1;
+                            else high = middle;
+                        }
+                        return low > 0 && x - value(2 * (low - 1)) <= value(2 * (low - 1) + 1);
+                    }
+                    default:
+                        return false;
+                    }
+                }
+
+                /**
+                 * @brief ORs the container's bits into a 1024-word bitmap
+                 */
+                void orInto(uint64_t* words) const noexcept {
+                    switch (type) {
+                    case RoaringContainer::array:
+                        for (size_t i = 0; i < count; ++i) {
+                            const uint16_t x = value(i);
+                            words[x >> 6] |= uint64_t{ 1 } << (x & 63);
+                        }
+                        break;
+                    case RoaringContainer::bitmap:
+#if defined(MZ_ENDIAN_ROARING_SSE2)
+                        if constexpr (Encoding == native_endian) {
+                            for (size_t i = 0; i < roaring_bitmap_words; i += 2) {
+                                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+                                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 8));
+                                _mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), _mm_or_si128(a, b));
+                            }
+                            break;
+                        }
+#endif
+                        for (size_t i = 0; i < roaring_bitmap_words; ++i) {
+                            words[i] |= word(i);
+                        }
+                        break;
+                    case RoaringContainer::run:
+                        for (size_t r = 0; r < count; ++r) {
+                            const size_t start = value(2 * r);
+                            const size_t end = start + value(2 * r + 1);  // Inclusive
+                            const size_t firstWord = start >> 6;
+                            const size_t lastWord = end >> 6;
+                            const uint64_t firstMask = ~uint64_t{ 0 } << (start & 63);
+                            const uint64_t lastMask = ~uint64_t{ 0 } >> (63 - (end & 63));
+                            if (firstWord == lastWord) {
+                                words[firstWord] |= firstMask & lastMask;
+                                continue;
+                            }
+                            words[firstWord] |= firstMask;
+                            for (size_t w = firstWord + 1; w < lastWord; ++w) {
+                                words[w] = ~uint64_t{ 0 };
+                            }
+                            words[lastWord] |= lastMask;
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                }
+
+                /**
+                 * @brief Calls fn(uint16_t) for every value in ascending order
+                 */
+                template <typename Fn>
+                void forEach(Fn&& fn) const noexcept {
+                    switch (type) {
+                    case RoaringContainer::array:
+                        for (size_t i = 0; i < count; ++i) fn(value(i));
+                        break;
+                    case RoaringContainer::bitmap:
+                        for (size_t w = 0; w < roaring_bitmap_words; ++w) {
+                            for (uint64_t bits = word(w); bits; bits &= bits - 1) {
+                                fn(static_cast<uint16_t>(w * 64 + static_cast<size_t>(std::countr_zero(bits))));
+                            }
+                        }
+                        break;
+                    case RoaringContainer::run:
+                        for (size_t r = 0; r < count; ++r) {
+                            const uint32_t start = value(2 * r);
+                            const uint32_t end = start + value(2 * r + 1);
+                            for (uint32_t x = start; x <= end; ++x) fn(static_cast<uint16_t>(x));
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                }
+
+                /**
+                 * @brief Checks a serialized payload against its directory entry
+                 * @return true if an array is not strictly increasing, runs are
+                 *         unsorted, overlap or pass 65535, or the values do not add
+                 *         up to cardinality; false if the payload is consistent
+                 */
+                [[nodiscard]] bool checkPayload() const noexcept {
+                    switch (type) {
+                    case RoaringContainer::array:
+                        for (size_t i = 1; i < count; ++i) {
+                            if (value(i) <= value(i - 1)) {
+                                return true; // Error (array not strictly increasing)
+                            }
+                        }
+                        return false; // Success (no error)
+                    case RoaringContainer::bitmap: {
+                        uint64_t total = 0;
+                        for (size_t w = 0; w < roaring_bitmap_words; ++w) {
+                            total += static_cast<uint64_t>(std::popcount(word(w)));
+                        }
+                        return total != cardinality;
+                    }
+                    case RoaringContainer::run: {
+                        uint64_t total = 0;
+                        int64_t previousEnd = -1;
+                        for (size_t r = 0; r < count; ++r) {
+                            const int64_t start = value(2 * r);
+                            const int64_t end = start + value(2 * r + 1);  // Inclusive
+                            if (start <= previousEnd || end > 65535) {
+                                return true; // Error (runs unsorted, overlapping or out of range)
+                            }
+                            total += static_cast<uint64_t>(end - start + 1);
+                            previousEnd = end;
+                        }
+                        return total != cardinality;
+                    }
+                    default:
+                        return true; // Error (unknown container)
+                    }
+                }
+            };
+
+#if defined(MZ_ENDIAN_ROARING_SSE2)
+            /**
+             * @brief Rotates the eight 16-bit lanes of a vector by Lanes positions
+             */
+            template <int Lanes>
+            [[nodiscard]] inline __m128i roaringRotate(__m128i v) noexcept {
+                return _mm_or_si128(_mm_srli_si128(v, 2 * Lanes), _mm_slli_si128(v, 16 - 2 * Lanes));
+            }
+
+            /**
+             * @brief Intersects two native-endian sorted uint16_t arrays, 8x8 blocks at a time
+             * @return Number of values written to out
+             *
+             * Each block of a is compared with all eight rotations of the current
+             * block of b; the block with the smaller maximum is then advanced.
+             * The tail is merged with scalar code.
+             */
+            [[nodiscard]] inline size_t roaringIntersectSse2(const uint8_t* a, size_t countA,
+                const uint8_t* b, size_t countB, uint16_t* out) noexcept {
+                size_t i = 0;
+                size_t j = 0;
+                size_t written = 0;
+                while (i + 8 <= countA && j + 8 <= countB) {
+                    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i * 2));
+                    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j * 2));
+                    __m128i hits = _mm_cmpeq_epi16(va, vb);
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(va, roaringRotate<1>(vb)));
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(va, roaringRotate<2>(vb)));
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(va, roaringRotate<3>(vb)));
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(va, roaringRotate<4>(vb)));
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(va, roaringRotate<5>(vb)));
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(va, roaringRotate<6>(vb)));
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(va, roaringRotate<7>(vb)));
+                    for (unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits)) & 0x5555U; mask; mask &= mask - 1) {
+                        uint16_t x = 0;
+                        std::memcpy(&x, a + (i + static_cast<size_t>(std::countr_zero(mask)) / 2) * 2, 2);
+                        out[written++] = x;
+                    }
+                    uint16_t maxA = 0;
+                    uint16_t maxB = 0;
+                    std::memcpy(&maxA, a + (i + 7) * 2, 2);
+                    std::memcpy(&maxB, b + (j + 7) * 2, 2);
+                    if (maxA <= maxB) i += 8;
+                    if (maxB <= maxA) j += 8;
+                }
+                while (i < countA && j < countB) {
+                    uint16_t x = 0;
+                    uint16_t y = 0;
+                    std::memcpy(&x, a + i * 2, 2);
+                    std::memcpy(&y, b + j * 2, 2);
+                    if (x == y) out[written++] = x;
+                    i += (x <= y);
+                    j += (y <= x);
+                }
+                return written;
+            }
+#endif
+
+        } // namespace detail
+
+        /**
+         * @class RoaringBitmap
+         * @brief In-memory compressed set of uint32_t values
+         *
+         * Containers are kept in native byte order; serialize() converts to the
+         * requested encoding.
+         */
+        class RoaringBitmap {
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an empty set
+              */
+            explicit RoaringBitmap() noexcept = default;
+
+            /**
+             * @brief Constructs a set from values in any order
+             * @param values Values to add
+             */
+            explicit RoaringBitmap(std::span<const uint32_t> values) noexcept {
+                addMany(values);
+            }
+            /** @} */
+
+            /**
+             * @name Modification
+             * @{
+             */
+
+             /**
+              * @brief Adds a value
+              * @param x Value to add
+              */
+            void add(uint32_t x) noexcept {
+                const uint16_t key = static_cast<uint16_t>(x >> 16);
+                const uint16_t low = static_cast<uint16_t>(x & 0xFFFF);
+                const auto it = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+                const size_t index = static_cast<size_t>(it - m_keys.begin());
+                if (it == m_keys.end() || *it != key) {
+                    m_keys.insert(it, key);
+                    Container container;
+                    container.type = RoaringContainer::array;
+                    m_containers.insert(m_containers.begin() + static_cast<ptrdiff_t>(index), std::move(container));
+                }
+                addLow(m_containers[index], low);
+            }
+
+            /**
+             * @brief Adds many values
+             * @param values Values to add, in any order (sorted input is fastest)
+             */
+            void addMany(std::span<const uint32_t> values) noexcept {
+                for (uint32_t x : values) {
+                    add(x);
+                }
+            }
+
+            /**
+             * @brief Removes every value
+             */
+            void clear() noexcept {
+                m_keys.clear();
+                m_containers.clear();
+            }
+
+            /**
+             * @brief Converts containers to run form wherever that is smaller
+             *
+             * Call once after building a set with long consecutive ranges, before
+             * serializing it.
+             */
+            void runOptimize() noexcept {
+                for (Container& container : m_containers) {
+                    if (container.type == RoaringContainer::run) {
+                        continue;
+                    }
+                    const size_t runs = countRuns(container);
+                    const size_t currentBytes = (container.type == RoaringContainer::array)
+                        ? container.values.size() * 2 : detail::roaring_bitmap_words * 8;
+                    if (runs * 4 < currentBytes) {
+                        toRuns(container);
+                    }
+                }
+            }
+            /** @} */
+
+            /**
+             * @name Queries
+             * @{
+             */
+
+             /**
+              * @brief Checks if a value is in the set
+              * @param x Value to look up
+              * @return true if the set holds the value
+              */
+            [[nodiscard]] bool contains(uint32_t x) const noexcept {
+                const uint16_t key = static_cast<uint16_t>(x >> 16);
+                const auto it = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+                if (it == m_keys.end() || *it != key) {
+                    return false;
+                }
+                return containerAt(static_cast<size_t>(it - m_keys.begin())).contains(static_cast<uint16_t>(x & 0xFFFF));
+            }
+
+            /**
+             * @brief Gets the number of values in the set
+             * @return Cardinality
+             */
+            [[nodiscard]] uint64_t cardinality() const noexcept {
+                uint64_t total = 0;
+                for (const Container& container : m_containers) {
+                    total += container.cardinality;
+                }
+                return total;
+            }
+
+            /**
+             * @brief Checks if the set is empty
+             * @return true if the set holds no values
+             */
+            [[nodiscard]] bool empty() const noexcept { return m_containers.empty(); }
+
+            /**
+             * @brief Calls fn(uint32_t) for every value in ascending order
+             * @tparam Fn Callable as void(uint32_t)
+             * @param fn Function to call
+             */
+            template <typename Fn>
+            void forEach(Fn&& fn) const noexcept {
+                for (size_t i = 0; i < m_keys.size(); ++i) {
+                    const uint32_t high = static_cast<uint32_t>(m_keys[i]) << 16;
+                    containerAt(i).forEach([&fn, high](uint16_t low) { fn(high | low); });
+                }
+            }
+            /** @} */
+
+            /**
+             * @name Container Access
+             * Common interface with BasicRoaringView used by the set algebra.
+             * @{
+             */
+            [[nodiscard]] size_t containerCount() const noexcept { return m_keys.size(); }
+            [[nodiscard]] uint16_t keyAt(size_t index) const noexcept { return m_keys[index]; }
+
+            [[nodiscard]] detail::RoaringContainerRef<native_endian> containerAt(size_t index) const noexcept {
+                return refOf(m_containers[index]);
+            }
+            /** @} */
+
+            /**
+             * @name Set Algebra
+             * Operands may be RoaringBitmap or BasicRoaringView in any combination.
+             * @{
+             */
+
+             /**
+              * @brief Computes the intersection of two sets
+              * @param a First set
+              * @param b Second set
+              * @return Values present in both
+              */
+            template <typename A, typename B>
+            [[nodiscard]] static RoaringBitmap setIntersection(const A& a, const B& b) noexcept {
+                RoaringBitmap result;
+                size_t i = 0;
+                size_t j = 0;
+                while (i < a.containerCount() && j < b.containerCount()) {
+                    const uint16_t keyA = a.keyAt(i);
+                    const uint16_t keyB = b.keyAt(j);
+                    if (keyA < keyB) {
+                        ++i;
+                    }
+                    else if (keyB < keyA) {
+                        ++j;
+                    }
+                    else {
+                        Container container = intersectContainers(a.containerAt(i), b.containerAt(j));
+                        if (container.cardinality > 0) {
+                            result.m_keys.push_back(keyA);
+                            result.m_containers.push_back(std::move(container));
+                        }
+                        ++i;
+                        ++j;
+                    }
+                }
+                return result;
+            }
+
+            /**
+             * @brief Computes the union of two sets
+             * @param a First set
+             * @param b Second set
+             * @return Values present in either
+             */
+            template <typename A, typename B>
+            [[nodiscard]] static RoaringBitmap setUnion(const A& a, const B& b) noexcept {
+                RoaringBitmap result;
+                size_t i = 0;
+                size_t j = 0;
+                while (i < a.containerCount() || j < b.containerCount()) {
+                    const bool takeA = i < a.containerCount() && (j == b.containerCount() || a.keyAt(i) <= b.keyAt(j));
+                    const bool takeB = j < b.containerCount() && (i == a.containerCount() || b.keyAt(j) <= a.keyAt(i));
+                    if (takeA && takeB) {
+                        result.m_keys.push_back(a.keyAt(i));
+                        result.m_containers.push_back(uniteContainers(a.containerAt(i), b.containerAt(j)));
+                        ++i;
+                        ++j;
+                    }
+                    else if (takeA) {
+                        result.m_keys.push_back(a.keyAt(i));
+                        result.m_containers.push_back(copyContainer(a.containerAt(i)));
+                        ++i;
+                    }
+                    else {
+                        result.m_keys.push_back(b.keyAt(j));
+                        result.m_containers.push_back(copyContainer(b.containerAt(j)));
+                        ++j;
+                    }
+                }
+                return result;
+            }
+            /** @} */
+
+            /**
+             * @name Serialization
+             * @{
+             */
+
+             /**
+              * @brief Appends the set to a vector
+              * @tparam Encoding Endianness of the serialized integers
+              * @param vector Vector to append to
+              */
+            template <std::endian Encoding>
+            void serialize(BasicVector<Encoding>& vector) const noexcept {
+                const size_t start = vector.size();
+                const size_t directoryEnd = detail::roaring_header_size + m_keys.size() * detail::roaring_directory_entry;
+                size_t total = directoryEnd;
+                for (const Container& container : m_containers) {
+                    total += paddedPayload(container);
+                }
+                vector.expandBy(total);
+                uint8_t* blob = vector.data() + start;
+                std::memset(blob, 0, total);
+                basicCopy<Encoding>(blob, roaring_magic);
+                basicCopy<Encoding>(blob + 4, static_cast<uint32_t>(m_keys.size()));
+                basicCopy<Encoding>(blob + 8, static_cast<uint64_t>(total));
+
+                size_t offset = directoryEnd;
+                for (size_t i = 0; i < m_keys.size(); ++i) {
+                    const Container& container = m_containers[i];
+                    const auto ref = containerAt(i);
+                    uint8_t* entry = blob + detail::roaring_header_size + i * detail::roaring_directory_entry;
+                    basicCopy<Encoding>(entry, m_keys[i]);
+                    basicCopy<Encoding>(entry + 2, container.type);
+                    basicCopy<Encoding>(entry + 4, container.cardinality);
+                    basicCopy<Encoding>(entry + 8, static_cast<uint32_t>(offset));
+                    basicCopy<Encoding>(entry + 12, ref.count);
+                    if (container.type == RoaringContainer::bitmap) {
+                        basicCopy<Encoding>(blob + offset, std::span<const uint64_t>(container.words));
+                    }
+                    else if (!container.values.empty()) {
+                        basicCopy<Encoding>(blob + offset, std::span<const uint16_t>(container.values));
+                    }
+                    offset += paddedPayload(container);
+                }
+            }
+            /** @} */
+
+        private:
+            /**
+             * @brief One container: array/run values or bitmap words
+             */
+            struct Container {
+                RoaringContainer type{ RoaringContainer::array };
+                uint32_t cardinality{ 0 };
+                std::vector<uint16_t> values;  ///< Array values or (start, length - 1) run pairs
+                std::vector<uint64_t> words;   ///< Bitmap words
+            };
+
+            std::vector<uint16_t> m_keys;          ///< High 16 bits of each container, ascending
+            std::vector<Container> m_containers;   ///< Containers, parallel to m_keys
+
+            [[nodiscard]] static size_t paddedPayload(const Container& container) noexcept {
+                const size_t bytes = (container.type == RoaringContainer::bitmap)
+                    ? detail::roaring_bitmap_words * 8 : container.values.size() * 2;
+                return (bytes + 7) & ~size_t{ 7 };
+            }
+
+            [[nodiscard]] static detail::RoaringContainerRef<native_endian> refOf(const Container& container) noexcept {
+                detail::RoaringContainerRef<native_endian> ref;
+                ref.type = container.type;
+                ref.cardinality = container.cardinality;
+                if (container.type == RoaringContainer::bitmap) {
+                    ref.count = static_cast<uint32_t>(detail::roaring_bitmap_words);
+                    ref.data = reinterpret_cast<const uint8_t*>(container.words.data());
+                }
+                else {
+                    ref.count = static_cast<uint32_t>(container.type == RoaringContainer::run ? container.values.size() / 2 : container.values.size());
+                    ref.data = reinterpret_cast<const uint8_t*>(container.values.data());
+                }
+                return ref;
+            }
+
+            /**
+             * @brief Builds the smallest of array/bitmap from 1024 words
+             */
+            [[nodiscard]] static Container fromWords(std::vector<uint64_t>&& words) noexcept {
+                Container container;
+                for (uint64_t word : words) {
+                    container.cardinality += static_cast<uint32_t>(std::popcount(word));
+                }
+                if (container.cardinality > detail::roaring_array_max) {
+                    container.type = RoaringContainer::bitmap;
+                    container.words = std::move(words);
+                    return container;
+                }
+                container.type = RoaringContainer::array;
+                container.values.reserve(container.cardinality);
+                for (size_t w = 0; w < detail::roaring_bitmap_words; ++w) {
+                    for (uint64_t bits = words[w]; bits; bits &= bits - 1) {
+                        container.values.push_back(static_cast<uint16_t>(w * 64 + static_cast<size_t>(std::countr_zero(bits))));
+                    }
+                }
+                return container;
+            }
+
+            template <std::endian Encoding>
+            [[nodiscard]] static std::vector<uint64_t> toWords(const detail::RoaringContainerRef<Encoding>& ref) noexcept {
+                std::vector<uint64_t> words(detail::roaring_bitmap_words, 0);
+                ref.orInto(words.data());
+                return words;
+            }
+
+            template <std::endian Encoding>
+            [[nodiscard]] static Container copyContainer(const detail::RoaringContainerRef<Encoding>& ref) noexcept {
+                Container container;
+                container.type = ref.type;
+                container.cardinality = ref.cardinality;
+                if (ref.type == RoaringContainer::bitmap) {
+                    container.words.resize(detail::roaring_bitmap_words);
+                    basicCopy<Encoding>(std::span<uint64_t>(container.words), ref.data);
+                }
+                else {
+                    container.values.resize(ref.type == RoaringContainer::run ? ref.count * size_t{ 2 } : ref.count);
+                    if (!container.values.empty()) {
+                        basicCopy<Encoding>(std::span<uint16_t>(container.values), ref.data);
+                    }
+                }
+                return container;
+            }
+
+            template <std::endian EncodingA, std::endian EncodingB>
+            [[nodiscard]] static Container intersectContainers(const detail::RoaringContainerRef<EncodingA>& a,
+                const detail::RoaringContainerRef<EncodingB>& b) noexcept {
+                Container container;
+                container.type = RoaringContainer::array;
+
+                if (a.type == RoaringContainer::array && b.type == RoaringContainer::array) {
+                    container.values.resize(std::min(a.count, b.count));
+                    size_t written = 0;
+                    const bool skewed = static_cast<size_t>(a.count) * 32 < b.count || static_cast<size_t>(b.count) * 32 < a.count;
+                    if (skewed) {
+                        // Probe the large array with each value of the small one
+                        if (a.count < b.count) {
+                            for (size_t i = 0; i < a.count; ++i) {
+                                if (b.contains(a.value(i))) container.values[written++] = a.value(i);
+                            }
+                        }
+                        else {
+                            for (size_t i = 0; i < b.count; ++i) {
+                                if (a.contains(b.value(i))) container.values[written++] = b.value(i);
+                            }
+                        }
+                    }
+                    else {
+#if defined(MZ_ENDIAN_ROARING_SSE2)
+                        if constexpr (EncodingA == native_endian && EncodingB == native_endian) {
+                            written = detail::roaringIntersectSse2(a.data, a.count, b.data, b.count, container.values.data());
+                        }
+                        else
+#endif
+                        {
+                            size_t i = 0;
+                            size_t j = 0;
+                            while (i < a.count && j < b.count) {
+                                const uint16_t x = a.value(i);
+                                const uint16_t y = b.value(j);
+                                if (x == y) container.values[written++] = x;
+                                i += (x <= y);
+                                j += (y <= x);
+                            }
+                        }
+                    }
+                    container.values.resize(written);
+                    container.cardinality = static_cast<uint32_t>(written);
+                    return container;
+                }
+
+                if (a.type == RoaringContainer::array || b.type == RoaringContainer::array) {
+                    // Filter the array through the other container
+                    const bool arrayIsA = (a.type == RoaringContainer::array);
+                    const size_t count = arrayIsA ? a.count : b.count;
+                    container.values.reserve(count);
+                    for (size_t i = 0; i < count; ++i) {
+                        const uint16_t x = arrayIsA ? a.value(i) : b.value(i);
+                        if (arrayIsA ? b.contains(x) : a.contains(x)) {
+                            container.values.push_back(x);
+                        }
+                    }
+                    container.cardinality = static_cast<uint32_t>(container.values.size());
+                    return container;
+                }
+
+                std::vector<uint64_t> words = toWords(a);
+#if defined(MZ_ENDIAN_ROARING_SSE2)
+                if constexpr (EncodingB == native_endian) {
+                    if (b.type == RoaringContainer::bitmap) {
+                        for (size_t w = 0; w < detail::roaring_bitmap_words; w += 2) {
+                            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words.data() + w));
+                            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data + w * 8));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(words.data() + w), _mm_and_si128(x, y));
+                        }
+                        return fromWords(std::move(words));
+                    }
+                }
+#endif
+                const std::vector<uint64_t> other = toWords(b);
+                for (size_t w = 0; w < detail::roaring_bitmap_words; ++w) {
+                    words[w] &= other[w];
+                }
+                return fromWords(std::move(words));
+            }
+
+            template <std::endian EncodingA, std::endian EncodingB>
+            [[nodiscard]] static Container uniteContainers(const detail::RoaringContainerRef<EncodingA>& a,
+                const detail::RoaringContainerRef<EncodingB>& b) noexcept {
+                if (a.type == RoaringContainer::array && b.type == RoaringContainer::array
+                    && a.count + b.count <= detail::roaring_array_max) {
+                    Container container;
+                    container.type = RoaringContainer::array;
+                    container.values.reserve(a.count + b.count);
+                    size_t i = 0;
+                    size_t j = 0;
+                    while (i < a.count || j < b.count) {
+                        if (j == b.count || (i < a.count && a.value(i) < b.value(j))) {
+                            container.values.push_back(a.value(i++));
+                        }
+                        else if (i == a.count || b.value(j) < a.value(i)) {
+                            container.values.push_back(b.value(j++));
+                        }
+                        else {
+                            container.values.push_back(a.value(i));
+                            ++i;
+                            ++j;
+                        }
+                    }
+                    container.cardinality = static_cast<uint32_t>(container.values.size());
+                    return container;
+                }
+                std::vector<uint64_t> words = toWords(a);
+                b.orInto(words.data());
+                return fromWords(std::move(words));
+            }
+
+            static void addLow(Container& container, uint16_t low) noexcept {
+                if (container.type == RoaringContainer::run) {
+                    container = fromWords(toWords(refOf(container)));
+                }
+                if (container.type == RoaringContainer::bitmap) {
+                    uint64_t& word = container.words[low >> 6];
+                    const uint64_t bit = uint64_t{ 1 } << (low & 63);
+                    container.cardinality += (word & bit) ? 0 : 1;
+                    word |= bit;
+                    return;
+                }
+                auto& values = container.values;
+                if (values.empty() || values.back() < low) {
+                    values.push_back(low);
+                }
+                else {
+                    const auto it = std::lower_bound(values.begin(), values.end(), low);
+                    if (*it == low) {
+                        return;
+                    }
+                    values.insert(it, low);
+                }
+                ++container.cardinality;
+                if (container.cardinality > detail::roaring_array_max) {
+                    std::vector<uint64_t> words(detail::roaring_bitmap_words, 0);
+                    for (uint16_t x : values) {
+                        words[x >> 6] |= uint64_t{ 1 } << (x & 63);
+                    }
+                    container.type = RoaringContainer::bitmap;
+                    container.words = std::move(words);
+                    container.values.clear();
+                    container.values.shrink_to_fit();
+                }
+            }
+
+            [[nodiscard]] static size_t countRuns(const Container& container) noexcept {
+                size_t runs = 0;
+                if (container.type == RoaringContainer::array) {
+                    for (size_t i = 0; i < container.values.size(); ++i) {
+                        runs += (i == 0 || container.values[i] != container.values[i - 1] + 1);
+                    }
+                    return runs;
+                }
+                uint64_t carry = 0;  // Top bit of the previous word
+                for (uint64_t word : container.words) {
+                    runs += static_cast<size_t>(std::popcount(word & ~((word << 1) | carry)));
+                    carry = word >> 63;
+                }
+                return runs;
+            }
+
+            static void toRuns(Container& container) noexcept {
+                std::vector<uint16_t> runs;
+                bool open = false;
+                uint32_t start = 0;
+                uint32_t previous = 0;
+                refOf(container).forEach([&](uint16_t x) {
+                    if (open && x == previous + 1) {
+                        previous = x;
+                        return;
+                    }
+                    if (open) {
+                        runs.push_back(static_cast<uint16_t>(start));
+                        runs.push_back(static_cast<uint16_t>(previous - start));
+                    }
+                    open = true;
+                    start = x;
+                    previous = x;
+                });
+                if (open) {
+                    runs.push_back(static_cast<uint16_t>(start));
+                    runs.push_back(static_cast<uint16_t>(previous - start));
+                }
+                container.type = RoaringContainer::run;
+                container.values = std::move(runs);
+                container.words.clear();
+                container.words.shrink_to_fit();
+            }
+        };
+
+        /**
+         * @class BasicRoaringView
+         * @brief Zero-copy read-only view of a serialized RoaringBitmap
+         *
+         * The view only stores pointers into the buffer it was opened on; the
+         * buffer must outlive it. Containers are read in place, in Encoding.
+         *
+         * @tparam Encoding Endianness of the serialized integers
+         */
+        template <std::endian Encoding>
+        class BasicRoaringView {
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an empty view
+              */
+            explicit BasicRoaringView() noexcept = default;
+            /** @} */
+
+            /**
+             * @name Opening
+             * @{
+             */
+
+             /**
+              * @brief Attaches the view to a serialized bitmap
+              * @param buffer Read buffer positioned at the bitmap; advanced past it on success
+              * @return true if the data is malformed, false on success
+              *
+              * Validates the directory (keys ascending, container sizes and
+              * offsets in range) and every payload: arrays strictly increasing,
+              * runs sorted, disjoint and within 65535, and the values of each
+              * container adding up to its cardinality. Opening is therefore
+              * linear in the size of the data.
+              */
+            [[nodiscard]] bool open(BasicReadBuffer<Encoding>& buffer) noexcept {
+                if (buffer.size() < detail::roaring_header_size) {
+                    return true; // Error (truncated header)
+                }
+                const uint8_t* blob = buffer.data();
+                uint32_t magic = 0;
+                uint32_t containers = 0;
+                uint64_t total = 0;
+                basicCopy<Encoding>(magic, blob);
+                basicCopy<Encoding>(containers, blob + 4);
+                basicCopy<Encoding>(total, blob + 8);
+                if (magic != roaring_magic || containers > 65536 || total > buffer.size()
+                    || detail::roaring_header_size + static_cast<uint64_t>(containers) * detail::roaring_directory_entry > total) {
+                    return true; // Error (bad header)
+                }
+
+                int32_t previousKey = -1;
+                for (uint32_t i = 0; i < containers; ++i) {
+                    const uint8_t* entry = blob + detail::roaring_header_size + i * detail::roaring_directory_entry;
+                    uint16_t key = 0;
+                    RoaringContainer type = RoaringContainer::none;
+                    uint32_t cardinality = 0;
+                    uint32_t offset = 0;
+                    uint32_t count = 0;
+                    basicCopy<Encoding>(key, entry);
+                    basicCopy<Encoding>(type, entry + 2);
+                    basicCopy<Encoding>(cardinality, entry + 4);
+                    basicCopy<Encoding>(offset, entry + 8);
+                    basicCopy<Encoding>(count, entry + 12);
+                    uint64_t bytes = 0;
+                    bool valid = static_cast<int32_t>(key) > previousKey && cardinality > 0 && cardinality <= 65536;
+                    switch (type) {
+                    case RoaringContainer::array:
+                        valid = valid && count == cardinality && count <= detail::roaring_array_max;
+                        bytes = static_cast<uint64_t>(count) * 2;
+                        break;
+                    case RoaringContainer::bitmap:
+                        valid = valid && count == detail::roaring_bitmap_words;
+                        bytes = detail::roaring_bitmap_words * 8;
+                        break;
+                    case RoaringContainer::run:
+                        valid = valid && count > 0 && count <= 32768;
+                        bytes = static_cast<uint64_t>(count) * 4;
+                        break;
+                    default:
+                        valid = false;
+                        break;
+                    }
+                    if (!valid || offset > total || bytes > total - offset) {
+                        return true; // Error (bad directory entry)
+                    }
+                    detail::RoaringContainerRef<Encoding> ref;
+                    ref.type = type;
+                    ref.cardinality = cardinality;
+                    ref.count = count;
+                    ref.data = blob + offset;
+                    if (ref.checkPayload()) {
+                        return true; // Error (payload inconsistent with its directory entry)
+                    }
+                    previousKey = key;
+                }
+
+                m_blob = blob;
+                m_containers = containers;
+                buffer.skipFront(static_cast<size_t>(total));
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Queries
+             * @{
+             */
+
+             /**
+              * @brief Checks if a value is in the set
+              * @param x Value to look up
+              * @return true if the set holds the value
+              */
+            [[nodiscard]] bool contains(uint32_t x) const noexcept {
+                const uint16_t key = static_cast<uint16_t>(x >> 16);
+                size_t low = 0;
+                size_t high = m_containers;
+                while (low < high) {
+                    const size_t middle = low + (high - low) / 2;
+                    if (keyAt(middle) < key) low = middle + 1;
+                    else high = middle;
+                }
+                return low < m_containers && keyAt(low) == key
+                    && containerAt(low).contains(static_cast<uint16_t>(x & 0xFFFF));
+            }
+
+            /**
+             * @brief Gets the number of values in the set
+             * @return Cardinality
+             */
+            [[nodiscard]] uint64_t cardinality() const noexcept {
+                uint64_t total = 0;
+                for (size_t i = 0; i < m_containers; ++i) {
+                    total += containerAt(i).cardinality;
+                }
+                return total;
+            }
+
+            /**
+             * @brief Calls fn(uint32_t) for every value in ascending order
+             * @tparam Fn Callable as void(uint32_t)
+             * @param fn Function to call
+             */
+            template <typename Fn>
+            void forEach(Fn&& fn) const noexcept {
+                for (size_t i = 0; i < m_containers; ++i) {
+                    const uint32_t high = static_cast<uint32_t>(keyAt(i)) << 16;
+                    containerAt(i).forEach([&fn, high](uint16_t low) { fn(high | low); });
+                }
+            }
+            /** @} */
+
+            /**
+             * @name Container Access
+             * Common interface with RoaringBitmap used by the set algebra.
+             * @{
+             */
+            [[nodiscard]] size_t containerCount() const noexcept { return m_containers; }
+
+            [[nodiscard]] uint16_t keyAt(size_t index) const noexcept {
+                uint16_t key = 0;
+                basicCopy<Encoding>(key, entryAt(index));
+                return key;
+            }
+
+            [[nodiscard]] detail::RoaringContainerRef<Encoding> containerAt(size_t index) const noexcept {
+                const uint8_t* entry = entryAt(index);
+                detail::RoaringContainerRef<Encoding> ref;
+                uint32_t offset = 0;
+                basicCopy<Encoding>(ref.type, entry + 2);
+                basicCopy<Encoding>(ref.cardinality, entry + 4);
+                basicCopy<Encoding>(offset, entry + 8);
+                basicCopy<Encoding>(ref.count, entry + 12);
+                ref.data = m_blob + offset;
+                return ref;
+            }
+            /** @} */
+
+        private:
+            const uint8_t* m_blob{ nullptr };  ///< Start of the serialized bitmap
+            size_t m_containers{ 0 };          ///< Number of containers
+
+            [[nodiscard]] const uint8_t* entryAt(size_t index) const noexcept {
+                return m_blob + detail::roaring_header_size + index * detail::roaring_directory_entry;
+            }
+        };
+
+        /**
+         * @brief Roaring view that uses the default stream endianness
+         */
+        using RoaringView = BasicRoaringView<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_ROARING_SSE2
+
+#endif // MZ_ENDIAN_ROARING_HEADER_FILE
@@ -0,0 +1,363 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_SEARCH_TREE_HEADER_FILE
+#define MZ_ENDIAN_SEARCH_TREE_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianSearchTree.h
+ * @brief Static Eytzinger-layout search tree over sorted keys
+ *
+ * This header provides buildSearchTree, which writes a sorted key set in
+ * Eytzinger (BFS heap) order through a BasicVector, and BasicSearchTreeView,
+ * which answers lower-bound queries directly on that serialized form (for
+ * example, on a memory-mapped file) without building anything in memory.
+ *
+ * In Eytzinger order the first levels of the tree share a handful of cache
+ * lines and the 16 descendants four levels below a node are contiguous, so
+ * the search prefetches them one line ahead and runs branch-free.
+ *
+ * Serialized layout (64-byte header, so the keys keep the alignment of the
+ * buffer):
+ *   [uint32_t magic][uint32_t keySize][uint64_t count][48 bytes zero]
+ *   [(count + 1) keys, slot 0 unused][(count + 1) uint32_t sorted ranks]
+ *
+ * Integer keys are stored in Encoding; ByteArray keys are stored as raw bytes
+ * and ordered by memcmp, like ByteArray::operator<.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <concepts>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianByteArray.h"
+#include "EndianBitOps.h"
+
+namespace mz {
+    namespace endian {
+
+        namespace detail {
+
+            /**
+             * @brief Storage and ordering rules for a search tree key type
+             */
+            template <typename Key>
+            struct SearchKeyTraits;
+
+            template <std::integral Key>
+            struct SearchKeyTraits<Key> {
+                static constexpr size_t size{ sizeof(Key) };
+
+                template <std::endian Encoding>
+                static void store(uint8_t* destination, const Key& key) noexcept {
+                    basicCopy<Encoding>(destination, key);
+                }
+
+                template <std::endian Encoding>
+                [[nodiscard]] static bool less(const uint8_t* stored, const Key& key) noexcept {
+                    Key value{};
+                    basicCopy<Encoding>(value, stored);
+                    return value < key;
+                }
+
+                template <std::endian Encoding>
+                [[nodiscard]] static bool equal(const uint8_t* stored, const Key& key) noexcept {
+                    Key value{};
+                    basicCopy<Encoding>(value, stored);
+                    return value == key;
+                }
+            };
+
+            template <size_t N>
+            struct SearchKeyTraits<ByteArray<N>> {
+                static constexpr size_t size{ N };
+
+                template <std::endian Encoding>
+                static void store(uint8_t* destination, const ByteArray<N>& key) noexcept {
+                    std::memcpy(destination, key.data(), N);
+                }
+
+                template <std::endian Encoding>
+                [[nodiscard]] static bool less(const uint8_t* stored, const ByteArray<N>& key) noexcept {
+                    return std::memcmp(stored, key.data(), N) < 0;
+                }
+
+                template <std::endian Encoding>
+                [[nodiscard]] static bool equal(const uint8_t* stored, const ByteArray<N>& key) noexcept {
+                    return std::memcmp(stored, key.data(), N) == 0;
+                }
+            };
+
+            /**
+             * @brief Writes sorted keys into Eytzinger order (in-order walk of the implicit tree)
+             */
+            template <std::endian Encoding, typename Key>
+            void eytzingerFill(std::span<const Key> sorted, uint8_t* keys, uint8_t* ranks, size_t& next, size_t node) noexcept {
+                while (node <= sorted.size()) {
+                    eytzingerFill<Encoding>(sorted, keys, ranks, next, 2 * node);
+                    SearchKeyTraits<Key>::template store<Encoding>(keys + node * SearchKeyTraits<Key>::size, sorted[next]);
+                    basicCopy<Encoding>(ranks + node * 4, static_cast<uint32_t>(next));
+                    ++next;
+                    node = 2 * node + 1;
+                }
+            }
+
+        } // namespace detail
+
+        /**
+         * @brief Key types supported by the search tree: integers and ByteArray<N>
+         */
+        template <typename Key>
+        concept SearchTreeKey = requires { detail::SearchKeyTraits<Key>::size; };
+
+        /// Magic number at the start of a serialized search tree ("MZST")
+        static constexpr uint32_t search_tree_magic{ 0x54535A4DU };
+
+        /// Size of the serialized search tree header
+        static constexpr size_t search_tree_header_size{ 64 };
+
+        /**
+         * @brief Serializes a sorted key set as an Eytzinger search tree
+         * @tparam Encoding Endianness of integer keys and header fields
+         * @tparam Key Key type (integer or ByteArray<N>)
+         * @param sorted Keys in ascending order (duplicates allowed)
+         * @param vector Vector to append the tree to
+         * @return true if there are more keys than a uint32_t rank can address, false on success
+         */
+        template <std::endian Encoding, SearchTreeKey Key>
+        [[nodiscard]] bool buildSearchTree(std::span<const Key> sorted, BasicVector<Encoding>& vector) noexcept {
+            constexpr size_t keySize = detail::SearchKeyTraits<Key>::size;
+            const size_t count = sorted.size();
+            if (count >= 0xFFFFFFFFULL) {
+                return true; // Error (too many keys)
+            }
+
+            const size_t start = vector.size();
+            const size_t keysBytes = (count + 1) * keySize;
+            vector.expandBy(search_tree_header_size + keysBytes + (count + 1) * 4);
+            uint8_t* header = vector.data() + start;
+            std::memset(header, 0, search_tree_header_size);
+            basicCopy<Encoding>(header, search_tree_magic);
+            basicCopy<Encoding>(header + 4, static_cast<uint32_t>(keySize));
+            basicCopy<Encoding>(header + 8, static_cast<uint64_t>(count));
+
+            uint8_t* keys = header + search_tree_header_size;
+            uint8_t* ranks = keys + keysBytes;
+            std::memset(keys, 0, keySize);
+            basicCopy<Encoding>(ranks, static_cast<uint32_t>(count));
+
+            size_t next = 0;
+            detail::eytzingerFill<Encoding>(sorted, keys, ranks, next, 1);
+            return false; // Success (no error)
+        }
+
+        /**
+         * @class BasicSearchTreeView
+         * @brief Read-only lower-bound search over a serialized Eytzinger tree
+         *
+         * The view only stores pointers into the buffer it was opened on; the
+         * buffer must outlive it.
+         *
+         * @tparam Encoding Endianness of integer keys and header fields
+         * @tparam Key Key type (integer or ByteArray<N>)
+         */
+        template <std::endian Encoding, SearchTreeKey Key>
+        class BasicSearchTreeView {
+        public:
+            using key_type = Key;   ///< Key type
+
+            static constexpr size_t key_size{ detail::SearchKeyTraits<Key>::size }; ///< Stored key size
+            static constexpr size_t batch_size{ 16 };  ///< Queries descended in lockstep by the batch API
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an empty view
+              */
+            explicit BasicSearchTreeView() noexcept = default;
+            /** @} */
+
+            /**
+             * @name Opening
+             * @{
+             */
+
+             /**
+              * @brief Attaches the view to a serialized tree
+              * @param buffer Read buffer positioned at the tree; advanced past it on success
+              * @return true if the header or size is invalid, false on success
+              */
+            [[nodiscard]] bool open(BasicReadBuffer<Encoding>& buffer) noexcept {
+                uint32_t magic = 0;
+                uint32_t keySize = 0;
+                uint64_t count = 0;
+                if (buffer.size() < search_tree_header_size) {
+                    return true; // Error (truncated header)
+                }
+                basicCopy<Encoding>(magic, buffer.data());
+                basicCopy<Encoding>(keySize, buffer.data() + 4);
+                basicCopy<Encoding>(count, buffer.data() + 8);
+                if (magic != search_tree_magic || keySize != key_size || count >= 0xFFFFFFFFULL) {
+                    return true; // Error (bad header)
+                }
+                const size_t bodySize = static_cast<size_t>(count + 1) * (key_size + 4);
+                if (buffer.size() - search_tree_header_size < bodySize) {
+                    return true; // Error (truncated body)
+                }
+                m_keys = buffer.data() + search_tree_header_size;
+                m_ranks = m_keys + static_cast<size_t>(count + 1) * key_size;
+                m_count = static_cast<size_t>(count);
+                buffer.skipFront(search_tree_header_size + bodySize);
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Queries
+             * @{
+             */
+
+             /**
+              * @brief Gets the number of keys
+              * @return Number of keys in the tree
+              */
+            [[nodiscard]] size_t size() const noexcept { return m_count; }
+
+            /**
+             * @brief Finds the sorted position of the first key not less than a query
+             * @param key Query key
+             * @return Rank in [0, size()]; size() if every key is less than the query
+             */
+            [[nodiscard]] size_t lowerBound(const Key& key) const noexcept {
+                return rankOf(descend(key));
+            }
+
+            /**
+             * @brief Checks if a key is present
+             * @param key Query key
+             * @return true if the tree holds the key
+             */
+            [[nodiscard]] bool contains(const Key& key) const noexcept {
+                const size_t node = descend(key);
+                return node != 0 && detail::SearchKeyTraits<Key>::template equal<Encoding>(keyAt(node), key);
+            }
+
+            /**
+             * @brief Answers many lower-bound queries at once
+             * @param keys Query keys
+             * @param ranks Receives one rank per query (must be at least keys.size() long)
+             *
+             * Queries are descended batch_size at a time, one level per step, so
+             * the cache misses of independent queries overlap instead of being
+             * paid one after another.
+             */
+            void lowerBound(std::span<const Key> keys, std::span<size_t> ranks) const noexcept {
+                const size_t levels = static_cast<size_t>(std::bit_width(m_count));
+                size_t nodes[batch_size];
+                for (size_t base = 0; base < keys.size(); base += batch_size) {
+                    const size_t count = std::min(batch_size, keys.size() - base);
+                    std::fill(nodes, nodes + count, size_t{ 1 });
+                    for (size_t level = 0; level < levels; ++level) {
+                        for (size_t i = 0; i < count; ++i) {
+                            if (nodes[i] <= m_count) {
+                                prefetch(nodes[i]);
+                                nodes[i] = 2 * nodes[i] + less(nodes[i], keys[base + i]);
+                            }
+                        }
+                    }
+                    for (size_t i = 0; i < count; ++i) {
+                        ranks[base + i] = rankOf(nodes[i] >> (std::countr_zero(~nodes[i]) + 1));
+                    }
+                }
+            }
+            /** @} */
+
+        private:
+            static constexpr unsigned prefetch_levels{ 4 };  ///< Prefetch the 16 descendants this far down
+
+            const uint8_t* m_keys{ nullptr };   ///< Key slots (slot 0 unused)
+            const uint8_t* m_ranks{ nullptr };  ///< Sorted rank of each slot
+            size_t m_count{ 0 };                ///< Number of keys
+
+            [[nodiscard]] const uint8_t* keyAt(size_t node) const noexcept {
+                return m_keys + node * key_size;
+            }
+
+            [[nodiscard]] bool less(size_t node, const Key& key) const noexcept {
+                return detail::SearchKeyTraits<Key>::template less<Encoding>(keyAt(node), key);
+            }
+
+            void prefetch(size_t node) const noexcept {
+                if (const size_t descendant = node << prefetch_levels; descendant <= m_count) {
+                    prefetchRead(keyAt(descendant));
+                }
+            }
+
+            /**
+             * @brief Branch-free Eytzinger descent
+             * @return Slot of the lower bound, or 0 if there is none
+             */
+            [[nodiscard]] size_t descend(const Key& key) const noexcept {
+                size_t node = 1;
+                while (node <= m_count) {
+                    prefetch(node);
+                    node = 2 * node + less(node, key);
+                }
+                // Undo the trailing right turns plus the last left turn
+                return node >> (std::countr_zero(~node) + 1);
+            }
+
+            [[nodiscard]] size_t rankOf(size_t node) const noexcept {
+                if (node == 0) {
+                    return m_count;
+                }
+                uint32_t rank = 0;
+                basicCopy<Encoding>(rank, m_ranks + node * 4);
+                return rank;
+            }
+        };
+
+        /**
+         * @brief Search tree view that uses the default stream endianness
+         * @tparam Key Key type (integer or ByteArray<N>)
+         */
+        template <SearchTreeKey Key>
+        using SearchTreeView = BasicSearchTreeView<stream_endian, Key>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_SEARCH_TREE_HEADER_FILE
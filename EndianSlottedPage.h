@@ -0,0 +1,447 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_SLOTTED_PAGE_HEADER_FILE
+#define MZ_ENDIAN_SLOTTED_PAGE_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianSlottedPage.h
+ * @brief Slotted-page layout for variable-length records updated in place
+ *
+ * This header defines BasicSlottedPage, which manages a caller-owned page of
+ * bytes (for example a page of an mmapped file). The slot array grows from
+ * the front and records grow from the back, so records can be inserted,
+ * resized and erased without rewriting anything but the page itself. Slot
+ * numbers stay stable for the lifetime of a record.
+ *
+ * Records use the same [uint32_t size][bytes][uint32_t size] framing as
+ * strings in BasicWriteBuffer, so a record obtained with record() can be read
+ * from either end with popFront or popBack.
+ *
+ * Page layout (all integers in Encoding):
+ *   [uint32_t magic][uint32_t page size][uint32_t slots][uint32_t records begin]
+ *   [uint32_t garbage bytes][uint32_t live records]
+ *   [slots x ([uint32_t record offset, 0 if free][uint32_t record size])]
+ *   [free space][records]
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+
+namespace mz {
+    namespace endian {
+
+        /// Magic number at the start of a slotted page ("MZSP")
+        static constexpr uint32_t slotted_page_magic{ 0x50535A4DU };
+
+        /**
+         * @class BasicSlottedPage
+         * @brief Variable-length records in one fixed-size page
+         *
+         * The object only stores a span over the page; all state lives in the
+         * page header, so a page can be reopened at any time. Space left behind
+         * by erased or shrunk records is tracked as garbage and reclaimed by
+         * compact(), which insert() and update() call on their own when the
+         * contiguous free space is too small.
+         *
+         * @tparam Encoding Endianness of the page integers
+         */
+        template <std::endian Encoding>
+        class BasicSlottedPage {
+        public:
+            /// Size of the page header in bytes
+            static constexpr size_t header_size{ 24 };
+
+            /// Size of one slot array entry in bytes
+            static constexpr size_t slot_size{ 8 };
+
+            /// Framing bytes around every record (a size prefix and suffix)
+            static constexpr size_t record_overhead{ 8 };
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Default constructor; creates an object with no page
+              */
+            explicit BasicSlottedPage() noexcept = default;
+            /** @} */
+
+            /**
+             * @name Page Operations
+             * @{
+             */
+
+             /**
+              * @brief Initializes an empty page
+              * @param page Page bytes; must outlive this object
+              * @return true if the page is smaller than the header or larger than 4 GiB, false on success
+              */
+            [[nodiscard]] bool format(std::span<uint8_t> page) noexcept {
+                if (page.size() < header_size || page.size() > UINT32_MAX) {
+                    return true; // Error (unsupported page size)
+                }
+                m_page = page;
+                std::memset(page.data(), 0, header_size);
+                store(0, slotted_page_magic);
+                store(4, static_cast<uint32_t>(page.size()));
+                store(12, static_cast<uint32_t>(page.size()));
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Attaches to a page that was formatted before
+             * @param page Page bytes; must outlive this object
+             * @return true if the header does not describe a valid page of this size, or a
+             *         slot points outside the record area, false on success
+             */
+            [[nodiscard]] bool open(std::span<uint8_t> page) noexcept {
+                if (page.size() < header_size || page.size() > UINT32_MAX) {
+                    return true; // Error (unsupported page size)
+                }
+                m_page = page;
+                const uint64_t slotsEnd = header_size + uint64_t{ slotCount() } * slot_size;
+                if (load(0) != slotted_page_magic || load(4) != page.size()
+                    || slotsEnd > recordsBegin() || recordsBegin() > page.size() || garbage() > page.size() - recordsBegin()) {
+                    m_page = {};
+                    return true; // Error (bad header)
+                }
+                uint32_t live = 0;
+                for (uint32_t slot = 0; slot < slotCount(); ++slot) {
+                    if (slotOffset(slot) == 0) {
+                        continue;
+                    }
+                    if (!isLive(slot)) {
+                        m_page = {};
+                        return true; // Error (slot outside the record area)
+                    }
+                    ++live;
+                }
+                if (live != liveCount()) {
+                    m_page = {};
+                    return true; // Error (live count does not match the slots)
+                }
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Moves all live records to the back of the page, merging free space
+             */
+            void compact() noexcept {
+                if (garbage() == 0) {
+                    return;
+                }
+                std::vector<uint32_t> live;
+                live.reserve(liveCount());
+                for (uint32_t slot = 0; slot < slotCount(); ++slot) {
+                    if (isLive(slot)) {
+                        live.push_back(slot);
+                    }
+                }
+                // Highest record first, so each move only overwrites bytes already moved or dead
+                std::sort(live.begin(), live.end(), [this](uint32_t a, uint32_t b) { return slotOffset(a) > slotOffset(b); });
+                uint32_t end = static_cast<uint32_t>(m_page.size());
+                for (const uint32_t slot : live) {
+                    const uint32_t length = slotLength(slot) + record_overhead;
+                    end -= length;
+                    std::memmove(m_page.data() + end, m_page.data() + slotOffset(slot), length);
+                    store(slotEntry(slot), end);
+                }
+                store(12, end);
+                store(16, 0);
+            }
+            /** @} */
+
+            /**
+             * @name Record Operations
+             * @{
+             */
+
+             /**
+              * @brief Adds a record, reusing a free slot when there is one
+              * @param bytes Record contents
+              * @param slot Receives the slot of the new record
+              * @return true if the page has no room even after compaction, false on success
+              */
+            [[nodiscard]] bool insert(std::span<const uint8_t> bytes, uint32_t& slot) noexcept {
+                uint32_t target = slotCount();
+                for (uint32_t i = 0; i < slotCount(); ++i) {
+                    if (slotOffset(i) == 0) {
+                        target = i;
+                        break;
+                    }
+                }
+                const uint64_t slotBytes = target == slotCount() ? slot_size : 0;
+                if (reserve(bytes.size() + record_overhead + slotBytes)) {
+                    return true; // Error (page full)
+                }
+                if (slotBytes) {
+                    store(8, slotCount() + 1);
+                }
+                writeRecord(target, bytes);
+                store(20, liveCount() + 1);
+                slot = target;
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Replaces the contents of a record, keeping its slot
+             * @param slot Slot of a live record
+             * @param bytes New contents
+             * @return true if the slot is not live or the page has no room, false on success
+             *
+             * Records that shrink are rewritten in place; records that grow are
+             * moved, compacting the page first if necessary. On error the page is
+             * unchanged.
+             */
+            [[nodiscard]] bool update(uint32_t slot, std::span<const uint8_t> bytes) noexcept {
+                if (!isLive(slot)) {
+                    return true; // Error (no such record)
+                }
+                const uint32_t oldLength = slotLength(slot);
+                if (bytes.size() <= oldLength) {
+                    const uint32_t offset = slotOffset(slot);
+                    writeFrame(offset, bytes);
+                    store(slotEntry(slot) + 4, static_cast<uint32_t>(bytes.size()));
+                    store(16, garbage() + oldLength - static_cast<uint32_t>(bytes.size()));
+                    return false; // Success (no error)
+                }
+                if (bytes.size() + record_overhead > contiguousFreeSpace() + garbage() + oldLength + record_overhead) {
+                    return true; // Error (page full)
+                }
+                release(slot);
+                (void)reserve(bytes.size() + record_overhead);
+                writeRecord(slot, bytes);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Removes a record; its slot may be reused by a later insert
+             * @param slot Slot of a live record
+             * @return true if the slot is not live, false on success
+             */
+            [[nodiscard]] bool erase(uint32_t slot) noexcept {
+                if (!isLive(slot)) {
+                    return true; // Error (no such record)
+                }
+                release(slot);
+                store(20, liveCount() - 1);
+
+                // Give trailing free slots back to the free space
+                uint32_t slots = slotCount();
+                while (slots > 0 && slotOffset(slots - 1) == 0) {
+                    --slots;
+                }
+                store(8, slots);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Gets the contents of a record
+             * @param slot Slot of a live record
+             * @param bytes Receives a span over the contents inside the page
+             * @return true if the slot is not live or its framing is damaged, false on success
+             */
+            [[nodiscard]] bool read(uint32_t slot, std::span<const uint8_t>& bytes) const noexcept {
+                if (!isLive(slot)) {
+                    return true; // Error (no such record)
+                }
+                BasicReadBuffer<Encoding> buffer(m_page.data() + slotOffset(slot), slotLength(slot) + record_overhead);
+                uint32_t prefix = 0;
+                uint32_t suffix = 0;
+                if (buffer.popFront(prefix) || buffer.popBack(suffix) || prefix != slotLength(slot) || suffix != prefix) {
+                    return true; // Error (damaged framing)
+                }
+                bytes = std::span<const uint8_t>(buffer.data(), prefix);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Gets a framed record as a read buffer
+             * @param slot Slot of a live record
+             * @param buffer Receives a buffer over [size][bytes][size], readable with popFront or popBack
+             * @return true if the slot is not live, false on success
+             */
+            [[nodiscard]] bool record(uint32_t slot, BasicReadBuffer<Encoding>& buffer) const noexcept {
+                if (!isLive(slot)) {
+                    return true; // Error (no such record)
+                }
+                buffer = BasicReadBuffer<Encoding>(m_page.data() + slotOffset(slot), slotLength(slot) + record_overhead);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Visits all live records in slot order
+             * @tparam Visitor Callable as bool(uint32_t slot, std::span<const uint8_t> bytes); return false to stop
+             * @param visitor Callback
+             */
+            template <typename Visitor>
+            void forEach(Visitor&& visitor) const noexcept {
+                for (uint32_t slot = 0; slot < slotCount(); ++slot) {
+                    std::span<const uint8_t> bytes;
+                    if (!read(slot, bytes) && !visitor(slot, bytes)) {
+                        return;
+                    }
+                }
+            }
+            /** @} */
+
+            /**
+             * @name Free Space
+             * @{
+             */
+
+             /**
+              * @brief Gets the number of slots, live or free
+              * @return Slot count
+              */
+            [[nodiscard]] uint32_t slotCount() const noexcept { return load(8); }
+
+            /**
+             * @brief Gets the number of live records
+             * @return Record count
+             */
+            [[nodiscard]] uint32_t liveCount() const noexcept { return load(20); }
+
+            /**
+             * @brief Gets the bytes between the slot array and the records
+             * @return Contiguous free bytes
+             */
+            [[nodiscard]] size_t contiguousFreeSpace() const noexcept {
+                return recordsBegin() - (header_size + size_t{ slotCount() } * slot_size);
+            }
+
+            /**
+             * @brief Gets the free bytes available after compaction
+             * @return Contiguous free bytes plus garbage
+             *
+             * A new record of n bytes needs n + record_overhead of these, plus
+             * slot_size when no free slot is left.
+             */
+            [[nodiscard]] size_t freeSpace() const noexcept {
+                return contiguousFreeSpace() + garbage();
+            }
+
+            /**
+             * @brief Checks if a slot holds a record
+             * @param slot Slot number
+             * @return true if the slot is in range and live
+             */
+            [[nodiscard]] bool isLive(uint32_t slot) const noexcept {
+                return slot < slotCount() && slotOffset(slot) != 0
+                    && slotOffset(slot) >= recordsBegin() && uint64_t{ slotOffset(slot) } + slotLength(slot) + record_overhead <= m_page.size();
+            }
+            /** @} */
+
+        private:
+            std::span<uint8_t> m_page;  ///< Page bytes, owned by the caller
+
+            [[nodiscard]] uint32_t load(size_t offset) const noexcept {
+                uint32_t value = 0;
+                basicCopy<Encoding>(value, m_page.data() + offset);
+                return value;
+            }
+
+            void store(size_t offset, uint32_t value) noexcept {
+                basicCopy<Encoding>(m_page.data() + offset, value);
+            }
+
+            [[nodiscard]] uint32_t recordsBegin() const noexcept { return load(12); }
+            [[nodiscard]] uint32_t garbage() const noexcept { return load(16); }
+            [[nodiscard]] static size_t slotEntry(uint32_t slot) noexcept { return header_size + size_t{ slot } * slot_size; }
+            [[nodiscard]] uint32_t slotOffset(uint32_t slot) const noexcept { return load(slotEntry(slot)); }
+            [[nodiscard]] uint32_t slotLength(uint32_t slot) const noexcept { return load(slotEntry(slot) + 4); }
+
+            /**
+             * @brief Makes bytes contiguous, compacting if needed
+             * @return true if there is not enough space even after compaction
+             */
+            [[nodiscard]] bool reserve(uint64_t bytes) noexcept {
+                if (bytes > freeSpace()) {
+                    return true; // Error (page full)
+                }
+                if (bytes > contiguousFreeSpace()) {
+                    compact();
+                }
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Marks a record's bytes as garbage and frees its slot
+             */
+            void release(uint32_t slot) noexcept {
+                const uint32_t length = slotLength(slot) + record_overhead;
+                if (slotOffset(slot) == recordsBegin()) {
+                    store(12, recordsBegin() + length); // Lowest record: give the bytes straight back
+                }
+                else {
+                    store(16, garbage() + length);
+                }
+                store(slotEntry(slot), 0);
+                store(slotEntry(slot) + 4, 0);
+            }
+
+            /**
+             * @brief Writes [size][bytes][size] at an offset through a BasicWriteBuffer
+             */
+            void writeFrame(uint32_t offset, std::span<const uint8_t> bytes) noexcept {
+                BasicWriteBuffer<Encoding> buffer(m_page.data() + offset, bytes.size() + record_overhead);
+                buffer.unsafePushBack(static_cast<uint32_t>(bytes.size()));
+                buffer.unsafePushBack(bytes);
+                buffer.unsafePushBack(static_cast<uint32_t>(bytes.size()));
+            }
+
+            /**
+             * @brief Places a record below the lowest one and points a slot at it
+             */
+            void writeRecord(uint32_t slot, std::span<const uint8_t> bytes) noexcept {
+                const uint32_t offset = recordsBegin() - static_cast<uint32_t>(bytes.size() + record_overhead);
+                writeFrame(offset, bytes);
+                store(12, offset);
+                store(slotEntry(slot), offset);
+                store(slotEntry(slot) + 4, static_cast<uint32_t>(bytes.size()));
+            }
+        };
+
+        /**
+         * @brief Slotted page that uses the default stream endianness
+         */
+        using SlottedPage = BasicSlottedPage<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_SLOTTED_PAGE_HEADER_FILE
@@ -0,0 +1,562 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_SNAPSHOT_HEADER_FILE
+#define MZ_ENDIAN_SNAPSHOT_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianSnapshot.h
+ * @brief Parallel checkpoint and restore of registered in-memory tables
+ *
+ * This header defines BasicSnapshotTable, the interface a table implements to
+ * take part in snapshots, and BasicSnapshotEngine, which saves and restores
+ * all registered tables using every core.
+ *
+ * Each table is split into independent parts. On save, worker threads take
+ * parts from a shared counter, serialize each into a BasicVector chunk and
+ * append it, with a frame and a CRC-32C, to the worker's own data file through
+ * a BasicFileWriter, so every file is written with large sequential I/O. A
+ * manifest listing every chunk is written last and renamed into place, so an
+ * interrupted save never replaces a good snapshot. On restore the data files
+ * are mmapped and the chunks are verified and decoded in parallel.
+ *
+ * Each save is a new generation G, one more than the manifest it replaces,
+ * and writes its data files as path.G.N, so the files the current manifest
+ * refers to are never opened for writing. Data files and the manifest are
+ * synced to storage before the manifest is renamed into place; only then are
+ * the previous generation's files removed.
+ *
+ * Files (all integers in Encoding):
+ *   path: [uint32_t magic][uint32_t version][uint64_t generation][uint32_t files][uint32_t tables]
+ *         tables x ([string name][uint64_t parts])
+ *         [uint64_t chunks] chunks x ([uint32_t table][uint32_t file][uint64_t part]
+ *         [uint64_t offset][uint64_t length][uint32_t crc][uint32_t 0])
+ *         [uint32_t crc of everything before]
+ *   path.G.N: chunks x ([uint32_t magic][uint32_t table][uint64_t part][uint64_t length]
+ *           [uint32_t crc][uint32_t 0][payload])
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <span>
+#include <bit>
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianFileStream.h"
+#include "EndianMappedFile.h"
+#include "EndianChecksum.h"
+
+namespace mz {
+    namespace endian {
+
+        /// Magic number at the start of a snapshot manifest ("MZSN")
+        static constexpr uint32_t snapshot_magic{ 0x4E535A4DU };
+
+        /// Magic number at the start of every snapshot chunk frame ("MZSC")
+        static constexpr uint32_t snapshot_chunk_magic{ 0x43535A4DU };
+
+        /// Manifest format version
+        static constexpr uint32_t snapshot_version{ 2 };
+
+        /**
+         * @class BasicSnapshotTable
+         * @brief Interface of a table that can be saved in and restored from snapshots
+         *
+         * save() is called concurrently for different parts while the engine is
+         * saving, and restore() concurrently for different parts while it is
+         * restoring, so parts must not share mutable state. The table must not be
+         * modified by other threads during either operation.
+         *
+         * @tparam Encoding Endianness of the serialized data
+         */
+        template <std::endian Encoding>
+        class BasicSnapshotTable {
+        public:
+            virtual ~BasicSnapshotTable() noexcept = default;
+
+            /**
+             * @brief Gets the number of independently serializable parts
+             * @return Part count (for example, the number of shards)
+             */
+            [[nodiscard]] virtual size_t partCount() const noexcept = 0;
+
+            /**
+             * @brief Serializes one part
+             * @param part Part index in [0, partCount())
+             * @param vector Empty vector that receives the part
+             * @return true on error, false on success
+             */
+            [[nodiscard]] virtual bool save(size_t part, BasicVector<Encoding>& vector) const noexcept = 0;
+
+            /**
+             * @brief Prepares the table for restoring a number of parts
+             * @param parts Part count recorded in the snapshot
+             * @return true if the table cannot take this many parts, false on success
+             *
+             * Called once, before any restore(). The default clears nothing and
+             * accepts any count.
+             */
+            [[nodiscard]] virtual bool prepareRestore(size_t parts) noexcept {
+                (void)parts;
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Restores one part
+             * @param part Part index
+             * @param buffer Buffer holding exactly what save() wrote for this part
+             * @return true on error, false on success
+             */
+            [[nodiscard]] virtual bool restore(size_t part, BasicReadBuffer<Encoding>& buffer) noexcept = 0;
+        };
+
+        /**
+         * @class BasicSnapshotEngine
+         * @brief Saves and restores registered tables in parallel
+         *
+         * @tparam Encoding Endianness of the snapshot files
+         */
+        template <std::endian Encoding>
+        class BasicSnapshotEngine {
+        public:
+            /**
+             * @brief Tuning parameters of the engine
+             */
+            struct Options {
+                size_t threadCount{ 0 };                   ///< Worker threads and data files (0 = hardware concurrency)
+                size_t blockSize{ size_t{ 8 } << 20 };     ///< Size of each write issued to a data file
+            };
+
+            /// Size of the frame written before every chunk payload
+            static constexpr size_t chunk_header_size{ 32 };
+
+            /// Size of each chunk entry in the manifest
+            static constexpr size_t chunk_entry_size{ 40 };
+
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs an engine with no tables
+              * @param options Tuning parameters
+              */
+            explicit BasicSnapshotEngine(Options options = Options{}) noexcept
+                : m_options{ options } {
+                if (m_options.threadCount == 0) {
+                    m_options.threadCount = std::thread::hardware_concurrency();
+                }
+                m_options.threadCount = std::max<size_t>(m_options.threadCount, 1);
+            }
+            /** @} */
+
+            /**
+             * @name Tables
+             * @{
+             */
+
+             /**
+              * @brief Registers a table under a unique name
+              * @param name Name stored in the snapshot and matched on restore
+              * @param table Table; must outlive the engine
+              * @return true if the name is already registered, false on success
+              */
+            [[nodiscard]] bool registerTable(const std::string& name, BasicSnapshotTable<Encoding>& table) noexcept {
+                if (findTable(name) != m_tables.size()) {
+                    return true; // Error (duplicate name)
+                }
+                m_tables.push_back(TableEntry{ name, &table });
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Snapshots
+             * @{
+             */
+
+             /**
+              * @brief Saves all registered tables
+              * @param path Manifest path; data files are written next to it as path.G.0, path.G.1, ...
+              * @return true if a table failed to serialize or any I/O failed, false on success
+              *
+              * On failure the previous snapshot, if any, is left intact.
+              */
+            [[nodiscard]] bool save(const std::string& path) noexcept {
+                uint64_t previousGeneration = 0;
+                uint32_t previousFiles = 0;
+                const bool hadPrevious = !readGeneration(path, previousGeneration, previousFiles);
+                const uint64_t generation = hadPrevious ? previousGeneration + 1 : 1;
+
+                std::vector<Task> tasks;
+                for (uint32_t t = 0; t < m_tables.size(); ++t) {
+                    const size_t parts = m_tables[t].table->partCount();
+                    for (size_t part = 0; part < parts; ++part) {
+                        tasks.push_back(Task{ t, part });
+                    }
+                }
+                const size_t files = std::max<size_t>(std::min(m_options.threadCount, tasks.size()), 1);
+                std::vector<std::vector<Chunk>> chunks(files);
+                auto discard = [&]() {
+                    for (size_t file = 0; file < files; ++file) {
+                        (void)std::remove(dataPath(path, generation, file).c_str());
+                    }
+                    removeDataFiles(path, generation, files);
+                };
+                std::atomic<size_t> next{ 0 };
+                std::atomic<bool> failed{ false };
+
+                auto work = [&](uint32_t file) {
+                    BasicFileWriter<Encoding> writer(m_options.blockSize);
+                    if (writer.open(dataPath(path, generation, file))) {
+                        failed = true;
+                        return;
+                    }
+                    BasicVector<Encoding> vector;
+                    for (size_t index = next++; index < tasks.size() && !failed; index = next++) {
+                        const Task& task = tasks[index];
+                        vector.clear();
+                        if (m_tables[task.table].table->save(task.part, vector)) {
+                            failed = true;
+                            break;
+                        }
+                        const std::span<const uint8_t> payload(vector.data(), vector.size());
+                        const uint32_t crc = crc32c(payload);
+                        writer.pushBack(snapshot_chunk_magic);
+                        writer.pushBack(task.table);
+                        writer.pushBack(static_cast<uint64_t>(task.part));
+                        writer.pushBack(static_cast<uint64_t>(payload.size()));
+                        writer.pushBack(crc);
+                        writer.pushBack(uint32_t{ 0 });
+                        chunks[file].push_back(Chunk{ task.table, file, task.part, writer.position(), payload.size(), crc });
+                        writer.write(payload);
+                    }
+                    if (writer.sync() || writer.close()) {
+                        failed = true;
+                    }
+                };
+                std::vector<std::thread> workers;
+                workers.reserve(files - 1);
+                for (uint32_t file = 1; file < files; ++file) {
+                    workers.emplace_back(work, file);
+                }
+                work(0);
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+                if (failed) {
+                    discard();
+                    return true; // Error (serialization or I/O failed)
+                }
+
+                // Manifest last, through a temporary file, so a crash never leaves a half-written snapshot in place
+                BasicVector<Encoding> manifest;
+                manifest.pushBack(snapshot_magic);
+                manifest.pushBack(snapshot_version);
+                manifest.pushBack(generation);
+                manifest.pushBack(static_cast<uint32_t>(files));
+                manifest.pushBack(static_cast<uint32_t>(m_tables.size()));
+                for (const TableEntry& entry : m_tables) {
+                    manifest.pushBack(entry.name);
+                    manifest.pushBack(static_cast<uint64_t>(entry.table->partCount()));
+                }
+                manifest.pushBack(static_cast<uint64_t>(tasks.size()));
+                for (const auto& fileChunks : chunks) {
+                    for (const Chunk& chunk : fileChunks) {
+                        manifest.pushBack(chunk.table);
+                        manifest.pushBack(chunk.file);
+                        manifest.pushBack(static_cast<uint64_t>(chunk.part));
+                        manifest.pushBack(chunk.offset);
+                        manifest.pushBack(chunk.length);
+                        manifest.pushBack(chunk.crc);
+                        manifest.pushBack(uint32_t{ 0 });
+                    }
+                }
+                manifest.pushBack(crc32c(std::span<const uint8_t>(manifest.data(), manifest.size())));
+
+                const std::string temporary = path + ".tmp";
+                BasicFileWriter<Encoding> writer;
+                if (writer.open(temporary)) {
+                    discard();
+                    return true; // Error (cannot create manifest)
+                }
+                writer.write(std::span<const uint8_t>(manifest.data(), manifest.size()));
+                if (writer.sync() || writer.close() || std::rename(temporary.c_str(), path.c_str()) != 0) {
+                    (void)std::remove(temporary.c_str());
+                    discard();
+                    return true; // Error (cannot write manifest)
+                }
+
+                // The new snapshot is in place: drop the previous generation and any
+                // extra files an interrupted save of this generation left behind
+                if (hadPrevious) {
+                    for (uint32_t file = 0; file < previousFiles; ++file) {
+                        (void)std::remove(dataPath(path, previousGeneration, file).c_str());
+                    }
+                }
+                removeDataFiles(path, generation, files);
+                return false; // Success (no error)
+            }
+
+            /**
+             * @brief Restores all tables recorded in a snapshot
+             * @param path Manifest path given to save()
+             * @return true if the snapshot is unreadable, damaged, or names an unregistered table,
+             *         or if a table failed to restore, false on success
+             *
+             * Every table named in the snapshot must be registered; registered
+             * tables that are not in the snapshot are left alone.
+             */
+            [[nodiscard]] bool restore(const std::string& path) noexcept {
+                MappedFile manifestFile;
+                if (manifestFile.open(path) || manifestFile.size() < 4) {
+                    return true; // Error (cannot map manifest)
+                }
+                const std::span<const uint8_t> manifestBytes = manifestFile.bytes();
+                uint32_t storedCrc = 0;
+                basicCopy<Encoding>(storedCrc, manifestBytes.data() + manifestBytes.size() - 4);
+                if (crc32c(manifestBytes.first(manifestBytes.size() - 4)) != storedCrc) {
+                    return true; // Error (damaged manifest)
+                }
+
+                BasicReadBuffer<Encoding> manifest(manifestBytes.data(), manifestBytes.size() - 4);
+                uint32_t magic = 0;
+                uint32_t version = 0;
+                uint64_t generation = 0;
+                uint32_t files = 0;
+                uint32_t tableCount = 0;
+                if (manifest.popFront(magic) || manifest.popFront(version) || manifest.popFront(generation) || manifest.popFront(files)
+                    || manifest.popFront(tableCount) || magic != snapshot_magic || version != snapshot_version) {
+                    return true; // Error (not a snapshot manifest)
+                }
+                if (tableCount > manifest.size() / 8) {
+                    return true; // Error (more tables than the manifest can hold)
+                }
+                // Every part needs a chunk entry, which bounds the part counts without overflow
+                const uint64_t maxChunks = manifest.size() / chunk_entry_size;
+                std::vector<size_t> tableIndex(tableCount);
+                std::vector<uint64_t> partBase(tableCount + 1, 0);
+                for (uint32_t t = 0; t < tableCount; ++t) {
+                    std::string name;
+                    uint64_t parts = 0;
+                    if (manifest.popFront(name) || manifest.popFront(parts)) {
+                        return true; // Error (truncated table list)
+                    }
+                    if (parts > maxChunks - partBase[t]) {
+                        return true; // Error (more parts than chunk entries)
+                    }
+                    tableIndex[t] = findTable(name);
+                    if (tableIndex[t] == m_tables.size() || m_tables[tableIndex[t]].table->prepareRestore(static_cast<size_t>(parts))) {
+                        return true; // Error (unknown table or table refused)
+                    }
+                    partBase[t + 1] = partBase[t] + parts;
+                }
+                uint64_t chunkCount = 0;
+                if (manifest.popFront(chunkCount) || chunkCount != partBase.back()
+                    || manifest.size() % chunk_entry_size != 0 || manifest.size() / chunk_entry_size != chunkCount) {
+                    return true; // Error (chunk list does not cover every part)
+                }
+                std::vector<Chunk> chunks(static_cast<size_t>(chunkCount));
+                std::vector<uint8_t> seen(static_cast<size_t>(chunkCount), 0);
+                for (Chunk& chunk : chunks) {
+                    uint32_t reserved = 0;
+                    manifest.unsafePopFront(chunk.table);
+                    manifest.unsafePopFront(chunk.file);
+                    manifest.unsafePopFront(chunk.part);
+                    manifest.unsafePopFront(chunk.offset);
+                    manifest.unsafePopFront(chunk.length);
+                    manifest.unsafePopFront(chunk.crc);
+                    manifest.unsafePopFront(reserved);
+                    if (chunk.table >= tableCount || chunk.file >= files || chunk.part >= partBase[chunk.table + 1] - partBase[chunk.table]
+                        || std::exchange(seen[static_cast<size_t>(partBase[chunk.table] + chunk.part)], uint8_t{ 1 })) {
+                        return true; // Error (bad or duplicate chunk entry)
+                    }
+                }
+
+                std::vector<MappedFile> dataFiles(files);
+                for (uint32_t file = 0; file < files; ++file) {
+                    if (dataFiles[file].open(dataPath(path, generation, file))) {
+                        return true; // Error (cannot map data file)
+                    }
+                }
+
+                std::atomic<size_t> next{ 0 };
+                std::atomic<bool> failed{ false };
+                auto work = [&]() {
+                    for (size_t index = next++; index < chunks.size() && !failed; index = next++) {
+                        const Chunk& chunk = chunks[index];
+                        if (verifyChunk(dataFiles[chunk.file], chunk)) {
+                            failed = true;
+                            break;
+                        }
+                        BasicReadBuffer<Encoding> payload(dataFiles[chunk.file].data() + chunk.offset, static_cast<size_t>(chunk.length));
+                        if (m_tables[tableIndex[chunk.table]].table->restore(static_cast<size_t>(chunk.part), payload)) {
+                            failed = true;
+                            break;
+                        }
+                    }
+                };
+                const size_t threads = std::max<size_t>(std::min(m_options.threadCount, chunks.size()), 1);
+                std::vector<std::thread> workers;
+                workers.reserve(threads - 1);
+                for (size_t t = 1; t < threads; ++t) {
+                    workers.emplace_back(work);
+                }
+                work();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+                return failed;
+            }
+            /** @} */
+
+        private:
+            /**
+             * @brief A registered table
+             */
+            struct TableEntry {
+                std::string name;
+                BasicSnapshotTable<Encoding>* table{ nullptr };
+            };
+
+            /**
+             * @brief One part of one table to save
+             */
+            struct Task {
+                uint32_t table{ 0 };
+                size_t part{ 0 };
+            };
+
+            /**
+             * @brief Location and checksum of a saved part
+             */
+            struct Chunk {
+                uint32_t table{ 0 };
+                uint32_t file{ 0 };
+                uint64_t part{ 0 };
+                uint64_t offset{ 0 };  ///< Offset of the payload in its data file
+                uint64_t length{ 0 };
+                uint32_t crc{ 0 };
+            };
+
+            Options m_options;                  ///< Tuning parameters
+            std::vector<TableEntry> m_tables;   ///< Registered tables
+
+            [[nodiscard]] size_t findTable(const std::string& name) const noexcept {
+                for (size_t t = 0; t < m_tables.size(); ++t) {
+                    if (m_tables[t].name == name) {
+                        return t;
+                    }
+                }
+                return m_tables.size();
+            }
+
+            [[nodiscard]] static std::string dataPath(const std::string& path, uint64_t generation, size_t file) noexcept {
+                return path + "." + std::to_string(generation) + "." + std::to_string(file);
+            }
+
+            /**
+             * @brief Reads the generation and data file count of an existing manifest
+             * @return true if there is no valid manifest at path, false on success
+             */
+            [[nodiscard]] static bool readGeneration(const std::string& path, uint64_t& generation, uint32_t& files) noexcept {
+                MappedFile manifestFile;
+                if (manifestFile.open(path) || manifestFile.size() < 24) {
+                    return true; // Error (no manifest)
+                }
+                const std::span<const uint8_t> bytes = manifestFile.bytes();
+                uint32_t storedCrc = 0;
+                basicCopy<Encoding>(storedCrc, bytes.data() + bytes.size() - 4);
+                BasicReadBuffer<Encoding> header(bytes.data(), bytes.size() - 4);
+                uint32_t magic = 0;
+                uint32_t version = 0;
+                header.unsafePopFront(magic);
+                header.unsafePopFront(version);
+                header.unsafePopFront(generation);
+                header.unsafePopFront(files);
+                return magic != snapshot_magic || version != snapshot_version
+                    || crc32c(bytes.first(bytes.size() - 4)) != storedCrc;
+            }
+
+            /**
+             * @brief Removes the data files of a generation from index first on, until one is missing
+             */
+            static void removeDataFiles(const std::string& path, uint64_t generation, size_t first) noexcept {
+                for (size_t file = first; std::remove(dataPath(path, generation, file).c_str()) == 0; ++file) {
+                }
+            }
+
+            /**
+             * @brief Checks a chunk's frame against the manifest and its payload against the CRC
+             * @return true if the chunk is out of bounds or damaged
+             */
+            [[nodiscard]] static bool verifyChunk(const MappedFile& file, const Chunk& chunk) noexcept {
+                if (chunk.offset < chunk_header_size || chunk.offset > file.size() || chunk.length > file.size() - chunk.offset) {
+                    return true; // Error (chunk outside the data file)
+                }
+                BasicReadBuffer<Encoding> frame(file.data() + chunk.offset - chunk_header_size, chunk_header_size);
+                uint32_t magic = 0;
+                uint32_t table = 0;
+                uint64_t part = 0;
+                uint64_t length = 0;
+                uint32_t crc = 0;
+                frame.unsafePopFront(magic);
+                frame.unsafePopFront(table);
+                frame.unsafePopFront(part);
+                frame.unsafePopFront(length);
+                frame.unsafePopFront(crc);
+                if (magic != snapshot_chunk_magic || table != chunk.table || part != chunk.part || length != chunk.length || crc != chunk.crc) {
+                    return true; // Error (frame does not match the manifest)
+                }
+                return crc32c(std::span<const uint8_t>(file.data() + chunk.offset, static_cast<size_t>(chunk.length))) != chunk.crc;
+            }
+        };
+
+        /**
+         * @brief Snapshot table interface that uses the default stream endianness
+         */
+        using SnapshotTable = BasicSnapshotTable<stream_endian>;
+
+        /**
+         * @brief Snapshot engine that uses the default stream endianness
+         */
+        using SnapshotEngine = BasicSnapshotEngine<stream_endian>;
+
+    } // namespace endian
+} // namespace mz
+
+#endif // MZ_ENDIAN_SNAPSHOT_HEADER_FILE
@@ -0,0 +1,267 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_SPAN_CONVERT_HEADER_FILE
+#define MZ_ENDIAN_SPAN_CONVERT_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianSpanConvert.h
+ * @brief Endian-aware span copies that change the element type on the way
+ *
+ * This header provides basicCopyAs, which decodes a span of one integer wire
+ * type into a different native arithmetic type, or encodes the other way,
+ * swapping bytes and converting in a single pass. It backs the popFrontAs and
+ * pushBackAs members of the buffers and BasicVector.
+ *
+ * Conversions saturate: values outside the destination range clamp to its
+ * limits, floating-point values round to nearest (ties to even) and NaN
+ * becomes zero. Integer to floating-point conversions round as static_cast.
+ *
+ * The common 16-bit wire cases (to and from int32_t and float, and uint16_t to
+ * uint32_t) run eight elements per step with SSE2; encoding to uint16_t uses
+ * SSE4.1 when available. Everything else uses the scalar path.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <span>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define MZ_ENDIAN_SPAN_CONVERT_SSE2 1
+#endif
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#define MZ_ENDIAN_SPAN_CONVERT_SSE41 1
+#endif
+
+#include "EndianConversions.h"
+#include "EndianConcepts.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Integer types that can be stored on the wire by basicCopyAs
+         */
+        template <typename T>
+        concept WireIntType = std::integral<T> && !std::same_as<T, bool> && !std::is_const_v<T>;
+
+        /**
+         * @brief Native element types that basicCopyAs converts to and from
+         */
+        template <typename T>
+        concept NativeNumberType = (std::integral<std::remove_const_t<T>> && !std::same_as<std::remove_const_t<T>, bool>)
+            || std::floating_point<std::remove_const_t<T>>;
+
+        namespace detail {
+
+            /**
+             * @brief Converts a number, clamping it to the range of To
+             */
+            template <typename To, typename From>
+            [[nodiscard]] inline To saturateCast(From value) noexcept {
+                if constexpr (std::floating_point<To>) {
+                    return static_cast<To>(value);
+                }
+                else if constexpr (std::floating_point<From>) {
+                    if (value != value) {
+                        return To{ 0 };
+                    }
+                    // The limits of To are powers of two (or one less), which From rounds up to at most
+                    if (value <= static_cast<From>(std::numeric_limits<To>::min())) {
+                        return std::numeric_limits<To>::min();
+                    }
+                    if (value >= static_cast<From>(std::numeric_limits<To>::max())) {
+                        return std::numeric_limits<To>::max();
+                    }
+                    return static_cast<To>(std::nearbyint(value));
+                }
+                else {
+                    if (std::cmp_less(value, std::numeric_limits<To>::min())) {
+                        return std::numeric_limits<To>::min();
+                    }
+                    if (std::cmp_greater(value, std::numeric_limits<To>::max())) {
+                        return std::numeric_limits<To>::max();
+                    }
+                    return static_cast<To>(value);
+                }
+            }
+
+#if defined(MZ_ENDIAN_SPAN_CONVERT_SSE2)
+            [[nodiscard]] inline __m128i swap16Lanes(__m128i block) noexcept {
+                return _mm_or_si128(_mm_slli_epi16(block, 8), _mm_srli_epi16(block, 8));
+            }
+
+            /**
+             * @brief Narrows eight 32-bit lanes (two registers) to 16-bit wire values with saturation
+             */
+            template <typename Wire>
+            [[nodiscard]] inline __m128i pack32To16(__m128i low, __m128i high) noexcept {
+                if constexpr (std::is_signed_v<Wire>) {
+                    return _mm_packs_epi32(low, high);
+                }
+                else {
+#if defined(MZ_ENDIAN_SPAN_CONVERT_SSE41)
+                    return _mm_packus_epi32(low, high);
+#else
+                    return _mm_setzero_si128(); // Not reached: unsigned narrowing requires SSE4.1
+#endif
+                }
+            }
+
+            /**
+             * @brief Rounds four floats to int32 lanes with NaN as zero, after clamping to [low, high]
+             */
+            [[nodiscard]] inline __m128i roundClamped(__m128 values, float low, float high) noexcept {
+                values = _mm_and_ps(values, _mm_cmpord_ps(values, values));
+                values = _mm_max_ps(_mm_min_ps(values, _mm_set1_ps(high)), _mm_set1_ps(low));
+                return _mm_cvtps_epi32(values);
+            }
+#endif
+
+        } // namespace detail
+
+        /**
+         * @brief Decodes a span of wire integers into a span of another type
+         *
+         * @tparam Encoding Byte order of the wire values
+         * @tparam Wire Integer type of the wire values
+         * @tparam T Destination element type (integer or floating point)
+         * @tparam N Size of the span (can be dynamic_extent)
+         * @param destination Span of destination values
+         * @param source Source memory address; holds sizeof(Wire) * destination.size() bytes
+         */
+        template <std::endian Encoding, WireIntType Wire, NativeNumberType T, size_t N>
+            requires (!std::is_const_v<T>)
+        inline void basicCopyAs(std::span<T, N> destination, const void* source) noexcept {
+            const uint8_t* in = static_cast<const uint8_t*>(source);
+            const size_t count = destination.size();
+            size_t i = 0;
+#if defined(MZ_ENDIAN_SPAN_CONVERT_SSE2)
+            constexpr bool toInt32 = std::same_as<T, int32_t>;
+            constexpr bool toFloat = std::same_as<T, float> && sizeof(float) == 4;
+            constexpr bool toUint32 = std::same_as<T, uint32_t> && std::same_as<Wire, uint16_t>;
+            if constexpr (sizeof(Wire) == 2 && (toInt32 || toFloat || toUint32)) {
+                for (; i + 8 <= count; i += 8) {
+                    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+                    if constexpr (Encoding != std::endian::native) {
+                        block = detail::swap16Lanes(block);
+                    }
+                    __m128i low;
+                    __m128i high;
+                    if constexpr (std::is_signed_v<Wire>) {
+                        low = _mm_srai_epi32(_mm_unpacklo_epi16(block, block), 16);
+                        high = _mm_srai_epi32(_mm_unpackhi_epi16(block, block), 16);
+                    }
+                    else {
+                        low = _mm_unpacklo_epi16(block, _mm_setzero_si128());
+                        high = _mm_unpackhi_epi16(block, _mm_setzero_si128());
+                    }
+                    if constexpr (toFloat) {
+                        _mm_storeu_ps(reinterpret_cast<float*>(destination.data() + i), _mm_cvtepi32_ps(low));
+                        _mm_storeu_ps(reinterpret_cast<float*>(destination.data() + i + 4), _mm_cvtepi32_ps(high));
+                    }
+                    else {
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination.data() + i), low);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination.data() + i + 4), high);
+                    }
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                Wire value;
+                basicCopy<Encoding>(value, in + i * sizeof(Wire));
+                destination[i] = detail::saturateCast<T>(value);
+            }
+        }
+
+        /**
+         * @brief Encodes a span of values as wire integers of another type, with saturation
+         *
+         * @tparam Encoding Byte order of the wire values
+         * @tparam Wire Integer type of the wire values
+         * @tparam T Source element type (integer or floating point)
+         * @tparam N Size of the span (can be dynamic_extent)
+         * @param destination Destination memory address; receives sizeof(Wire) * source.size() bytes
+         * @param source Span of source values
+         */
+        template <std::endian Encoding, WireIntType Wire, NativeNumberType T, size_t N>
+        inline void basicCopyAs(void* destination, const std::span<T, N>& source) noexcept {
+            using Value = std::remove_const_t<T>;
+            uint8_t* out = static_cast<uint8_t*>(destination);
+            const size_t count = source.size();
+            size_t i = 0;
+#if defined(MZ_ENDIAN_SPAN_CONVERT_SSE2)
+            constexpr bool fromInt32 = std::same_as<Value, int32_t>;
+            constexpr bool fromFloat = std::same_as<Value, float> && sizeof(float) == 4;
+#if defined(MZ_ENDIAN_SPAN_CONVERT_SSE41)
+            constexpr bool packable = true;
+#else
+            constexpr bool packable = std::is_signed_v<Wire>;
+#endif
+            if constexpr (sizeof(Wire) == 2 && packable && (fromInt32 || fromFloat)) {
+                constexpr float low = static_cast<float>(std::numeric_limits<Wire>::min());
+                constexpr float high = static_cast<float>(std::numeric_limits<Wire>::max());
+                for (; i + 8 <= count; i += 8) {
+                    __m128i first;
+                    __m128i second;
+                    if constexpr (fromFloat) {
+                        first = detail::roundClamped(_mm_loadu_ps(reinterpret_cast<const float*>(source.data() + i)), low, high);
+                        second = detail::roundClamped(_mm_loadu_ps(reinterpret_cast<const float*>(source.data() + i + 4)), low, high);
+                    }
+                    else {
+                        first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+                        second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i + 4));
+                    }
+                    __m128i block = detail::pack32To16<Wire>(first, second);
+                    if constexpr (Encoding != std::endian::native) {
+                        block = detail::swap16Lanes(block);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), block);
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                basicCopy<Encoding>(out + i * sizeof(Wire), detail::saturateCast<Wire>(static_cast<Value>(source[i])));
+            }
+        }
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_SPAN_CONVERT_SSE2
+#undef MZ_ENDIAN_SPAN_CONVERT_SSE41
+
+#endif // MZ_ENDIAN_SPAN_CONVERT_HEADER_FILE
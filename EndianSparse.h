@@ -0,0 +1,488 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_SPARSE_HEADER_FILE
+#define MZ_ENDIAN_SPARSE_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianSparse.h
+ * @brief Sparse encoding of mostly-zero numeric arrays
+ *
+ * This header defines pushBackSparse(), which appends an array to a
+ * BasicVector in whichever of three layouts is smallest, and BasicSparseView,
+ * which reads one back as a sequence of non-zero entries or scatters it into
+ * a dense span.
+ *
+ * The encoder first builds a bitmap of the non-zero elements, comparing a
+ * 16-byte register at a time with SSE2, so long zero runs cost one compare
+ * per register. From the count of set bits it picks:
+ *   - indexed: the index of every non-zero element, then their values
+ *   - bitmap:  the bitmap itself, then the non-zero values
+ *   - dense:   every value, when neither of the above is smaller
+ *
+ * An element is zero when all its bytes are zero, so -0.0 is kept as a
+ * non-zero value and every array round-trips bit for bit.
+ *
+ * Layout (integers and values in Encoding; floats as their bits):
+ *   [uint8_t layout][uint8_t element size][uint16_t 0][uint32_t length][uint32_t non-zero count]
+ *   indexed: count x [uint32_t index], count x [value]
+ *   bitmap:  packedBoolSize(length) bytes (element i in bit i % 8 of byte i / 8), count x [value]
+ *   dense:   length x [value]
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <concepts>
+#include <limits>
+#include <vector>
+#include <span>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define MZ_ENDIAN_SPARSE_SSE2 1
+#endif
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+#include "EndianBoolPack.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Layout chosen for a sparse array
+         */
+        enum class SparseLayout : uint8_t {
+            none,          ///< No layout
+            indexed = 1,   ///< Indices of the non-zero elements, then their values
+            bitmap = 2,    ///< Bitmap of the non-zero elements, then their values
+            dense = 3,     ///< All values
+            invalid        ///< Invalid layout
+        };
+
+        /**
+         * @brief Element types that can be sparse-encoded
+         */
+        template <typename T>
+        concept SparseElement = (std::integral<T> && !std::same_as<T, bool>)
+            || (std::floating_point<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+
+        /// Size of the header written before every sparse array
+        static constexpr size_t sparse_header_size{ 12 };
+
+        namespace detail {
+
+            /**
+             * @brief Unsigned integer with the size of T, used to store its bits
+             */
+            template <typename T>
+            using SparseBits = std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t,
+                std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+            /**
+             * @brief Builds a mask of the non-zero elements among up to 64
+             * @param values First element
+             * @param count Number of elements (at most 64)
+             * @return Bit i set if element i is non-zero
+             */
+            template <SparseElement T>
+            [[nodiscard]] inline uint64_t sparseNonZeroMask(const T* values, size_t count) noexcept {
+                uint64_t mask = 0;
+                size_t i = 0;
+#if defined(MZ_ENDIAN_SPARSE_SSE2)
+                constexpr size_t lanes = 16 / sizeof(T);
+                const __m128i zero = _mm_setzero_si128();
+                for (; i + lanes <= count; i += lanes) {
+                    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+                    uint64_t zeros;
+                    if constexpr (sizeof(T) == 1) {
+                        zeros = static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+                    }
+                    else if constexpr (sizeof(T) == 2) {
+                        const __m128i equal = _mm_cmpeq_epi16(block, zero);
+                        zeros = static_cast<uint64_t>(_mm_movemask_epi8(_mm_packs_epi16(equal, zero)) & 0xFF);
+                    }
+                    else if constexpr (sizeof(T) == 4) {
+                        zeros = static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, zero))));
+                    }
+                    else {
+                        // A 64-bit lane is zero when both of its 32-bit halves are
+                        const __m128i equal = _mm_cmpeq_epi32(block, zero);
+                        const __m128i both = _mm_and_si128(equal, _mm_shuffle_epi32(equal, 0xB1));
+                        zeros = static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(both)));
+                    }
+                    mask |= (~zeros & ((uint64_t{ 1 } << lanes) - 1)) << i;
+                }
+#endif
+                for (; i < count; ++i) {
+                    SparseBits<T> bits;
+                    std::memcpy(&bits, values + i, sizeof(T));
+                    mask |= static_cast<uint64_t>(bits != 0) << i;
+                }
+                return mask;
+            }
+
+            template <std::endian Encoding, SparseElement T>
+            inline void storeSparseValue(uint8_t* destination, T value) noexcept {
+                basicCopy<Encoding>(destination, std::bit_cast<SparseBits<T>>(value));
+            }
+
+            template <std::endian Encoding, SparseElement T>
+            [[nodiscard]] inline T loadSparseValue(const uint8_t* source) noexcept {
+                SparseBits<T> bits;
+                basicCopy<Encoding>(bits, source);
+                return std::bit_cast<T>(bits);
+            }
+
+        } // namespace detail
+
+        /**
+         * @brief Appends an array in its smallest sparse layout
+         * @tparam Encoding Endianness of the vector
+         * @tparam T Element type
+         * @param vector Destination vector
+         * @param values Dense array
+         * @return true if the array has more than 2^32 - 1 elements, false on success
+         */
+        template <std::endian Encoding, SparseElement T>
+        [[nodiscard]] bool pushBackSparse(BasicVector<Encoding>& vector, std::span<const T> values) noexcept {
+            const size_t length = values.size();
+            if (length > std::numeric_limits<uint32_t>::max()) {
+                return true; // Error (too long)
+            }
+            std::vector<uint64_t> masks((length + 63) / 64);
+            size_t nonZeros = 0;
+            for (size_t word = 0; word < masks.size(); ++word) {
+                const size_t begin = word * 64;
+                masks[word] = detail::sparseNonZeroMask(values.data() + begin, std::min<size_t>(64, length - begin));
+                nonZeros += static_cast<size_t>(std::popcount(masks[word]));
+            }
+
+            const size_t indexedSize = nonZeros * (4 + sizeof(T));
+            const size_t bitmapSize = packedBoolSize(length) + nonZeros * sizeof(T);
+            const size_t denseSize = length * sizeof(T);
+            const SparseLayout layout = indexedSize <= bitmapSize && indexedSize < denseSize ? SparseLayout::indexed
+                : bitmapSize < denseSize ? SparseLayout::bitmap : SparseLayout::dense;
+
+            vector.pushBack(static_cast<uint8_t>(layout));
+            vector.pushBack(static_cast<uint8_t>(sizeof(T)));
+            vector.pushBack(uint16_t{ 0 });
+            vector.pushBack(static_cast<uint32_t>(length));
+            vector.pushBack(static_cast<uint32_t>(nonZeros));
+            if (layout == SparseLayout::dense) {
+                const size_t offset = vector.size();
+                vector.expandBy(denseSize);
+                if (length != 0) {
+                    basicCopy<Encoding>(vector.data() + offset,
+                        std::span<const detail::SparseBits<T>>(reinterpret_cast<const detail::SparseBits<T>*>(values.data()), length));
+                }
+                return false; // Success (no error)
+            }
+
+            const size_t offset = vector.size();
+            vector.expandBy(layout == SparseLayout::indexed ? indexedSize : bitmapSize);
+            uint8_t* out = vector.data() + offset;
+            uint8_t* valuesOut = out;
+            if (layout == SparseLayout::indexed) {
+                uint8_t* indexOut = out;
+                valuesOut = out + nonZeros * 4;
+                for (size_t word = 0; word < masks.size(); ++word) {
+                    for (uint64_t bits = masks[word]; bits != 0; bits &= bits - 1) {
+                        basicCopy<Encoding>(indexOut, static_cast<uint32_t>(word * 64 + static_cast<size_t>(std::countr_zero(bits))));
+                        indexOut += 4;
+                    }
+                }
+            }
+            else {
+                const size_t bitmapBytes = packedBoolSize(length);
+                for (size_t byte = 0; byte < bitmapBytes; ++byte) {
+                    out[byte] = static_cast<uint8_t>(masks[byte / 8] >> (8 * (byte % 8)));
+                }
+                valuesOut = out + bitmapBytes;
+            }
+            for (size_t word = 0; word < masks.size(); ++word) {
+                for (uint64_t bits = masks[word]; bits != 0; bits &= bits - 1) {
+                    detail::storeSparseValue<Encoding>(valuesOut, values[word * 64 + static_cast<size_t>(std::countr_zero(bits))]);
+                    valuesOut += sizeof(T);
+                }
+            }
+            return false; // Success (no error)
+        }
+
+        /**
+         * @class BasicSparseView
+         * @brief Read-only view of a sparse array inside a buffer
+         *
+         * The view points into the buffer it was opened from, which must
+         * outlive it.
+         *
+         * @tparam Encoding Endianness of the data
+         * @tparam T Element type; must match the encoded element size
+         */
+        template <std::endian Encoding, SparseElement T>
+        class BasicSparseView {
+        public:
+            /**
+             * @name Constructors
+             * @{
+             */
+
+             /**
+              * @brief Constructs an empty view
+              */
+            explicit BasicSparseView() noexcept = default;
+            /** @} */
+
+            /**
+             * @name Opening
+             * @{
+             */
+
+             /**
+              * @brief Opens the sparse array at the front of a buffer and consumes it
+              * @param buffer Buffer positioned where pushBackSparse() started writing
+              * @return true if the header is invalid, the element size differs from T,
+              *         the buffer is too short or the indices or bitmap are inconsistent,
+              *         false on success
+              */
+            [[nodiscard]] bool open(BasicReadBuffer<Encoding>& buffer) noexcept {
+                *this = BasicSparseView{};
+                if (buffer.size() < sparse_header_size) {
+                    return true; // Error (truncated header)
+                }
+                BasicReadBuffer<Encoding> header(buffer.data(), sparse_header_size);
+                uint8_t layout = 0;
+                uint8_t elementSize = 0;
+                uint16_t reserved = 0;
+                uint32_t length = 0;
+                uint32_t nonZeros = 0;
+                header.unsafePopFront(layout);
+                header.unsafePopFront(elementSize);
+                header.unsafePopFront(reserved);
+                header.unsafePopFront(length);
+                header.unsafePopFront(nonZeros);
+                if (elementSize != sizeof(T) || nonZeros > length) {
+                    return true; // Error (wrong element type or bad count)
+                }
+                const uint8_t* body = buffer.data() + sparse_header_size;
+                const size_t available = buffer.size() - sparse_header_size;
+                size_t bodySize = 0;
+                switch (static_cast<SparseLayout>(layout)) {
+                case SparseLayout::indexed:
+                    bodySize = size_t{ nonZeros } * (4 + sizeof(T));
+                    if (bodySize > available || checkIndices(body, nonZeros, length)) {
+                        return true; // Error (truncated or unsorted indices)
+                    }
+                    m_values = body + size_t{ nonZeros } * 4;
+                    break;
+                case SparseLayout::bitmap:
+                    bodySize = packedBoolSize(length) + size_t{ nonZeros } * sizeof(T);
+                    if (bodySize > available || checkBitmap(body, length, nonZeros)) {
+                        return true; // Error (truncated, padding bits set or bitmap does not match the count)
+                    }
+                    m_values = body + packedBoolSize(length);
+                    break;
+                case SparseLayout::dense:
+                    bodySize = size_t{ length } * sizeof(T);
+                    if (bodySize > available) {
+                        return true; // Error (truncated values)
+                    }
+                    m_values = body;
+                    break;
+                default:
+                    return true; // Error (unknown layout)
+                }
+                m_layout = static_cast<SparseLayout>(layout);
+                m_body = body;
+                m_length = length;
+                m_nonZeros = nonZeros;
+                buffer.skipFront(sparse_header_size + bodySize);
+                return false; // Success (no error)
+            }
+            /** @} */
+
+            /**
+             * @name Accessors
+             * @{
+             */
+
+             /**
+              * @brief Gets the layout the encoder chose
+              * @return Layout, or SparseLayout::none if nothing is open
+              */
+            [[nodiscard]] SparseLayout layout() const noexcept { return m_layout; }
+
+            /**
+             * @brief Gets the dense length of the array
+             * @return Number of elements, zeros included
+             */
+            [[nodiscard]] size_t size() const noexcept { return m_length; }
+
+            /**
+             * @brief Gets the number of non-zero elements
+             * @return Non-zero count
+             */
+            [[nodiscard]] size_t nonZeroCount() const noexcept { return m_nonZeros; }
+            /** @} */
+
+            /**
+             * @name Decoding
+             * @{
+             */
+
+             /**
+              * @brief Visits the non-zero elements in index order
+              * @tparam Visitor Callable as bool(size_t index, T value); return false to stop
+              * @param visitor Callback
+              *
+              * For the dense layout, zero elements are skipped as well.
+              */
+            template <typename Visitor>
+            void forEach(Visitor&& visitor) const noexcept {
+                if (m_layout == SparseLayout::indexed) {
+                    for (size_t i = 0; i < m_nonZeros; ++i) {
+                        uint32_t index = 0;
+                        basicCopy<Encoding>(index, m_body + i * 4);
+                        if (!visitor(static_cast<size_t>(index), detail::loadSparseValue<Encoding, T>(m_values + i * sizeof(T)))) {
+                            return;
+                        }
+                    }
+                }
+                else if (m_layout == SparseLayout::bitmap) {
+                    const uint8_t* value = m_values;
+                    for (size_t byte = 0; byte < packedBoolSize(m_length); ++byte) {
+                        for (unsigned bits = m_body[byte]; bits != 0; bits &= bits - 1) {
+                            const size_t index = byte * 8 + static_cast<size_t>(std::countr_zero(bits));
+                            if (!visitor(index, detail::loadSparseValue<Encoding, T>(value))) {
+                                return;
+                            }
+                            value += sizeof(T);
+                        }
+                    }
+                }
+                else if (m_layout == SparseLayout::dense) {
+                    for (size_t i = 0; i < m_length; ++i) {
+                        const T value = detail::loadSparseValue<Encoding, T>(m_values + i * sizeof(T));
+                        if (std::bit_cast<detail::SparseBits<T>>(value) != 0 && !visitor(i, value)) {
+                            return;
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Scatters the array into a dense span
+             * @param values Destination of exactly size() elements
+             * @return true if the size does not match, false on success
+             */
+            [[nodiscard]] bool toDense(std::span<T> values) const noexcept {
+                if (values.size() != m_length) {
+                    return true; // Error (size mismatch)
+                }
+                if (m_layout == SparseLayout::dense) {
+                    if (m_length != 0) {
+                        basicCopy<Encoding>(std::span<detail::SparseBits<T>>(reinterpret_cast<detail::SparseBits<T>*>(values.data()), m_length), m_values);
+                    }
+                    return false; // Success (no error)
+                }
+                if (m_length != 0) {
+                    std::memset(values.data(), 0, m_length * sizeof(T));
+                }
+                forEach([&values](size_t index, T value) {
+                    values[index] = value;
+                    return true;
+                });
+                return false; // Success (no error)
+            }
+            /** @} */
+
+        private:
+            const uint8_t* m_body{ nullptr };          ///< Indices or bitmap
+            const uint8_t* m_values{ nullptr };        ///< Stored values
+            size_t m_length{ 0 };                      ///< Dense length
+            size_t m_nonZeros{ 0 };                    ///< Non-zero count
+            SparseLayout m_layout{ SparseLayout::none };
+
+            [[nodiscard]] static bool checkIndices(const uint8_t* indices, size_t count, size_t length) noexcept {
+                uint64_t previous = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    uint32_t index = 0;
+                    basicCopy<Encoding>(index, indices + i * 4);
+                    if (index >= length || (i != 0 && index <= previous)) {
+                        return true; // Error (out of range or not increasing)
+                    }
+                    previous = index;
+                }
+                return false; // Success (no error)
+            }
+
+            [[nodiscard]] static bool checkBitmap(const uint8_t* bitmap, size_t length, size_t nonZeros) noexcept {
+                const size_t bytes = packedBoolSize(length);
+                if (length % 8 != 0 && (bitmap[bytes - 1] >> (length % 8)) != 0) {
+                    return true; // Error (padding bits set)
+                }
+                size_t count = 0;
+                for (size_t byte = 0; byte < bytes; ++byte) {
+                    count += static_cast<size_t>(std::popcount(static_cast<unsigned>(bitmap[byte])));
+                }
+                return count != nonZeros;
+            }
+        };
+
+        /**
+         * @brief Decodes a sparse array from the front of a buffer into a dense span
+         * @tparam Encoding Endianness of the data
+         * @tparam T Element type
+         * @param buffer Source buffer; the array is consumed on success
+         * @param values Destination of exactly the encoded length
+         * @return true if the array is invalid or its length differs from values.size(), false on success
+         */
+        template <std::endian Encoding, SparseElement T>
+        [[nodiscard]] bool popFrontSparse(BasicReadBuffer<Encoding>& buffer, std::span<T> values) noexcept {
+            BasicReadBuffer<Encoding> probe(buffer.data(), buffer.size());
+            BasicSparseView<Encoding, T> view;
+            if (view.open(probe) || view.toDense(values)) {
+                return true; // Error (invalid array or size mismatch)
+            }
+            buffer = probe;
+            return false; // Success (no error)
+        }
+
+        /**
+         * @brief Sparse view that uses the default stream endianness
+         */
+        template <SparseElement T>
+        using SparseView = BasicSparseView<stream_endian, T>;
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_SPARSE_SSE2
+
+#endif // MZ_ENDIAN_SPARSE_HEADER_FILE
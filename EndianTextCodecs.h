@@ -0,0 +1,602 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_ENDIAN_TEXT_CODECS_HEADER_FILE
+#define MZ_ENDIAN_TEXT_CODECS_HEADER_FILE
+#pragma once
+
+/**
+ * @file EndianTextCodecs.h
+ * @brief Base64 and hex codecs for embedding buffer contents in text channels
+ *
+ * This header provides base64 (standard and URL-safe alphabets, RFC 4648) and
+ * lowercase hex encoders and decoders that read directly from a BasicReadBuffer
+ * range and write into a BasicVector or a pre-sized BasicWriteBuffer. Output
+ * sizes are computed exactly up front, so each call performs a single pass
+ * with no intermediate allocation.
+ *
+ * When SSSE3 is available the codecs process 12/16 input bytes per step with
+ * byte shuffles (the Mula/Lemire formulation); otherwise table-driven scalar
+ * loops are used. Both paths produce identical output.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <span>
+#include <bit>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define MZ_ENDIAN_TEXT_CODECS_SSSE3 1
+#endif
+
+#include "EndianBasicBuffers.h"
+#include "EndianBasicVector.h"
+
+namespace mz {
+    namespace endian {
+
+        /**
+         * @brief Selects the base64 alphabet
+         *
+         * The standard alphabet uses '+' and '/' and is always padded with '='.
+         * The URL-safe alphabet uses '-' and '_' and is written without padding;
+         * its decoder accepts input with or without padding.
+         */
+        enum class Base64Alphabet : uint8_t {
+            standard = 0, ///< RFC 4648 section 4
+            urlSafe = 1   ///< RFC 4648 section 5
+        };
+
+        namespace detail {
+
+            /**
+             * @brief Encode and decode tables for one base64 alphabet
+             */
+            struct Base64Tables {
+                std::array<uint8_t, 64> encode{};  ///< Six-bit value to character
+                std::array<uint8_t, 256> decode{}; ///< Character to six-bit value, 0xFF if invalid
+            };
+
+            /**
+             * @brief Builds the tables for an alphabet at compile time
+             */
+            template <Base64Alphabet Alphabet>
+            [[nodiscard]] constexpr Base64Tables makeBase64Tables() noexcept {
+                Base64Tables tables{};
+                const char* symbols = (Alphabet == Base64Alphabet::standard)
+                    ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+                    : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+                for (auto& entry : tables.decode) {
+                    entry = 0xFF;
+                }
+                for (size_t i = 0; i < 64; ++i) {
+                    tables.encode[i] = static_cast<uint8_t>(symbols[i]);
+                    tables.decode[static_cast<uint8_t>(symbols[i])] = static_cast<uint8_t>(i);
+                }
+                return tables;
+            }
+
+            template <Base64Alphabet Alphabet>
+            inline constexpr Base64Tables base64_tables = makeBase64Tables<Alphabet>();
+
+            /// Lowercase hex digits
+            inline constexpr char hex_digits[] = "0123456789abcdef";
+
+            /**
+             * @brief Builds the hex decode table (both cases accepted, 0xFF if invalid)
+             */
+            [[nodiscard]] constexpr std::array<uint8_t, 256> makeHexTable() noexcept {
+                std::array<uint8_t, 256> table{};
+                for (auto& entry : table) {
+                    entry = 0xFF;
+                }
+                for (uint8_t i = 0; i < 10; ++i) {
+                    table['0' + i] = i;
+                }
+                for (uint8_t i = 0; i < 6; ++i) {
+                    table['a' + i] = static_cast<uint8_t>(10 + i);
+                    table['A' + i] = static_cast<uint8_t>(10 + i);
+                }
+                return table;
+            }
+
+            inline constexpr std::array<uint8_t, 256> hex_table = makeHexTable();
+
+            /**
+             * @brief Encodes bytes as base64 text
+             * @param source Bytes to encode
+             * @param size Number of bytes
+             * @param text Destination, at least base64EncodedSize(size) bytes
+             */
+            template <Base64Alphabet Alphabet>
+            inline void encodeBase64Raw(const uint8_t* source, size_t size, uint8_t* text) noexcept {
+                const auto& table = base64_tables<Alphabet>.encode;
+                size_t i = 0;
+
+#if defined(MZ_ENDIAN_TEXT_CODECS_SSSE3)
+                // 12 input bytes -> 16 characters; reads 16 bytes so stop 4 early
+                const __m128i shiftTable = (Alphabet == Base64Alphabet::standard)
+                    ? _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0)
+                    : _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+                while (i + 16 <= size) {
+                    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+                    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+                    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+                    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+                    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+                    const __m128i indices = _mm_or_si128(t1, t3);
+
+                    __m128i offsets = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+                    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+                    offsets = _mm_or_si128(offsets, _mm_and_si128(less, _mm_set1_epi8(13)));
+                    const __m128i out = _mm_add_epi8(_mm_shuffle_epi8(shiftTable, offsets), indices);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(text), out);
+
+                    i += 12;
+                    text += 16;
+                }
+#endif
+
+                for (; i + 3 <= size; i += 3) {
+                    const uint32_t group = (uint32_t{ source[i] } << 16) | (uint32_t{ source[i + 1] } << 8) | source[i + 2];
+                    text[0] = table[(group >> 18) & 0x3F];
+                    text[1] = table[(group >> 12) & 0x3F];
+                    text[2] = table[(group >> 6) & 0x3F];
+                    text[3] = table[group & 0x3F];
+                    text += 4;
+                }
+
+                const size_t tail = size - i;
+                if (tail > 0) {
+                    const uint32_t group = (uint32_t{ source[i] } << 16) | (tail == 2 ? uint32_t{ source[i + 1] } << 8 : 0);
+                    *text++ = table[(group >> 18) & 0x3F];
+                    *text++ = table[(group >> 12) & 0x3F];
+                    if (tail == 2) {
+                        *text++ = table[(group >> 6) & 0x3F];
+                    }
+                    if constexpr (Alphabet == Base64Alphabet::standard) {
+                        *text++ = '=';
+                        if (tail == 1) {
+                            *text++ = '=';
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Decodes base64 text without padding
+             * @param text Characters to decode (padding already stripped)
+             * @param size Number of characters (size % 4 != 1)
+             * @param bytes Destination, at least (size * 3) / 4 bytes
+             * @return true if an invalid character was found, false on success
+             */
+            template <Base64Alphabet Alphabet>
+            [[nodiscard]] inline bool decodeBase64Raw(const uint8_t* text, size_t size, uint8_t* bytes) noexcept {
+                const auto& table = base64_tables<Alphabet>.decode;
+                size_t i = 0;
+
+#if defined(MZ_ENDIAN_TEXT_CODECS_SSSE3)
+                // 16 characters -> 12 bytes; each store writes 16 bytes, so keep at least
+                // 8 characters (6 output bytes) behind every block to stay inside the output
+                const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                    0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+                const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+                const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+                const __m128i mask2F = _mm_set1_epi8(0x2F);
+                while (i + 24 <= size) {
+                    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+                    if constexpr (Alphabet == Base64Alphabet::urlSafe) {
+                        // Reject '+' and '/', then map '-' -> '+' and '_' -> '/'
+                        const __m128i foreign = _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('+')),
+                            _mm_cmpeq_epi8(in, _mm_set1_epi8('/')));
+                        if (_mm_movemask_epi8(foreign)) {
+                            return true; // Error (invalid character)
+                        }
+                        const __m128i dash = _mm_cmpeq_epi8(in, _mm_set1_epi8('-'));
+                        const __m128i underscore = _mm_cmpeq_epi8(in, _mm_set1_epi8('_'));
+                        in = _mm_sub_epi8(in, _mm_and_si128(dash, _mm_set1_epi8('-' - '+')));
+                        in = _mm_sub_epi8(in, _mm_and_si128(underscore, _mm_set1_epi8('_' - '/')));
+                    }
+                    const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask2F);
+                    const __m128i loNibbles = _mm_and_si128(in, mask2F);
+                    const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+                    const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF) {
+                        return true; // Error (invalid character)
+                    }
+                    const __m128i eq2F = _mm_cmpeq_epi8(in, mask2F);
+                    const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+                    const __m128i values = _mm_add_epi8(in, roll);
+
+                    const __m128i mergedPairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+                    __m128i out = _mm_madd_epi16(mergedPairs, _mm_set1_epi32(0x00011000));
+                    out = _mm_shuffle_epi8(out, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), out);
+
+                    i += 16;
+                    bytes += 12;
+                }
+#endif
+
+                uint32_t invalid = 0;
+                for (; i + 4 <= size; i += 4) {
+                    const uint32_t a = table[text[i]];
+                    const uint32_t b = table[text[i + 1]];
+                    const uint32_t c = table[text[i + 2]];
+                    const uint32_t d = table[text[i + 3]];
+                    invalid |= a | b | c | d;
+                    const uint32_t group = (a << 18) | (b << 12) | (c << 6) | d;
+                    bytes[0] = static_cast<uint8_t>(group >> 16);
+                    bytes[1] = static_cast<uint8_t>(group >> 8);
+                    bytes[2] = static_cast<uint8_t>(group);
+                    bytes += 3;
+                }
+
+                const size_t tail = size - i;
+                if (tail >= 2) {
+                    const uint32_t a = table[text[i]];
+                    const uint32_t b = table[text[i + 1]];
+                    const uint32_t c = (tail == 3) ? table[text[i + 2]] : 0;
+                    invalid |= a | b | c;
+                    const uint32_t group = (a << 18) | (b << 12) | (c << 6);
+                    *bytes++ = static_cast<uint8_t>(group >> 16);
+                    if (tail == 3) {
+                        *bytes++ = static_cast<uint8_t>(group >> 8);
+                    }
+                }
+
+                return (invalid & 0x80) != 0 || tail == 1;
+            }
+
+            /**
+             * @brief Encodes bytes as lowercase hex text
+             * @param source Bytes to encode
+             * @param size Number of bytes
+             * @param text Destination, at least size * 2 bytes
+             */
+            inline void encodeHexRaw(const uint8_t* source, size_t size, uint8_t* text) noexcept {
+                size_t i = 0;
+
+#if defined(MZ_ENDIAN_TEXT_CODECS_SSSE3)
+                const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex_digits));
+                const __m128i lowMask = _mm_set1_epi8(0x0F);
+                while (i + 16 <= size) {
+                    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                    const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), lowMask));
+                    const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(in, lowMask));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(text), _mm_unpacklo_epi8(hi, lo));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(text + 16), _mm_unpackhi_epi8(hi, lo));
+                    i += 16;
+                    text += 32;
+                }
+#endif
+
+                for (; i < size; ++i) {
+                    *text++ = static_cast<uint8_t>(hex_digits[source[i] >> 4]);
+                    *text++ = static_cast<uint8_t>(hex_digits[source[i] & 0x0F]);
+                }
+            }
+
+            /**
+             * @brief Decodes hex text (either case)
+             * @param text Characters to decode
+             * @param size Number of bytes to produce (text holds size * 2 characters)
+             * @param bytes Destination, at least size bytes
+             * @return true if an invalid character was found, false on success
+             */
+            [[nodiscard]] inline bool decodeHexRaw(const uint8_t* text, size_t size, uint8_t* bytes) noexcept {
+                size_t i = 0;
+
+#if defined(MZ_ENDIAN_TEXT_CODECS_SSSE3)
+                while (i + 8 <= size) {
+                    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i * 2));
+                    // Digits: c - '0' in [0, 9]; letters: (c | 0x20) - 'a' in [0, 5]
+                    const __m128i digit = _mm_sub_epi8(in, _mm_set1_epi8('0'));
+                    const __m128i letter = _mm_sub_epi8(_mm_or_si128(in, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+                    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+                    const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+                    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+                        return true; // Error (invalid character)
+                    }
+                    const __m128i values = _mm_or_si128(_mm_and_si128(isDigit, digit),
+                        _mm_andnot_si128(isDigit, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+                    const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0110));
+                    const __m128i packed = _mm_packus_epi16(pairs, pairs);
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(bytes + i), packed);
+                    i += 8;
+                }
+#endif
+
+                uint32_t invalid = 0;
+                for (; i < size; ++i) {
+                    const uint32_t hi = hex_table[text[i * 2]];
+                    const uint32_t lo = hex_table[text[i * 2 + 1]];
+                    invalid |= hi | lo;
+                    bytes[i] = static_cast<uint8_t>((hi << 4) | lo);
+                }
+                return (invalid & 0x80) != 0;
+            }
+
+            /**
+             * @brief Number of '=' characters at the end of padded base64 text
+             */
+            [[nodiscard]] inline size_t base64Padding(const uint8_t* text, size_t size) noexcept {
+                if (size == 0 || size % 4 != 0) {
+                    return 0;
+                }
+                return (text[size - 1] == '=') ? ((text[size - 2] == '=') ? 2 : 1) : 0;
+            }
+
+        } // namespace detail
+
+        /**
+         * @name Size Calculation
+         * @{
+         */
+
+         /**
+          * @brief Calculates the exact length of the base64 text for a byte count
+          * @tparam Alphabet Base64 alphabet (determines padding)
+          * @param size Number of input bytes
+          * @return Number of characters produced by the encoder
+          */
+        template <Base64Alphabet Alphabet = Base64Alphabet::standard>
+        [[nodiscard]] constexpr size_t base64EncodedSize(size_t size) noexcept {
+            if constexpr (Alphabet == Base64Alphabet::standard) {
+                return ((size + 2) / 3) * 4;
+            }
+            else {
+                return (size / 3) * 4 + ((size % 3) ? (size % 3) + 1 : 0);
+            }
+        }
+
+        /**
+         * @brief Calculates the exact number of bytes decoded from base64 text
+         * @param text Base64 text, with or without padding
+         * @param size Receives the decoded size
+         * @return true if the text length is not a valid base64 length, false on success
+         */
+        [[nodiscard]] inline bool base64DecodedSize(std::span<const uint8_t> text, size_t& size) noexcept {
+            const size_t length = text.size() - detail::base64Padding(text.data(), text.size());
+            if (length % 4 == 1) {
+                size = 0;
+                return true; // Error (impossible length)
+            }
+            size = (length / 4) * 3 + ((length % 4) ? (length % 4) - 1 : 0);
+            return false; // Success (no error)
+        }
+
+        /**
+         * @brief Calculates the exact length of the hex text for a byte count
+         * @param size Number of input bytes
+         * @return Number of characters produced by the encoder
+         */
+        [[nodiscard]] constexpr size_t hexEncodedSize(size_t size) noexcept {
+            return size * 2;
+        }
+
+        /**
+         * @brief Calculates the exact number of bytes decoded from hex text
+         * @param text Hex text
+         * @param size Receives the decoded size
+         * @return true if the text has an odd length, false on success
+         */
+        [[nodiscard]] inline bool hexDecodedSize(std::span<const uint8_t> text, size_t& size) noexcept {
+            size = text.size() / 2;
+            return (text.size() & 1) != 0;
+        }
+        /** @} */
+
+        /**
+         * @name Base64 Encoding and Decoding
+         * @{
+         */
+
+         /**
+          * @brief Appends the base64 encoding of a read buffer range to a vector
+          * @tparam Alphabet Base64 alphabet
+          * @tparam Encoding Endianness of the buffers (bytes are copied as-is)
+          * @param source Range of bytes to encode
+          * @param text Vector the characters are appended to
+          */
+        template <Base64Alphabet Alphabet = Base64Alphabet::standard, std::endian Encoding>
+        inline void encodeBase64(BasicReadBuffer<Encoding> source, BasicVector<Encoding>& text) noexcept {
+            const size_t oldSize = text.size();
+            const size_t length = base64EncodedSize<Alphabet>(source.size());
+            text.expandBy(length);
+            if (length > 0) {
+                detail::encodeBase64Raw<Alphabet>(source.data(), source.size(), text.data() + oldSize);
+            }
+        }
+
+        /**
+         * @brief Writes the base64 encoding of a read buffer range to a write buffer
+         * @tparam Alphabet Base64 alphabet
+         * @tparam Encoding Endianness of the buffers (bytes are copied as-is)
+         * @param source Range of bytes to encode
+         * @param text Write buffer the characters are written to
+         * @return true if the write buffer is too small, false on success
+         */
+        template <Base64Alphabet Alphabet = Base64Alphabet::standard, std::endian Encoding>
+        [[nodiscard]] inline bool encodeBase64(BasicReadBuffer<Encoding> source, BasicWriteBuffer<Encoding>& text) noexcept {
+            const size_t length = base64EncodedSize<Alphabet>(source.size());
+            if (length > text.size()) {
+                return true; // Error (buffer full)
+            }
+            if (length > 0) {
+                detail::encodeBase64Raw<Alphabet>(source.data(), source.size(), text.data());
+                text.skip(length);
+            }
+            return false; // Success (no error)
+        }
+
+        /**
+         * @brief Decodes base64 text from a read buffer range and appends the bytes to a vector
+         * @tparam Alphabet Base64 alphabet
+         * @tparam Encoding Endianness of the buffers (bytes are copied as-is)
+         * @param text Range of base64 characters
+         * @param bytes Vector the decoded bytes are appended to
+         * @return true if the text is not valid base64, false on success
+         *
+         * On failure the vector is restored to its original size.
+         */
+        template <Base64Alphabet Alphabet = Base64Alphabet::standard, std::endian Encoding>
+        [[nodiscard]] inline bool decodeBase64(BasicReadBuffer<Encoding> text, BasicVector<Encoding>& bytes) noexcept {
+            size_t length = 0;
+            if (base64DecodedSize(std::span<const uint8_t>(text.data(), text.size()), length)) {
+                return true; // Error (impossible length)
+            }
+            const size_t oldSize = bytes.size();
+            bytes.expandBy(length);
+            const size_t characters = text.size() - detail::base64Padding(text.data(), text.size());
+            if (detail::decodeBase64Raw<Alphabet>(text.data(), characters, bytes.data() + oldSize)) {
+                bytes.resize(oldSize);
+                return true; // Error (invalid character)
+            }
+            return false; // Success (no error)
+        }
+
+        /**
+         * @brief Decodes base64 text from a read buffer range into a write buffer
+         * @tparam Alphabet Base64 alphabet
+         * @tparam Encoding Endianness of the buffers (bytes are copied as-is)
+         * @param text Range of base64 characters
+         * @param bytes Write buffer the decoded bytes are written to
+         * @return true if the text is invalid or the write buffer is too small, false on success
+         */
+        template <Base64Alphabet Alphabet = Base64Alphabet::standard, std::endian Encoding>
+        [[nodiscard]] inline bool decodeBase64(BasicReadBuffer<Encoding> text, BasicWriteBuffer<Encoding>& bytes) noexcept {
+            size_t length = 0;
+            if (base64DecodedSize(std::span<const uint8_t>(text.data(), text.size()), length) || length > bytes.size()) {
+                return true; // Error (impossible length or buffer full)
+            }
+            const size_t characters = text.size() - detail::base64Padding(text.data(), text.size());
+            if (detail::decodeBase64Raw<Alphabet>(text.data(), characters, bytes.data())) {
+                return true; // Error (invalid character)
+            }
+            bytes.skip(length);
+            return false; // Success (no error)
+        }
+        /** @} */
+
+        /**
+         * @name Hex Encoding and Decoding
+         * @{
+         */
+
+         /**
+          * @brief Appends the lowercase hex encoding of a read buffer range to a vector
+          * @tparam Encoding Endianness of the buffers (bytes are copied as-is)
+          * @param source Range of bytes to encode
+          * @param text Vector the characters are appended to
+          */
+        template <std::endian Encoding>
+        inline void encodeHex(BasicReadBuffer<Encoding> source, BasicVector<Encoding>& text) noexcept {
+            const size_t oldSize = text.size();
+            text.expandBy(hexEncodedSize(source.size()));
+            if (!source.empty()) {
+                detail::encodeHexRaw(source.data(), source.size(), text.data() + oldSize);
+            }
+        }
+
+        /**
+         * @brief Writes the lowercase hex encoding of a read buffer range to a write buffer
+         * @tparam Encoding Endianness of the buffers (bytes are copied as-is)
+         * @param source Range of bytes to encode
+         * @param text Write buffer the characters are written to
+         * @return true if the write buffer is too small, false on success
+         */
+        template <std::endian Encoding>
+        [[nodiscard]] inline bool encodeHex(BasicReadBuffer<Encoding> source, BasicWriteBuffer<Encoding>& text) noexcept {
+            const size_t length = hexEncodedSize(source.size());
+            if (length > text.size()) {
+                return true; // Error (buffer full)
+            }
+            if (length > 0) {
+                detail::encodeHexRaw(source.data(), source.size(), text.data());
+                text.skip(length);
+            }
+            return false; // Success (no error)
+        }
+
+        /**
+         * @brief Decodes hex text from a read buffer range and appends the bytes to a vector
+         * @tparam Encoding Endianness of the buffers (bytes are copied as-is)
+         * @param text Range of hex characters (either case)
+         * @param bytes Vector the decoded bytes are appended to
+         * @return true if the text is not valid hex, false on success
+         *
+         * On failure the vector is restored to its original size.
+         */
+        template <std::endian Encoding>
+        [[nodiscard]] inline bool decodeHex(BasicReadBuffer<Encoding> text, BasicVector<Encoding>& bytes) noexcept {
+            size_t length = 0;
+            if (hexDecodedSize(std::span<const uint8_t>(text.data(), text.size()), length)) {
+                return true; // Error (odd length)
+            }
+            const size_t oldSize = bytes.size();
+            bytes.expandBy(length);
+            if (length > 0 && detail::decodeHexRaw(text.data(), length, bytes.data() + oldSize)) {
+                bytes.resize(oldSize);
+                return true; // Error (invalid character)
+            }
+            return false; // Success (no error)
+        }
+
+        /**
+         * @brief Decodes hex text from a read buffer range into a write buffer
+         * @tparam Encoding Endianness of the buffers (bytes are copied as-is)
+         * @param text Range of hex characters (either case)
+         * @param bytes Write buffer the decoded bytes are written to
+         * @return true if the text is invalid or the write buffer is too small, false on success
+         */
+        template <std::endian Encoding>
+        [[nodiscard]] inline bool decodeHex(BasicReadBuffer<Encoding> text, BasicWriteBuffer<Encoding>& bytes) noexcept {
+            size_t length = 0;
+            if (hexDecodedSize(std::span<const uint8_t>(text.data(), text.size()), length) || length > bytes.size()) {
+                return true; // Error (odd length or buffer full)
+            }
+            if (length > 0 && detail::decodeHexRaw(text.data(), length, bytes.data())) {
+                return true; // Error (invalid character)
+            }
+            bytes.skip(length);
+            return false; // Success (no error)
+        }
+        /** @} */
+
+    } // namespace endian
+} // namespace mz
+
+#undef MZ_ENDIAN_TEXT_CODECS_SSSE3
+
+#endif // MZ_ENDIAN_TEXT_CODECS_HEADER_FILE
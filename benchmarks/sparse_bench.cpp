@@ -0,0 +1,159 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file sparse_bench.cpp
+ * @brief Size and throughput benchmark for EndianSparse.h
+ *
+ * For a range of non-zero densities this encodes a float feature vector with
+ * pushBackSparse(), prints the size each layout would take and the one chosen,
+ * and measures encode, dense decode and forEach() throughput against the
+ * dense input size. Every run is checked to round-trip bit for bit, and the
+ * program fails unless all three layouts were exercised.
+ *
+ * Build from the repository root:
+ *   g++ -std=c++20 -O2 -march=native -I. benchmarks/sparse_bench.cpp -o sparse_bench
+ *
+ * @author Meysam Zare
+ * @date 2026-10-19
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "EndianSparse.h"
+
+using namespace mz::endian;
+
+namespace {
+
+    constexpr size_t element_count{ 1 << 20 };
+    constexpr double min_seconds{ 0.2 };
+
+    /**
+     * @brief Runs a callable repeatedly for at least min_seconds
+     * @return Throughput in MB/s of the given number of bytes per call
+     */
+    template <typename Function>
+    double measure(size_t bytes, Function&& function) {
+        using clock = std::chrono::steady_clock;
+        size_t iterations = 0;
+        const auto start = clock::now();
+        double elapsed = 0;
+        do {
+            function();
+            ++iterations;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < min_seconds);
+        return static_cast<double>(bytes) * static_cast<double>(iterations) / elapsed / 1e6;
+    }
+
+    const char* layoutName(SparseLayout layout) {
+        switch (layout) {
+        case SparseLayout::indexed: return "indexed";
+        case SparseLayout::bitmap: return "bitmap";
+        case SparseLayout::dense: return "dense";
+        default: return "?";
+        }
+    }
+
+} // namespace
+
+int main() {
+    const double densities[] = { 0.001, 0.01, 0.05, 0.2, 0.5, 1.0 };
+    const size_t denseBytes = element_count * sizeof(float);
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    bool seen[4]{};
+    int failures = 0;
+
+    std::printf("%zu floats (%zu bytes dense)\n", element_count, denseBytes);
+    std::printf("%8s %10s %10s %10s %8s %10s %11s %11s %11s\n",
+        "density", "indexed", "bitmap", "dense", "chosen", "encoded", "enc MB/s", "dec MB/s", "each MB/s");
+
+    for (double density : densities) {
+        std::vector<float> input(element_count);
+        size_t nonZeros = 0;
+        for (float& x : input) {
+            if (coin(random) < density) {
+                x = value(random);
+                nonZeros += x != 0.0f;
+            }
+        }
+
+        BasicVector<std::endian::little> encoded;
+        if (pushBackSparse(encoded, std::span<const float>(input))) {
+            std::printf("encode failed\n");
+            return 1;
+        }
+        BasicReadBuffer<std::endian::little> reader(encoded.data(), encoded.size());
+        BasicSparseView<std::endian::little, float> view;
+        std::vector<float> output(element_count, 1.0f);
+        BasicReadBuffer<std::endian::little> copy = reader;
+        if (view.open(copy) || popFrontSparse(reader, std::span<float>(output)) || !reader.empty()
+            || std::memcmp(input.data(), output.data(), denseBytes) != 0) {
+            std::printf("round trip failed at density %g\n", density);
+            ++failures;
+            continue;
+        }
+        seen[static_cast<size_t>(view.layout())] = true;
+
+        BasicVector<std::endian::little> scratch;
+        const double encodeRate = measure(denseBytes, [&] {
+            scratch.clear();
+            (void)pushBackSparse(scratch, std::span<const float>(input));
+        });
+        const double decodeRate = measure(denseBytes, [&] {
+            BasicReadBuffer<std::endian::little> source(encoded.data(), encoded.size());
+            (void)popFrontSparse(source, std::span<float>(output));
+        });
+        volatile float sink = 0;
+        const double visitRate = measure(denseBytes, [&] {
+            float sum = 0;
+            view.forEach([&sum](size_t, float x) {
+                sum += x;
+                return true;
+            });
+            sink = sink + sum;
+        });
+
+        std::printf("%8g %10zu %10zu %10zu %8s %10zu %11.0f %11.0f %11.0f\n", density,
+            sparse_header_size + nonZeros * (4 + sizeof(float)),
+            sparse_header_size + packedBoolSize(element_count) + nonZeros * sizeof(float),
+            sparse_header_size + denseBytes,
+            layoutName(view.layout()), encoded.size(), encodeRate, decodeRate, visitRate);
+    }
+
+    for (SparseLayout layout : { SparseLayout::indexed, SparseLayout::bitmap, SparseLayout::dense }) {
+        if (!seen[static_cast<size_t>(layout)]) {
+            std::printf("layout %s was not exercised\n", layoutName(layout));
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}